@@ -0,0 +1,176 @@
+#include "Digest.hpp"
+
+extern "C" {
+#include <libavutil/md5.h>
+#include <libavutil/sha.h>
+#include <libavutil/mem.h>
+}
+
+#include <stdexcept>
+#include <cstring>
+
+namespace avtranscoder
+{
+
+namespace
+{
+
+const uint64_t fnv1aOffsetBasis = UINT64_C( 14695981039346656037 );
+const uint64_t fnv1aPrime = UINT64_C( 1099511628211 );
+
+/// Size of a MD5 digest, in bytes
+const size_t md5Size = 16;
+
+/// Size of a SHA-256 digest, in bytes
+const size_t sha256Size = 32;
+
+std::string toHex( const unsigned char* data, const size_t size )
+{
+	static const char digits[] = "0123456789abcdef";
+	std::string hex( 2 * size, '0' );
+	for( size_t i = 0; i < size; ++i )
+	{
+		hex[2 * i] = digits[data[i] >> 4];
+		hex[2 * i + 1] = digits[data[i] & 0x0F];
+	}
+	return hex;
+}
+
+}
+
+std::string getDigestAlgorithmName( const EDigestAlgorithm algorithm )
+{
+	switch( algorithm )
+	{
+		case eDigestAlgorithmFnv1a:
+			return "fnv1a";
+		case eDigestAlgorithmMd5:
+			return "md5";
+		case eDigestAlgorithmSha256:
+			return "sha256";
+	}
+	return "";
+}
+
+Digest::Digest( const EDigestAlgorithm algorithm )
+	: _algorithm( algorithm )
+	, _fnv1aHash( fnv1aOffsetBasis )
+	, _md5( NULL )
+	, _finalMd5( NULL )
+	, _sha( NULL )
+	, _finalSha( NULL )
+{
+	if( _algorithm == eDigestAlgorithmMd5 )
+	{
+		_md5 = av_md5_alloc();
+		_finalMd5 = av_md5_alloc();
+		if( ! _md5 || ! _finalMd5 )
+		{
+			av_free( _md5 );
+			av_free( _finalMd5 );
+			throw std::runtime_error( "Unable to allocate the context of a MD5 digest" );
+		}
+	}
+	else if( _algorithm == eDigestAlgorithmSha256 )
+	{
+		_sha = av_sha_alloc();
+		_finalSha = av_sha_alloc();
+		if( ! _sha || ! _finalSha )
+		{
+			av_free( _sha );
+			av_free( _finalSha );
+			throw std::runtime_error( "Unable to allocate the context of a SHA-256 digest" );
+		}
+	}
+	reset();
+}
+
+Digest::~Digest()
+{
+	av_free( _md5 );
+	av_free( _finalMd5 );
+	av_free( _sha );
+	av_free( _finalSha );
+}
+
+void Digest::update( const unsigned char* data, const size_t size )
+{
+	switch( _algorithm )
+	{
+		case eDigestAlgorithmFnv1a:
+		{
+			uint64_t hash = _fnv1aHash;
+			for( const unsigned char* end = data + size; data != end; ++data )
+			{
+				hash ^= *data;
+				hash *= fnv1aPrime;
+			}
+			_fnv1aHash = hash;
+			break;
+		}
+		case eDigestAlgorithmMd5:
+			av_md5_update( _md5, data, size );
+			break;
+		case eDigestAlgorithmSha256:
+			av_sha_update( _sha, data, size );
+			break;
+	}
+}
+
+std::string Digest::getHexDigest() const
+{
+	std::string hexDigest;
+	switch( _algorithm )
+	{
+		case eDigestAlgorithmFnv1a:
+		{
+			// big endian, as the usual representation of the hash
+			unsigned char bytes[8];
+			for( size_t i = 0; i < 8; ++i )
+				bytes[i] = ( _fnv1aHash >> ( 56 - 8 * i ) ) & 0xFF;
+			hexDigest = toHex( bytes, 8 );
+			break;
+		}
+		case eDigestAlgorithmMd5:
+		{
+			unsigned char bytes[md5Size];
+			memcpy( _finalMd5, _md5, av_md5_size );
+			av_md5_final( _finalMd5, bytes );
+			hexDigest = toHex( bytes, md5Size );
+			break;
+		}
+		case eDigestAlgorithmSha256:
+		{
+			unsigned char bytes[sha256Size];
+			memcpy( _finalSha, _sha, av_sha_size );
+			av_sha_final( _finalSha, bytes );
+			hexDigest = toHex( bytes, sha256Size );
+			break;
+		}
+	}
+	return hexDigest;
+}
+
+void Digest::reset()
+{
+	_fnv1aHash = fnv1aOffsetBasis;
+	if( _md5 )
+		av_md5_init( _md5 );
+	if( _sha )
+		av_sha_init( _sha, 8 * sha256Size );
+}
+
+void Digest::setState( const Digest& digest )
+{
+	if( digest._algorithm != _algorithm )
+		throw std::runtime_error( "Unable to set the state of a " + getDigestAlgorithmName( _algorithm ) + " digest from a " +
+			getDigestAlgorithmName( digest._algorithm ) + " digest" );
+
+	_fnv1aHash = digest._fnv1aHash;
+	if( _md5 )
+		memcpy( _md5, digest._md5, av_md5_size );
+	if( _sha )
+		memcpy( _sha, digest._sha, av_sha_size );
+}
+
+}
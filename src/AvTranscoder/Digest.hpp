@@ -0,0 +1,78 @@
+#ifndef _AV_TRANSCODER_DIGEST_HPP_
+#define _AV_TRANSCODER_DIGEST_HPP_
+
+#include <AvTranscoder/common.hpp>
+
+#include <string>
+
+struct AVMD5;
+struct AVSHA;
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Algorithms of a Digest.
+ */
+enum EDigestAlgorithm
+{
+	eDigestAlgorithmFnv1a = 0,  ///< 64 bits FNV-1a: fast, not cryptographic (to check the data against itself)
+	eDigestAlgorithmMd5,  ///< 128 bits MD5 (to check the data against other tools)
+	eDigestAlgorithmSha256  ///< 256 bits SHA-2 (to check the delivered files)
+};
+
+/**
+ * @brief Returns the name of the algorithm (fnv1a, md5...).
+ */
+std::string AvExport getDigestAlgorithmName( const EDigestAlgorithm algorithm );
+
+/**
+ * @brief Compute the digest of data given in several parts.
+ */
+class AvExport Digest
+{
+private:
+	Digest( const Digest& digest );
+	Digest& operator=( const Digest& digest );
+
+public:
+	Digest( const EDigestAlgorithm algorithm );
+	~Digest();
+
+	/**
+	 * @brief Add the given data to the digest.
+	 */
+	void update( const unsigned char* data, const size_t size );
+
+	/**
+	 * @brief Returns the digest of the data given since the last reset, as an hexadecimal string.
+	 * @note More data can be added after.
+	 */
+	std::string getHexDigest() const;
+
+	/**
+	 * @brief Start the digest of new data.
+	 */
+	void reset();
+
+	/**
+	 * @brief Continue the digest from the state of the given digest (to restore a saved state).
+	 * @exception throw std::runtime_error if the digests do not have the same algorithm
+	 */
+	void setState( const Digest& digest );
+
+	EDigestAlgorithm getAlgorithm() const { return _algorithm; }
+
+private:
+	const EDigestAlgorithm _algorithm;
+
+	uint64_t _fnv1aHash;  ///< Current hash of eDigestAlgorithmFnv1a
+	struct AVMD5* _md5;  ///< Context of eDigestAlgorithmMd5 (has ownership)
+	struct AVMD5* _finalMd5;  ///< Copy of the context to get the digest, which can still be updated after (has ownership)
+	struct AVSHA* _sha;  ///< Context of eDigestAlgorithmSha256 (has ownership)
+	struct AVSHA* _finalSha;  ///< Copy of the context to get the digest (has ownership)
+};
+
+}
+
+#endif
@@ -301,4 +301,84 @@ void loadOptions( OptionArray& outOptions, void* av_class, int req_flags )
 		outOptions.push_back( it->second );
 }
 
+bool loadOption( OptionMap& outOptions, void* av_class, const std::string& optionName, int req_flags )
+{
+	if( ! av_class )
+		return false;
+
+	// find the option (skip the childs which could have the same name)
+	const AVOption* avOption = NULL;
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT( 51, 12, 0 )
+	while( ( avOption = av_next_option( av_class, avOption ) ) )
+#else
+	while( ( avOption = av_opt_next( av_class, avOption ) ) )
+#endif
+	{
+		if( avOption->name &&
+			optionName == avOption->name &&
+			avOption->type != AV_OPT_TYPE_CONST &&
+			( avOption->flags & req_flags ) == req_flags )
+		{
+			break;
+		}
+	}
+
+	if( ! avOption )
+		return false;
+
+	Option option( *const_cast<AVOption*>( avOption ), av_class );
+
+	// get child options of a Choice or a Group
+	if( ! option.getUnit().empty() )
+	{
+		const AVOption* avChildOption = NULL;
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT( 51, 12, 0 )
+		while( ( avChildOption = av_next_option( av_class, avChildOption ) ) )
+#else
+		while( ( avChildOption = av_opt_next( av_class, avChildOption ) ) )
+#endif
+		{
+			if( ! avChildOption->name ||
+				! avChildOption->unit ||
+				avChildOption->type != AV_OPT_TYPE_CONST ||
+				( avChildOption->flags & req_flags ) != req_flags ||
+				option.getUnit() != avChildOption->unit )
+			{
+				continue;
+			}
+
+			Option childOption( *const_cast<AVOption*>( avChildOption ), av_class );
+			option.appendChild( childOption );
+
+			// child of a Choice
+			if( option.getType() == eOptionBaseTypeChoice )
+			{
+				if( childOption.getDefaultInt() == option.getDefaultInt() )
+					option.setDefaultChildIndex( option.getChilds().size() - 1 );
+			}
+		}
+	}
+
+	outOptions.insert( std::make_pair( option.getName(), option ) );
+	return true;
+}
+
+void setOptionFromString( void* av_class, const std::string& optionName, const std::string& value, int req_flags )
+{
+	void* targetContext = NULL;
+	const AVOption* avOption = NULL;
+	if( av_class )
+		avOption = av_opt_find2( av_class, optionName.c_str(), NULL, req_flags, AV_OPT_SEARCH_CHILDREN, &targetContext );
+	if( ! avOption || ! targetContext )
+	{
+		throw std::runtime_error( "unknown key " + optionName );
+	}
+
+	const int error = av_opt_set( targetContext, optionName.c_str(), value.c_str(), 0 );
+	if( error )
+	{
+		throw std::runtime_error( "setting " + optionName + " parameter to " + value + ": " + getDescriptionFromErrorCode( error ) );
+	}
+}
+
 }
@@ -126,6 +126,22 @@ typedef std::map<std::string, Option> OptionMap;  ///< Key: option name / value:
 void AvExport loadOptions( OptionMap& outOptions, void* av_class, int req_flags = 0 );
 void AvExport loadOptions( OptionArray& outOptions, void* av_class, int req_flags = 0 );
 
+/**
+ * @brief Load only the option with the given name (and its potential childs).
+ * @note Used to get an option without wrapping all the options of the context.
+ * @return if the option was found in the context
+ * @see loadOptions
+ */
+bool AvExport loadOption( OptionMap& outOptions, void* av_class, const std::string& optionName, int req_flags = 0 );
+
+/**
+ * @brief Set the value of an option of the context (or of its children), without wrapping it.
+ * @param av_class: a libav context (could be an AVFormatContext or an AVCodecContext).
+ * @param req_flags: libav flag (AV_OPT_FLAG_XXX), the option is found only if it has these flags.
+ * @exception throw std::runtime_error if the option is not found or can't be set
+ */
+void AvExport setOptionFromString( void* av_class, const std::string& optionName, const std::string& value, int req_flags = 0 );
+
 }
 
 #endif
@@ -1,6 +1,13 @@
 %module avtranscoder
 
-%module(directors="1") avtranscoder
+%module(directors="1", threads="1") avtranscoder
+
+/*
+ * Release the Python GIL only around the long-running calls (marked with %thread in the modules),
+ * so that several Python threads can process at the same time.
+ * The GIL is taken back by the directors (ie. IProgress implemented in Python).
+ */
+%nothread;
 
 %include "std_string.i"
 %include "std_vector.i"
@@ -19,6 +26,7 @@
 %{
 #include <AvTranscoder/Library.hpp>
 #include <AvTranscoder/log.hpp>
+#include <AvTranscoder/Digest.hpp>
 %}
 
 %include "AvTranscoder/progress/progress.i"
@@ -28,6 +36,7 @@
 
 %include <AvTranscoder/Library.hpp>
 %include <AvTranscoder/log.hpp>
+%include <AvTranscoder/Digest.hpp>
 
 %include "AvTranscoder/option.i"
 %include "AvTranscoder/util.i"
@@ -17,7 +17,6 @@ ICodec::ICodec( const ECodecType type, const std::string& codecName )
 {
 	setCodec( type, codecName );
 	allocateContext();
-	loadCodecOptions();
 }
 
 ICodec::ICodec( const ECodecType type, const AVCodecID codecId )
@@ -28,7 +27,6 @@ ICodec::ICodec( const ECodecType type, const AVCodecID codecId )
 {
 	setCodec( type, codecId );
 	allocateContext();
-	loadCodecOptions();
 }
 
 ICodec::ICodec( const ECodecType type, AVCodecContext& avCodecContext )
@@ -38,7 +36,6 @@ ICodec::ICodec( const ECodecType type, AVCodecContext& avCodecContext )
 	, _type( type )
 {
 	setCodec( type, _avCodecContext->codec_id );
-	loadCodecOptions();
 }
 
 ICodec::~ICodec()
@@ -103,14 +100,49 @@ int ICodec::getLatency()  const
 
 std::vector<Option> ICodec::getOptions()
 {
+	const OptionMap& options = getOptionsMap();
+
 	std::vector<Option> optionsArray;
-	for( OptionMap::iterator it = _options.begin(); it != _options.end(); ++it )
+	for( OptionMap::const_iterator it = options.begin(); it != options.end(); ++it )
 	{
 		optionsArray.push_back( it->second );
 	}
 	return optionsArray;
 }
 
+OptionMap& ICodec::getOptionsMap()
+{
+	const int flags = getOptionFlags();
+
+	OptionMap allOptions;
+	loadOptions( allOptions, _avCodecContext, flags );
+	// load specific options of the codec
+	loadOptions( allOptions, _avCodecContext->priv_data, flags );
+
+	// keep the options already wrapped
+	_options.insert( allOptions.begin(), allOptions.end() );
+	return _options;
+}
+
+Option& ICodec::getOption( const std::string& optionName )
+{
+	if( ! _options.count( optionName ) )
+	{
+		const int flags = getOptionFlags();
+		if( ! loadOption( _options, _avCodecContext, optionName, flags ) )
+		{
+			// load specific option of the codec
+			loadOption( _options, _avCodecContext->priv_data, optionName, flags );
+		}
+	}
+	return _options.at( optionName );
+}
+
+void ICodec::setOption( const std::string& optionName, const std::string& value )
+{
+	setOptionFromString( _avCodecContext, optionName, value, getOptionFlags() );
+}
+
 void ICodec::setCodec( const ECodecType type, const std::string& codecName )
 {
 	const AVCodecDescriptor* avCodecDescriptor = avcodec_descriptor_get_by_name( codecName.c_str() );
@@ -151,20 +183,11 @@ void ICodec::allocateContext()
 	_avCodecContext->codec = _avCodec;
 }
 
-void ICodec::loadCodecOptions()
+int ICodec::getOptionFlags() const
 {
 	if( _type == eCodecTypeEncoder )
-	{
-		loadOptions( _options, _avCodecContext, AV_OPT_FLAG_ENCODING_PARAM );
-		// load specific options of the codec
-		loadOptions( _options, _avCodecContext->priv_data, AV_OPT_FLAG_ENCODING_PARAM );
-	}
-	else if( _type == eCodecTypeDecoder )
-	{
-		loadOptions( _options, _avCodecContext, AV_OPT_FLAG_DECODING_PARAM );
-		// load specific options of the codec
-		loadOptions( _options, _avCodecContext->priv_data, AV_OPT_FLAG_DECODING_PARAM );
-	}
+		return AV_OPT_FLAG_ENCODING_PARAM;
+	return AV_OPT_FLAG_DECODING_PARAM;
 }
 
 }
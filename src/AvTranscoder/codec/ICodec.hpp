@@ -43,11 +43,31 @@ public:
 	ECodecType getCodecType() const { return _type; }
 	int getLatency() const;
 
+	//@{
+	// @brief Get all the options of the codec
+	// @note Wrap all the options of the codec context: prefer getOption or setOption to access a few options.
 	OptionArray getOptions();  ///< Get options as array
-	OptionMap& getOptionsMap() { return _options; }  ///< Get options as map
+	OptionMap& getOptionsMap();  ///< Get options as map
+	//@}
+
+	/**
+	 * @brief Get the option with the given name
+	 * @note The option is wrapped on its first access.
+	 * @exception throw std::out_of_range if the codec has no option with this name
+	 */
+	Option& getOption( const std::string& optionName );
+
+	/**
+	 * @brief Set the value of an option, directly in the codec context.
+	 * @exception throw std::runtime_error if the option is not found or can't be set
+	 */
+	void setOption( const std::string& optionName, const std::string& value );
+
+	/**
+	 * @return Number of options of the codec already wrapped (by getOption, getOptions or getOptionsMap)
+	 */
+	size_t getNbLoadedOptions() const { return _options.size(); }
 
-	Option& getOption( const std::string& optionName ) { return _options.at(optionName); }
-	
 #ifndef SWIG
 	AVCodecContext& getAVCodecContext() { return *_avCodecContext; }
 	const AVCodecContext& getAVCodecContext() const { return *_avCodecContext; }
@@ -59,7 +79,11 @@ private:
 	void setCodec( const ECodecType type, const std::string& codecName );
 	void setCodec( const ECodecType type, const AVCodecID codecId );
 	void allocateContext();
-	void loadCodecOptions();
+
+	/**
+	 * @return The libav flag used to filter the options of the codec (AV_OPT_FLAG_ENCODING_PARAM or AV_OPT_FLAG_DECODING_PARAM)
+	 */
+	int getOptionFlags() const;
 
 protected:
 	AVCodecContext* _avCodecContext; ///< Full codec instance description (has ownership)
@@ -68,7 +92,7 @@ protected:
 
 	ECodecType _type;
 
-	OptionMap _options;
+	OptionMap _options;  ///< Options already wrapped (loaded on demand)
 };
 
 }
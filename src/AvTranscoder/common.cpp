@@ -1,6 +1,9 @@
 #include "common.hpp"
 
+#include <AvTranscoder/thread.hpp>
+
 extern "C" {
+#include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/error.h>
 }
@@ -12,9 +15,41 @@ extern "C" {
 namespace avtranscoder
 {
 
+namespace
+{
+
+/**
+ * @brief Lock the calls of ffmpeg/libav which are not thread safe (opening of the codecs...).
+ */
+int lockManager( void** mutex, enum AVLockOp operation )
+{
+	switch( operation )
+	{
+		case AV_LOCK_CREATE:
+			*mutex = new Mutex();
+			return 0;
+		case AV_LOCK_OBTAIN:
+			static_cast<Mutex*>( *mutex )->lock();
+			return 0;
+		case AV_LOCK_RELEASE:
+			static_cast<Mutex*>( *mutex )->unlock();
+			return 0;
+		case AV_LOCK_DESTROY:
+			delete static_cast<Mutex*>( *mutex );
+			*mutex = NULL;
+			return 0;
+	}
+	return 1;
+}
+
+}
+
 void preloadCodecsAndFormats()
 {
 	av_register_all();
+
+	// codecs can be opened from several threads
+	av_lockmgr_register( lockManager );
 }
 
 std::string getDescriptionFromErrorCode( const int code )
@@ -54,7 +54,7 @@ namespace avtranscoder
 
 typedef AVRational Rational;
 
-/// Register all the codecs and formats which are enabled at configuration time.
+/// Register all the codecs and formats which are enabled at configuration time, and a lock manager to open codecs from several threads.
 void AvExport preloadCodecsAndFormats();
 
 /// Get the string description corresponding to the error code provided by ffmpeg/libav
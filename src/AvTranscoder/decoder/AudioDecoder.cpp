@@ -71,7 +71,7 @@ void AudioDecoder::setupDecoder( const ProfileLoader::Profile& profile )
 
 	// set threads before any other options
 	if( profile.count( constants::avProfileThreads ) )
-		codec.getOption( constants::avProfileThreads ).setString( profile.at( constants::avProfileThreads ) );
+		codec.setOption( constants::avProfileThreads, profile.at( constants::avProfileThreads ) );
 	else
 		codec.getOption( constants::avProfileThreads ).setInt( codec.getAVCodecContext().thread_count );
 
@@ -86,8 +86,7 @@ void AudioDecoder::setupDecoder( const ProfileLoader::Profile& profile )
 
 		try
 		{
-			Option& decodeOption = codec.getOption( (*it).first );
-			decodeOption.setString( (*it).second );
+			codec.setOption( (*it).first, (*it).second );
 		}
 		catch( std::exception& e )
 		{
@@ -198,4 +197,14 @@ void AudioDecoder::flushDecoder()
 	avcodec_flush_buffers( &_inputStream->getAudioCodec().getAVCodecContext() );
 }
 
+int64_t AudioDecoder::getLastDecodedTimestamp() const
+{
+#ifdef AVTRANSCODER_FFMPEG_DEPENDENCY
+	// guessed from the timestamps of the packets when the pts is missing
+	return av_frame_get_best_effort_timestamp( _frame );
+#else
+	return _frame->pkt_pts;
+#endif
+}
+
 }
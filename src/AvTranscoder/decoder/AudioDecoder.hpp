@@ -23,6 +23,8 @@ public:
 
 	void flushDecoder();
 
+	int64_t getLastDecodedTimestamp() const;
+
 private:
 	bool decodeNextFrame();
 
@@ -1,4 +1,5 @@
 #include "AudioGenerator.hpp"
+#include "GeneratedFrameCache.hpp"
 
 namespace avtranscoder
 {
@@ -27,7 +28,6 @@ AudioGenerator& AudioGenerator::operator=( const AudioGenerator& audioGenerator
 
 AudioGenerator::~AudioGenerator()
 {
-	delete _silent;
 }
 
 void AudioGenerator::setAudioFrameDesc( const AudioFrameDesc& frameDesc )
@@ -49,15 +49,9 @@ bool AudioGenerator::decodeNextFrame( Frame& frameBuffer )
 		AudioFrame& audioBuffer = static_cast<AudioFrame&>( frameBuffer );
 		audioBuffer.setNbSamples( _frameDesc.getSampleRate() / _frameDesc.getFps() );
 
-		// Generate the silent only once
+		// Get the silent only once
 		if( ! _silent )
-		{
-			int fillChar = 0;
-
-			_silent = new AudioFrame( audioBuffer.desc() );
-			_silent->assign( _frameDesc.getDataSize(), fillChar );
-			_silent->setNbSamples( audioBuffer.getNbSamples() );
-		}
+			_silent = &GeneratedFrameCache::getSilence( audioBuffer.desc(), audioBuffer.getNbSamples() );
 		frameBuffer.refData( *_silent );
 	}
 	// Take audio frame from _inputFrame
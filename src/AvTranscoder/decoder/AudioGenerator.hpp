@@ -25,7 +25,7 @@ public:
 
 private:
 	Frame* _inputFrame;  ///< Has link (no ownership)
-	AudioFrame* _silent;   ///< The generated silent (has ownership)
+	AudioFrame* _silent;   ///< The generated silent (has link, owned by the GeneratedFrameCache)
 	AudioFrameDesc _frameDesc;  ///< The description of the silent (sample rate...) 
 };
 
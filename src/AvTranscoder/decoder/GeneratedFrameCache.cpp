@@ -0,0 +1,156 @@
+#include "GeneratedFrameCache.hpp"
+
+#include <AvTranscoder/transform/VideoTransform.hpp>
+#include <AvTranscoder/thread.hpp>
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+}
+
+#include <cstring>
+#include <vector>
+#include <map>
+
+namespace avtranscoder
+{
+
+namespace
+{
+	typedef std::map< std::vector< int64_t >, Frame* > FrameMap;
+
+	/**
+	 * @brief Generated frames per description, freed at the end of the process.
+	 */
+	struct GeneratedFrames
+	{
+		~GeneratedFrames()
+		{
+			for( FrameMap::iterator it = _frames.begin(); it != _frames.end(); ++it )
+				delete it->second;
+		}
+
+		FrameMap _frames;  ///< Has ownership
+	};
+
+	GeneratedFrames generatedFrames;
+	Mutex generatedFrameCacheMutex;  ///< Protect the generated frames
+}
+
+VideoFrame& GeneratedFrameCache::getBlackImage( const VideoFrameDesc& frameDesc )
+{
+	std::vector< int64_t > key;
+	key.push_back( AVMEDIA_TYPE_VIDEO );
+	key.push_back( frameDesc.getWidth() );
+	key.push_back( frameDesc.getHeight() );
+	key.push_back( frameDesc.getPixelFormat() );
+
+	ScopedLock lock( generatedFrameCacheMutex );
+	FrameMap::iterator it = generatedFrames._frames.find( key );
+	if( it != generatedFrames._frames.end() )
+		return *static_cast<VideoFrame*>( it->second );
+
+	LOG_DEBUG( "Generate a black image of " << frameDesc.getWidth() << "x" << frameDesc.getHeight() << " (" << frameDesc.getPixelFormatName() << ")" )
+	VideoFrame* blackImage = new VideoFrame( frameDesc );
+	if( ! fillBlack( *blackImage ) )
+		convertBlack( *blackImage );
+	generatedFrames._frames.insert( std::make_pair( key, blackImage ) );
+	return *blackImage;
+}
+
+AudioFrame& GeneratedFrameCache::getSilence( const AudioFrameDesc& frameDesc, const size_t nbSamples )
+{
+	std::vector< int64_t > key;
+	key.push_back( AVMEDIA_TYPE_AUDIO );
+	key.push_back( frameDesc.getSampleRate() );
+	key.push_back( frameDesc.getChannels() );
+	key.push_back( frameDesc.getSampleFormat() );
+	key.push_back( nbSamples );
+
+	ScopedLock lock( generatedFrameCacheMutex );
+	FrameMap::iterator it = generatedFrames._frames.find( key );
+	if( it != generatedFrames._frames.end() )
+		return *static_cast<AudioFrame*>( it->second );
+
+	// unsigned 8 bits samples are centered on 128
+	const AVSampleFormat sampleFormat = frameDesc.getSampleFormat();
+	const int fillChar = ( sampleFormat == AV_SAMPLE_FMT_U8 || sampleFormat == AV_SAMPLE_FMT_U8P ) ? 0x80 : 0;
+
+	AudioFrame* silence = new AudioFrame( frameDesc );
+	silence->assign( nbSamples * frameDesc.getChannels() * av_get_bytes_per_sample( sampleFormat ), fillChar );
+	silence->setNbSamples( nbSamples );
+	generatedFrames._frames.insert( std::make_pair( key, silence ) );
+	return *silence;
+}
+
+bool GeneratedFrameCache::fillBlack( VideoFrame& image )
+{
+	const AVPixelFormat pixelFormat = image.desc().getPixelFormat();
+	const AVPixFmtDescriptor* pixelDesc = av_pix_fmt_desc_get( pixelFormat );
+	if( ! pixelDesc || pixelDesc->flags & ( PIX_FMT_PAL | PIX_FMT_BITSTREAM | PIX_FMT_HWACCEL ) )
+		return false;
+
+	const int width = image.desc().getWidth();
+	const int height = image.desc().getHeight();
+
+	AVPicture picture;
+	if( avpicture_fill( &picture, image.getData(), pixelFormat, width, height ) < 0 )
+		return false;
+
+	// formats with the luma in the video range (not yuvj, rgb or gray)
+	const bool isRGB = pixelDesc->flags & PIX_FMT_RGB;
+	const bool isVideoRange = ! isRGB && pixelDesc->nb_components >= 3 && strncmp( pixelDesc->name, "yuvj", 4 ) != 0;
+	const bool hasAlpha = pixelDesc->flags & PIX_FMT_ALPHA;
+
+	// av_write_image_line combines the written bits with the existing ones
+	image.assign( image.getSize(), 0 );
+
+	for( size_t component = 0; component < pixelDesc->nb_components; ++component )
+	{
+		const AVComponentDescriptor& componentDesc = pixelDesc->comp[component];
+		const size_t depth = componentDesc.depth_minus1 + 1;
+
+		uint16_t value = 0;
+		if( hasAlpha && component == pixelDesc->nb_components - 1u )
+			value = ( 1 << depth ) - 1;
+		else if( ! isRGB && ( component == 1 || component == 2 ) && pixelDesc->nb_components >= 3 )
+			value = 1 << ( depth - 1 );
+		else if( isVideoRange && component == 0 && depth >= 8 )
+			value = 16 << ( depth - 8 );
+
+		// nothing to do: the image is already filled with 0
+		if( value == 0 )
+			continue;
+
+		const bool isChroma = component == 1 || component == 2;
+		const int componentWidth = isChroma ? -( ( -width ) >> pixelDesc->log2_chroma_w ) : width;
+		const int componentHeight = isChroma ? -( ( -height ) >> pixelDesc->log2_chroma_h ) : height;
+
+		// fast path: a component alone in its plane, stored on one byte
+		if( depth == 8 && componentDesc.step_minus1 == 0 && componentDesc.shift == 0 )
+		{
+			memset( picture.data[componentDesc.plane], value, picture.linesize[componentDesc.plane] * componentHeight );
+			continue;
+		}
+
+		std::vector< uint16_t > line( componentWidth, value );
+		for( int y = 0; y < componentHeight; ++y )
+			av_write_image_line( &line[0], picture.data, picture.linesize, pixelDesc, 0, y, component, componentWidth );
+	}
+	return true;
+}
+
+void GeneratedFrameCache::convertBlack( VideoFrame& image )
+{
+	// input of convert
+	VideoFrameDesc desc( image.desc() );
+	desc.setPixelFormat( "rgb24" );
+
+	VideoFrame intermediateBuffer( desc );
+	intermediateBuffer.assign( desc.getDataSize(), 0 );
+
+	// convert to the black image
+	VideoTransform videoTransform;
+	videoTransform.convert( intermediateBuffer, image );
+}
+
+}
@@ -0,0 +1,49 @@
+#ifndef _AV_TRANSCODER_DECODER_GENERATED_FRAME_CACHE_HPP_
+#define _AV_TRANSCODER_DECODER_GENERATED_FRAME_CACHE_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/frame/VideoFrame.hpp>
+#include <AvTranscoder/frame/AudioFrame.hpp>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Process-wide cache of the frames used by the generators (black images and silences).
+ * A frame is built the first time it is requested, then shared by all the generators which need the same description.
+ * @note All methods are thread safe.
+ * @warning The frames are kept until the end of the process, and must not be modified.
+ */
+class AvExport GeneratedFrameCache
+{
+private:
+	GeneratedFrameCache();
+
+public:
+	/**
+	 * @brief Get a black image of the given description.
+	 * @note Luma is set to the black of the video range for YUV formats (16 in 8 bits), and to 0 for full range formats (yuvj, rgb, gray).
+	 */
+	static VideoFrame& getBlackImage( const VideoFrameDesc& frameDesc );
+
+	/**
+	 * @brief Get a silence of the given description, with the given number of samples.
+	 */
+	static AudioFrame& getSilence( const AudioFrameDesc& frameDesc, const size_t nbSamples );
+
+private:
+	/**
+	 * @brief Fill the given image with black.
+	 * @return false if the pixel format is not supported (palette, bitstream, hardware formats)
+	 */
+	static bool fillBlack( VideoFrame& image );
+
+	/**
+	 * @brief Fill the given image with black, by converting a black rgb24 image.
+	 */
+	static void convertBlack( VideoFrame& image );
+};
+
+}
+
+#endif
@@ -48,6 +48,13 @@ public:
 	 * @note Not sense for generators.
 	 */
 	virtual void flushDecoder() {}
+
+	/**
+	 * @brief Get the presentation timestamp of the last decoded frame, in the time base of the input stream.
+	 * @return AV_NOPTS_VALUE if unknown.
+	 * @note Not sense for generators.
+	 */
+	virtual int64_t getLastDecodedTimestamp() const { return AV_NOPTS_VALUE; }
 };
 
 }
@@ -69,7 +69,7 @@ void VideoDecoder::setupDecoder( const ProfileLoader::Profile& profile )
 
 	// set threads before any other options
 	if( profile.count( constants::avProfileThreads ) )
-		codec.getOption( constants::avProfileThreads ).setString( profile.at( constants::avProfileThreads ) );
+		codec.setOption( constants::avProfileThreads, profile.at( constants::avProfileThreads ) );
 	else
 		codec.getOption( constants::avProfileThreads ).setInt( codec.getAVCodecContext().thread_count );
 
@@ -84,8 +84,7 @@ void VideoDecoder::setupDecoder( const ProfileLoader::Profile& profile )
 
 		try
 		{
-			Option& decodeOption = codec.getOption( (*it).first );
-			decodeOption.setString( (*it).second );
+			codec.setOption( (*it).first, (*it).second );
 		}
 		catch( std::exception& e )
 		{
@@ -152,4 +151,14 @@ void VideoDecoder::flushDecoder()
 	avcodec_flush_buffers( &_inputStream->getVideoCodec().getAVCodecContext() );
 }
 
+int64_t VideoDecoder::getLastDecodedTimestamp() const
+{
+#ifdef AVTRANSCODER_FFMPEG_DEPENDENCY
+	// guessed from the timestamps of the packets when the pts is missing
+	return av_frame_get_best_effort_timestamp( _frame );
+#else
+	return _frame->pkt_pts;
+#endif
+}
+
 }
@@ -1,6 +1,6 @@
 #include "VideoGenerator.hpp"
 
-#include <AvTranscoder/transform/VideoTransform.hpp>
+#include "GeneratedFrameCache.hpp"
 
 namespace avtranscoder
 {
@@ -29,7 +29,6 @@ VideoGenerator& VideoGenerator::operator=( const VideoGenerator& videoGenerator
 
 VideoGenerator::~VideoGenerator()
 {
-	delete _blackImage;
 }
 
 void VideoGenerator::setVideoFrameDesc( const VideoFrameDesc& frameDesc )
@@ -47,26 +46,11 @@ bool VideoGenerator::decodeNextFrame( Frame& frameBuffer )
 	// Generate black image
 	if( ! _inputFrame )
 	{
-		// Generate the black image only once
+		// Get the black image only once
 		if( ! _blackImage )
 		{
-			// @todo support PAL (0 to 255) and NTFS (16 to 235)
-			char fillChar = 0;
-
-			// input of convert
-			VideoFrameDesc desc( _frameDesc );
-			desc.setPixelFormat( "rgb24" );
-
-			VideoFrame intermediateBuffer( desc );
-			intermediateBuffer.assign( _frameDesc.getDataSize(), fillChar );
-
-			// output of convert
-			VideoFrame& imageBuffer = static_cast<VideoFrame&>( frameBuffer );
-			_blackImage = new VideoFrame( imageBuffer.desc() );
-
-			// convert and store the black image
-			VideoTransform videoTransform;
-			videoTransform.convert( intermediateBuffer, *_blackImage );
+			const VideoFrame& imageBuffer = static_cast<VideoFrame&>( frameBuffer );
+			_blackImage = &GeneratedFrameCache::getBlackImage( imageBuffer.desc() );
 		}
 		frameBuffer.refData( *_blackImage );
 	}
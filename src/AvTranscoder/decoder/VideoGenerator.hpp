@@ -25,7 +25,7 @@ public:
 
 private:
 	Frame* _inputFrame;  ///< A frame given from outside (has link, no ownership)
-	VideoFrame* _blackImage;   ///< The generated black image (has ownership)
+	VideoFrame* _blackImage;   ///< The generated black image (has link, owned by the GeneratedFrameCache)
 	VideoFrameDesc _frameDesc;  ///< The description of the black image (width, height...) 
 };
 
@@ -4,6 +4,7 @@
 #include <AvTranscoder/decoder/VideoDecoder.hpp>
 #include <AvTranscoder/decoder/VideoGenerator.hpp>
 #include <AvTranscoder/decoder/AudioGenerator.hpp>
+#include <AvTranscoder/decoder/GeneratedFrameCache.hpp>
 %}
 
 %include <AvTranscoder/decoder/IDecoder.hpp>
@@ -11,3 +12,4 @@
 %include <AvTranscoder/decoder/VideoDecoder.hpp>
 %include <AvTranscoder/decoder/VideoGenerator.hpp>
 %include <AvTranscoder/decoder/AudioGenerator.hpp>
+%include <AvTranscoder/decoder/GeneratedFrameCache.hpp>
@@ -62,7 +62,7 @@ void AudioEncoder::setupEncoder( const ProfileLoader::Profile& profile )
 
 	// set threads before any other options
 	if( profile.count( constants::avProfileThreads ) )
-		_codec.getOption( constants::avProfileThreads ).setString( profile.at( constants::avProfileThreads ) );
+		_codec.setOption( constants::avProfileThreads, profile.at( constants::avProfileThreads ) );
 	else
 		_codec.getOption( constants::avProfileThreads ).setInt( _codec.getAVCodecContext().thread_count );
 
@@ -80,8 +80,7 @@ void AudioEncoder::setupEncoder( const ProfileLoader::Profile& profile )
 
 		try
 		{
-			Option& encodeOption = _codec.getOption( (*it).first );
-			encodeOption.setString( (*it).second );
+			_codec.setOption( (*it).first, (*it).second );
 		}
 		catch( std::exception& e )
 		{}
@@ -102,8 +101,7 @@ void AudioEncoder::setupEncoder( const ProfileLoader::Profile& profile )
 
 		try
 		{
-			Option& encodeOption = _codec.getOption( (*it).first );
-			encodeOption.setString( (*it).second );
+			_codec.setOption( (*it).first, (*it).second );
 		}
 		catch( std::exception& e )
 		{
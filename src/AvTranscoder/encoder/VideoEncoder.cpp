@@ -63,7 +63,7 @@ void VideoEncoder::setupEncoder( const ProfileLoader::Profile& profile )
 
 	// set threads before any other options
 	if( profile.count( constants::avProfileThreads ) )
-		_codec.getOption( constants::avProfileThreads ).setString( profile.at( constants::avProfileThreads ) );
+		_codec.setOption( constants::avProfileThreads, profile.at( constants::avProfileThreads ) );
 	else
 		_codec.getOption( constants::avProfileThreads ).setInt( _codec.getAVCodecContext().thread_count );
 
@@ -83,8 +83,7 @@ void VideoEncoder::setupEncoder( const ProfileLoader::Profile& profile )
 
 		try
 		{
-			Option& encodeOption = _codec.getOption( (*it).first );
-			encodeOption.setString( (*it).second );
+			_codec.setOption( (*it).first, (*it).second );
 		}
 		catch( std::exception& e )
 		{}
@@ -116,8 +115,7 @@ void VideoEncoder::setupEncoder( const ProfileLoader::Profile& profile )
 
 		try
 		{
-			Option& encodeOption = _codec.getOption( (*it).first );
-			encodeOption.setString( (*it).second );
+			_codec.setOption( (*it).first, (*it).second );
 		}
 		catch( std::exception& e )
 		{
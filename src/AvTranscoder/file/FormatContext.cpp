@@ -22,11 +22,6 @@ FormatContext::FormatContext( const std::string& filename, int req_flags, AVDict
 		throw std::ios_base::failure( msg );
 	}
 	_isOpen = true;
-
-	loadOptions( _options, _avFormatContext, req_flags );
-	// when demuxing, priv_data of AVFormatContext is set by avformat_open_input()
-	if( _avFormatContext->iformat->priv_class )
-		loadOptions( _options, _avFormatContext->priv_data, req_flags );
 }
 
 FormatContext::FormatContext( int req_flags )
@@ -36,7 +31,6 @@ FormatContext::FormatContext( int req_flags )
 	, _isOpen( false )
 {
 	_avFormatContext = avformat_alloc_context();
-	loadOptions( _options, _avFormatContext, req_flags );
 }
 
 FormatContext::~FormatContext()
@@ -91,9 +85,27 @@ void FormatContext::writeHeader( AVDictionary** options )
 	{
 		throw std::runtime_error( "Could not write header: " + getDescriptionFromErrorCode( ret ) );
 	}
-	// when muxing, priv_data of AVFormatContext is set by avformat_write_header()
-	if( _avFormatContext->oformat->priv_class )
-		loadOptions( _options, _avFormatContext->priv_data, _flags );
+}
+
+void FormatContext::closeInputRessource()
+{
+	// the resource is not opened by the demuxer
+	if( ! _isOpen || ! _avFormatContext->pb || ( _avFormatContext->flags & AVFMT_FLAG_CUSTOM_IO ) || ( _avFormatContext->iformat->flags & AVFMT_NOFILE ) )
+		return;
+
+	avio_close( _avFormatContext->pb );
+	// not closed again by avformat_close_input
+	_avFormatContext->pb = NULL;
+}
+
+bool FormatContext::readFrame( AVPacket& packet )
+{
+	const int ret = av_read_frame( _avFormatContext, &packet );
+	if( ret < 0 && ret != AVERROR_EOF )
+	{
+		LOG_ERROR( "Error when reading packet: " << getDescriptionFromErrorCode( ret ) )
+	}
+	return ret >= 0;
 }
 
 void FormatContext::writeFrame( AVPacket& packet, bool interleaved )
@@ -157,14 +169,53 @@ bool FormatContext::seek( const uint64_t position, const int flag )
 
 std::vector<Option> FormatContext::getOptions()
 {
+	const OptionMap& options = getOptionsMap();
+
 	std::vector<Option> optionsArray;
-	for( OptionMap::iterator it = _options.begin(); it != _options.end(); ++it )
+	for( OptionMap::const_iterator it = options.begin(); it != options.end(); ++it )
 	{
 		optionsArray.push_back( it->second );
 	}
 	return optionsArray;
 }
 
+OptionMap& FormatContext::getOptionsMap()
+{
+	OptionMap allOptions;
+	loadOptions( allOptions, _avFormatContext, _flags );
+	loadOptions( allOptions, getPrivateData(), _flags );
+
+	// keep the options already wrapped
+	_options.insert( allOptions.begin(), allOptions.end() );
+	return _options;
+}
+
+Option& FormatContext::getOption( const std::string& optionName )
+{
+	if( ! _options.count( optionName ) )
+	{
+		if( ! loadOption( _options, _avFormatContext, optionName, _flags ) )
+			loadOption( _options, getPrivateData(), optionName, _flags );
+	}
+	return _options.at( optionName );
+}
+
+void FormatContext::setOption( const std::string& optionName, const std::string& value )
+{
+	setOptionFromString( _avFormatContext, optionName, value, _flags );
+}
+
+void* FormatContext::getPrivateData() const
+{
+	// when demuxing, priv_data of AVFormatContext is set by avformat_open_input()
+	if( _avFormatContext->iformat && _avFormatContext->iformat->priv_class )
+		return _avFormatContext->priv_data;
+	// when muxing, priv_data of AVFormatContext is set by avformat_write_header()
+	if( _avFormatContext->oformat && _avFormatContext->oformat->priv_class )
+		return _avFormatContext->priv_data;
+	return NULL;
+}
+
 AVStream& FormatContext::getAVStream( size_t index ) const
 {
 	if( index >= getNbStreams() )
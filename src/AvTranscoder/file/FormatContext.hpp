@@ -51,9 +51,22 @@ public:
 	 */
 	void closeRessource();
 
+	/**
+	 * @brief Close the resource of an input media file, but keep the description of its format and of its streams
+	 * @note After that, packets can't be read anymore: only the properties of the file can be get
+	 */
+	void closeInputRessource();
+
+	/**
+	 * @brief Read the next packet of an input media file, whatever its stream
+	 * @param packet: packet to fill (must be free by the caller)
+	 * @return false at the end of the file or in case of error
+	 */
+	bool readFrame( AVPacket& packet );
+
 	/**
 	 * @brief Write the stream header to an output media file
-	 * @note Also load options specific to the output format
+	 * @note After that, options specific to the output format are available
 	 */
 	void writeHeader( AVDictionary** options = NULL );
 
@@ -87,10 +100,31 @@ public:
 	size_t getDuration() const { return _avFormatContext->duration; }
 	size_t getStartTime() const { return _avFormatContext->start_time; }
 
+	//@{
+	// @brief Get all the options of the format
+	// @note Wrap all the options of the format context: prefer getOption or setOption to access a few options.
 	OptionArray getOptions();  ///< Get options as array
-	OptionMap& getOptionsMap() { return _options; }  ///< Get options as map
+	OptionMap& getOptionsMap();  ///< Get options as map
+	//@}
+
+	/**
+	 * @brief Get the option with the given name
+	 * @note The option is wrapped on its first access.
+	 * @note Options specific to the output format are available after writeHeader.
+	 * @exception throw std::out_of_range if the format has no option with this name
+	 */
+	Option& getOption( const std::string& optionName );
 
-	Option& getOption( const std::string& optionName ) { return _options.at(optionName); }
+	/**
+	 * @brief Set the value of an option, directly in the format context.
+	 * @exception throw std::runtime_error if the option is not found or can't be set
+	 */
+	void setOption( const std::string& optionName, const std::string& value );
+
+	/**
+	 * @return Number of options of the format already wrapped (by getOption, getOptions or getOptionsMap)
+	 */
+	size_t getNbLoadedOptions() const { return _options.size(); }
 
 	/**
 	 * Guess format from arguments.
@@ -115,10 +149,16 @@ public:
 	AVStream& getAVStream( size_t index ) const;
 #endif
 
+private:
+	/**
+	 * @return The private data of the input/output format (which contains its specific options), or NULL.
+	 */
+	void* getPrivateData() const;
+
 private:
 	AVFormatContext* _avFormatContext;  ///< Has ownership
 	const int _flags;  ///< Flags with which the options are loaded (see AV_OPT_FLAG_xxx)
-	OptionMap _options;
+	OptionMap _options;  ///< Options already wrapped (loaded on demand)
 	bool _isOpen;  ///< Is the AVFormatContext open (in constructor with a filename)
 };
 
@@ -0,0 +1,200 @@
+#include "ImageSequenceReader.hpp"
+
+#include <AvTranscoder/file/InputFile.hpp>
+#include <AvTranscoder/decoder/VideoDecoder.hpp>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <limits>
+
+namespace avtranscoder
+{
+
+ImageSequenceReader::ImageSequenceReader( const std::string& filenamePattern, const size_t firstIndex, const size_t nbThreads, const size_t nbFramesAhead )
+	: _filenamePattern( filenamePattern )
+	, _firstIndex( firstIndex )
+	, _threads()
+	, _nbFramesAhead( nbFramesAhead )
+	, _frames()
+	, _nextIndexToDecode( 0 )
+	, _nextIndexToRead( 0 )
+	, _nbImages( std::numeric_limits<size_t>::max() )
+	, _errors()
+	, _isStopping( false )
+{
+	const size_t nbWorkers = nbThreads ? nbThreads : Thread::getNbProcessors();
+	if( ! _nbFramesAhead )
+		_nbFramesAhead = 2 * nbWorkers;
+
+	LOG_INFO( "Read the image sequence '" << _filenamePattern << "' with " << nbWorkers << " threads" )
+	try
+	{
+		for( size_t i = 0; i < nbWorkers; ++i )
+		{
+			_threads.push_back( new Thread() );
+			_threads.back()->start( &ImageSequenceReader::run, this );
+		}
+	}
+	catch( ... )
+	{
+		// the destructor is not called when the constructor throws
+		stopThreads();
+		throw;
+	}
+}
+
+ImageSequenceReader::~ImageSequenceReader()
+{
+	stopThreads();
+
+	for( std::map< size_t, VideoFrame* >::iterator it = _frames.begin(); it != _frames.end(); ++it )
+	{
+		delete it->second;
+	}
+}
+
+bool ImageSequenceReader::readNextFrame( Frame& frame )
+{
+	VideoFrame* decodedFrame = NULL;
+	{
+		ScopedLock lock( _mutex );
+		while( _nextIndexToRead < _nbImages && ! _frames.count( _nextIndexToRead ) && ! _errors.count( _nextIndexToRead ) )
+			_frameDecoded.wait( _mutex );
+
+		if( _nextIndexToRead >= _nbImages )
+			return false;
+
+		std::map< size_t, std::string >::iterator error = _errors.find( _nextIndexToRead );
+		if( error != _errors.end() )
+		{
+			const std::string message = error->second;
+			_errors.erase( error );
+			++_nextIndexToRead;
+			_frameRead.notifyAll();
+			throw std::runtime_error( message );
+		}
+
+		std::map< size_t, VideoFrame* >::iterator decoded = _frames.find( _nextIndexToRead );
+		decodedFrame = decoded->second;
+		_frames.erase( decoded );
+		++_nextIndexToRead;
+	}
+	_frameRead.notifyAll();
+
+	frame.copyData( decodedFrame->getData(), decodedFrame->getSize() );
+	delete decodedFrame;
+	return true;
+}
+
+size_t ImageSequenceReader::getNbReadFrames() const
+{
+	ScopedLock lock( _mutex );
+	return _nextIndexToRead;
+}
+
+void ImageSequenceReader::stopThreads()
+{
+	{
+		ScopedLock lock( _mutex );
+		_isStopping = true;
+	}
+	_frameRead.notifyAll();
+
+	for( std::vector< Thread* >::iterator it = _threads.begin(); it != _threads.end(); ++it )
+	{
+		(*it)->join();
+		delete (*it);
+	}
+	_threads.clear();
+}
+
+void ImageSequenceReader::run( void* reader )
+{
+	static_cast<ImageSequenceReader*>( reader )->processImages();
+}
+
+void ImageSequenceReader::processImages()
+{
+	while( true )
+	{
+		size_t index = 0;
+		{
+			ScopedLock lock( _mutex );
+			while( ! _isStopping && ( _nextIndexToDecode >= _nbImages || _nextIndexToDecode >= _nextIndexToRead + _nbFramesAhead ) )
+				_frameRead.wait( _mutex );
+			if( _isStopping )
+				break;
+			index = _nextIndexToDecode++;
+		}
+
+		VideoFrame* frame = NULL;
+		std::string error;
+		try
+		{
+			frame = readImage( index );
+		}
+		catch( const std::exception& e )
+		{
+			error = e.what();
+		}
+
+		{
+			ScopedLock lock( _mutex );
+			if( frame )
+				_frames[index] = frame;
+			else if( ! error.empty() )
+				_errors[index] = error;
+			else if( index < _nbImages )
+			{
+				LOG_INFO( "End of the image sequence '" << _filenamePattern << "' after " << index << " images" )
+				_nbImages = index;
+				// the images after the first missing file are not part of the sequence
+				while( ! _frames.empty() && _frames.rbegin()->first >= _nbImages )
+				{
+					delete _frames.rbegin()->second;
+					_frames.erase( _frames.rbegin()->first );
+				}
+				_errors.erase( _errors.lower_bound( _nbImages ), _errors.end() );
+			}
+		}
+		_frameDecoded.notifyAll();
+	}
+}
+
+VideoFrame* ImageSequenceReader::readImage( const size_t index ) const
+{
+	char filename[1024];
+	if( av_get_frame_filename( filename, sizeof( filename ), _filenamePattern.c_str(), _firstIndex + index ) < 0 )
+		throw std::runtime_error( "Invalid pattern of image sequence '" + _filenamePattern + "'" );
+
+	if( ! std::ifstream( filename ).good() )
+		return NULL;
+
+	LOG_DEBUG( "Read image " << _firstIndex + index << " from '" << filename << "'" )
+	InputFile inputFile( filename );
+	if( ! inputFile.getFormatContext().getNbStreams() )
+		throw std::runtime_error( std::string( "No image in '" ) + filename + "'" );
+
+	InputStream& inputStream = inputFile.getStream( 0 );
+	inputFile.activateStream( 0 );
+
+	VideoDecoder decoder( inputStream );
+	// the images are decoded in parallel
+	inputStream.getVideoCodec().getAVCodecContext().thread_count = 1;
+	decoder.setupDecoder();
+
+	VideoFrame* frame = new VideoFrame( inputStream.getVideoCodec().getVideoFrameDesc() );
+	if( ! decoder.decodeNextFrame( *frame ) )
+	{
+		delete frame;
+		throw std::runtime_error( std::string( "Unable to decode the image '" ) + filename + "'" );
+	}
+	return frame;
+}
+
+}
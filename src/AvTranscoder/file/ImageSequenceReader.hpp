@@ -0,0 +1,94 @@
+#ifndef _AV_TRANSCODER_FILE_IMAGE_SEQUENCE_READER_HPP_
+#define _AV_TRANSCODER_FILE_IMAGE_SEQUENCE_READER_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/frame/VideoFrame.hpp>
+#include <AvTranscoder/thread.hpp>
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Read and decode the images of a sequence (a file per image), on a pool of threads.
+ * The threads decode the next images ahead of the one which is read: the images are returned in order.
+ * @note The sequence ends at the first missing file.
+ * @see ImageSequenceWriter
+ */
+class AvExport ImageSequenceReader
+{
+private:
+	ImageSequenceReader( const ImageSequenceReader& imageSequenceReader );
+	ImageSequenceReader& operator=( const ImageSequenceReader& imageSequenceReader );
+
+public:
+	/**
+	 * @param filenamePattern: pattern of the filenames, with the index of the image as a printf integer (ie. "image.%06d.dpx")
+	 * @param firstIndex: index of the first image in the filenames
+	 * @param nbThreads: number of images decoded at the same time (0 for the number of processors)
+	 * @param nbFramesAhead: maximum number of images decoded ahead of the one which is read (0 for twice the number of threads)
+	 */
+	ImageSequenceReader( const std::string& filenamePattern, const size_t firstIndex = 0, const size_t nbThreads = 0, const size_t nbFramesAhead = 0 );
+
+	~ImageSequenceReader();
+
+	/**
+	 * @brief Copy the data of the next image of the sequence in the given frame.
+	 * @note Wait until the image is decoded.
+	 * @return false at the end of the sequence
+	 * @exception throw std::runtime_error if the image could not be decoded
+	 */
+	bool readNextFrame( Frame& frame );
+
+	/**
+	 * @brief Returns the number of images read.
+	 */
+	size_t getNbReadFrames() const;
+
+	size_t getNbThreads() const { return _threads.size(); }
+
+private:
+	/**
+	 * @brief Stop the threads once they are waiting, and delete them.
+	 */
+	void stopThreads();
+
+	static void run( void* reader );
+
+	/**
+	 * @brief Decode the next images until the reader stops.
+	 */
+	void processImages();
+
+	/**
+	 * @brief Open the file of the image at the given index, and decode its first frame.
+	 * @return NULL if the file does not exist
+	 * @exception throw std::runtime_error if the image could not be decoded
+	 */
+	VideoFrame* readImage( const size_t index ) const;
+
+private:
+	const std::string _filenamePattern;
+	const size_t _firstIndex;
+
+	std::vector< Thread* > _threads;  ///< Has ownership
+	size_t _nbFramesAhead;
+
+	mutable Mutex _mutex;  ///< Protect the members below
+	Condition _frameRead;  ///< Notified when an image is read, or when the reader stops
+	Condition _frameDecoded;  ///< Notified when an image is decoded, or when the end of the sequence is found
+
+	std::map< size_t, VideoFrame* > _frames;  ///< Images decoded and not read yet, by index in the sequence (has ownership)
+	size_t _nextIndexToDecode;  ///< Index in the sequence (from 0) of the next image to decode
+	size_t _nextIndexToRead;  ///< Index in the sequence (from 0) of the next image to read
+	size_t _nbImages;  ///< Index of the first missing file (std::numeric_limits<size_t>::max() until found)
+	std::map< size_t, std::string > _errors;  ///< Errors of the images which could not be decoded, by index in the sequence
+	bool _isStopping;  ///< Set to stop the threads
+};
+
+}
+
+#endif
@@ -0,0 +1,236 @@
+#include "ImageSequenceWriter.hpp"
+
+#include <AvTranscoder/encoder/VideoEncoder.hpp>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace avtranscoder
+{
+
+ImageSequenceWriter::ImageSequenceWriter( const std::string& filenamePattern, const std::string& codecName, const VideoFrameDesc& frameDesc,
+		const ProfileLoader::Profile& profile, const size_t nbThreads, const size_t firstIndex )
+	: _filenamePattern( filenamePattern )
+	, _codecName( codecName )
+	, _frameDesc( frameDesc )
+	, _profile( profile )
+	, _firstIndex( firstIndex )
+	, _threads()
+	, _maxNbQueuedJobs( 0 )
+	, _jobs()
+	, _nbQueuedFrames( 0 )
+	, _nbWrittenFrames( 0 )
+	, _nbProcessingJobs( 0 )
+	, _writtenOutOfOrder()
+	, _isStopping( false )
+	, _error()
+{
+	const size_t nbWorkers = nbThreads ? nbThreads : Thread::getNbProcessors();
+	_maxNbQueuedJobs = 2 * nbWorkers;
+
+	LOG_INFO( "Write the image sequence '" << _filenamePattern << "' with " << nbWorkers << " threads" )
+	try
+	{
+		for( size_t i = 0; i < nbWorkers; ++i )
+		{
+			_threads.push_back( new Thread() );
+			_threads.back()->start( &ImageSequenceWriter::run, this );
+		}
+	}
+	catch( ... )
+	{
+		// the destructor is not called when the constructor throws
+		stopThreads();
+		throw;
+	}
+}
+
+ImageSequenceWriter::~ImageSequenceWriter()
+{
+	{
+		ScopedLock lock( _mutex );
+		while( ! _jobs.empty() || _nbProcessingJobs )
+			_jobDone.wait( _mutex );
+	}
+	stopThreads();
+
+	if( ! _error.empty() )
+		LOG_ERROR( "The image sequence '" << _filenamePattern << "' is not complete: " << _error )
+}
+
+void ImageSequenceWriter::writeFrame( const VideoFrame& frame )
+{
+	VideoFrame* queuedFrame = new VideoFrame( frame );
+	{
+		ScopedLock lock( _mutex );
+		while( _jobs.size() >= _maxNbQueuedJobs && _error.empty() )
+			_jobDone.wait( _mutex );
+
+		if( ! _error.empty() )
+		{
+			delete queuedFrame;
+			checkError();
+		}
+
+		Job job;
+		job._index = _nbQueuedFrames++;
+		job._frame = queuedFrame;
+		_jobs.push_back( job );
+	}
+	_jobQueued.notifyOne();
+}
+
+void ImageSequenceWriter::flush()
+{
+	ScopedLock lock( _mutex );
+	while( ! _jobs.empty() || _nbProcessingJobs )
+		_jobDone.wait( _mutex );
+	checkError();
+}
+
+size_t ImageSequenceWriter::getNbWrittenFrames() const
+{
+	ScopedLock lock( _mutex );
+	return _nbWrittenFrames;
+}
+
+void ImageSequenceWriter::stopThreads()
+{
+	{
+		ScopedLock lock( _mutex );
+		_isStopping = true;
+	}
+	_jobQueued.notifyAll();
+
+	for( std::vector< Thread* >::iterator it = _threads.begin(); it != _threads.end(); ++it )
+	{
+		(*it)->join();
+		delete (*it);
+	}
+	_threads.clear();
+}
+
+void ImageSequenceWriter::run( void* writer )
+{
+	static_cast<ImageSequenceWriter*>( writer )->processJobs();
+}
+
+void ImageSequenceWriter::processJobs()
+{
+	// each thread has its own encoder
+	VideoEncoder* encoder = NULL;
+	std::string setupError;
+	try
+	{
+		encoder = new VideoEncoder( _codecName );
+		// the images are encoded in parallel
+		if( ! _profile.count( constants::avProfileThreads ) )
+			encoder->getVideoCodec().getAVCodecContext().thread_count = 1;
+		encoder->setupVideoEncoder( _frameDesc, _profile );
+	}
+	catch( const std::exception& e )
+	{
+		setupError = std::string( "unable to setup the encoder - " ) + e.what();
+		delete encoder;
+		encoder = NULL;
+	}
+
+	while( true )
+	{
+		Job job;
+		bool hasError = false;  // the error is read under the lock
+		{
+			ScopedLock lock( _mutex );
+			if( ! setupError.empty() && _error.empty() )
+				_error = setupError;
+
+			while( _jobs.empty() && ! _isStopping )
+				_jobQueued.wait( _mutex );
+			if( _jobs.empty() )
+				break;
+
+			job = _jobs.front();
+			_jobs.pop_front();
+			++_nbProcessingJobs;
+			hasError = ! _error.empty();
+		}
+		// room in the queue
+		_jobDone.notifyAll();
+
+		std::string error;
+		if( encoder && ! hasError )
+		{
+			try
+			{
+				writeImage( *encoder, job );
+			}
+			catch( const std::exception& e )
+			{
+				error = e.what();
+			}
+		}
+		delete job._frame;
+
+		{
+			ScopedLock lock( _mutex );
+			--_nbProcessingJobs;
+			if( ! encoder || ! error.empty() || ! _error.empty() )
+			{
+				// the queued images are dropped after an error
+				if( _error.empty() )
+					_error = error;
+			}
+			else
+			{
+				_writtenOutOfOrder.insert( job._index );
+				while( ! _writtenOutOfOrder.empty() && *_writtenOutOfOrder.begin() == _nbWrittenFrames )
+				{
+					_writtenOutOfOrder.erase( _writtenOutOfOrder.begin() );
+					++_nbWrittenFrames;
+				}
+			}
+		}
+		_jobDone.notifyAll();
+	}
+
+	delete encoder;
+}
+
+void ImageSequenceWriter::writeImage( VideoEncoder& encoder, const Job& job )
+{
+	const size_t index = _firstIndex + job._index;
+
+	char filename[1024];
+	if( av_get_frame_filename( filename, sizeof( filename ), _filenamePattern.c_str(), index ) < 0 )
+		throw std::runtime_error( "Invalid pattern of image sequence '" + _filenamePattern + "'" );
+
+	CodedData data;
+	encoder.encodeFrame( *job._frame, data );
+	if( ! data.getSize() )
+	{
+		std::stringstream os;
+		os << "Unable to encode the image " << index << " with " << _codecName << " (encoder with delay)";
+		throw std::runtime_error( os.str() );
+	}
+
+	LOG_DEBUG( "Write image " << index << " in '" << filename << "' (" << data.getSize() << " bytes)" )
+	std::ofstream file( filename, std::ios::out | std::ios::binary | std::ios::trunc );
+	file.write( reinterpret_cast<const char*>( data.getData() ), data.getSize() );
+	file.close();
+	if( file.fail() )
+		throw std::runtime_error( std::string( "Unable to write the image '" ) + filename + "'" );
+}
+
+void ImageSequenceWriter::checkError() const
+{
+	// the mutex is locked by the caller
+	if( ! _error.empty() )
+		throw std::runtime_error( "Unable to write the image sequence '" + _filenamePattern + "': " + _error );
+}
+
+}
@@ -0,0 +1,126 @@
+#ifndef _AV_TRANSCODER_FILE_IMAGE_SEQUENCE_WRITER_HPP_
+#define _AV_TRANSCODER_FILE_IMAGE_SEQUENCE_WRITER_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/frame/VideoFrame.hpp>
+#include <AvTranscoder/profile/ProfileLoader.hpp>
+#include <AvTranscoder/thread.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+
+namespace avtranscoder
+{
+
+class VideoEncoder;
+
+/**
+ * @brief Encode and write the images of a sequence (a file per image), on a pool of threads.
+ * Each thread has its own encoder: the images are encoded and written at the same time, and may end in any order.
+ * @note The images of a sequence are independent: prefer this class to an OutputFile with the image2 muxer for the image codecs (dpx, tiff, png...).
+ * @see ImageSequenceReader
+ */
+class AvExport ImageSequenceWriter
+{
+private:
+	ImageSequenceWriter( const ImageSequenceWriter& imageSequenceWriter );
+	ImageSequenceWriter& operator=( const ImageSequenceWriter& imageSequenceWriter );
+
+public:
+	/**
+	 * @param filenamePattern: pattern of the filenames, with the index of the image as a printf integer (ie. "image.%06d.dpx")
+	 * @param codecName: name of the image encoder (dpx, tiff, png, mjpeg...)
+	 * @param frameDesc: description of the images to write
+	 * @param profile: options of the encoder (by default each encoder uses one thread)
+	 * @param nbThreads: number of images encoded at the same time (0 for the number of processors)
+	 * @param firstIndex: index of the first image in the filenames
+	 */
+	ImageSequenceWriter( const std::string& filenamePattern, const std::string& codecName, const VideoFrameDesc& frameDesc,
+		const ProfileLoader::Profile& profile = ProfileLoader::Profile(), const size_t nbThreads = 0, const size_t firstIndex = 0 );
+
+	/**
+	 * @note Wait for the images to write.
+	 */
+	~ImageSequenceWriter();
+
+	/**
+	 * @brief Copy the image, and queue it to be written by the next available thread.
+	 * @note Wait if twice the number of threads of images are already queued.
+	 * @exception throw std::runtime_error if a previous image could not be written
+	 */
+	void writeFrame( const VideoFrame& frame );
+
+	/**
+	 * @brief Wait until all the queued images are written.
+	 * @exception throw std::runtime_error if an image could not be written
+	 */
+	void flush();
+
+	/**
+	 * @brief Returns the number of images written, in order from the first one.
+	 * @note An image written before one of the previous images is counted when all the previous images are written.
+	 */
+	size_t getNbWrittenFrames() const;
+
+	size_t getNbThreads() const { return _threads.size(); }
+
+private:
+	/**
+	 * @brief An image to write.
+	 */
+	struct Job
+	{
+		size_t _index;  ///< Index of the image in the sequence (from 0)
+		VideoFrame* _frame;  ///< Has ownership
+	};
+
+	/**
+	 * @brief Stop the threads once they are waiting, and delete them.
+	 */
+	void stopThreads();
+
+	static void run( void* writer );
+
+	/**
+	 * @brief Encode and write the queued images until the writer stops.
+	 */
+	void processJobs();
+
+	/**
+	 * @brief Encode the image and write it in its file.
+	 */
+	void writeImage( VideoEncoder& encoder, const Job& job );
+
+	/**
+	 * @exception throw std::runtime_error if an image could not be written
+	 */
+	void checkError() const;
+
+private:
+	const std::string _filenamePattern;
+	const std::string _codecName;
+	const VideoFrameDesc _frameDesc;
+	const ProfileLoader::Profile _profile;
+	const size_t _firstIndex;
+
+	std::vector< Thread* > _threads;  ///< Has ownership
+	size_t _maxNbQueuedJobs;  ///< Maximum number of images in the queue
+
+	mutable Mutex _mutex;  ///< Protect the members below
+	Condition _jobQueued;  ///< Notified when an image is queued, or when the writer stops
+	Condition _jobDone;  ///< Notified when an image is written
+
+	std::deque< Job > _jobs;  ///< Images to write
+	size_t _nbQueuedFrames;  ///< Number of images given to writeFrame
+	size_t _nbWrittenFrames;  ///< Number of images written, in order from the first one
+	size_t _nbProcessingJobs;  ///< Number of images being written
+	std::set< size_t > _writtenOutOfOrder;  ///< Indexes of the images written after _nbWrittenFrames
+	bool _isStopping;  ///< Set to stop the threads
+	std::string _error;  ///< First error of the threads (empty if no error)
+};
+
+}
+
+#endif
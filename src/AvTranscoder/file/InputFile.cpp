@@ -1,5 +1,6 @@
 #include "InputFile.hpp"
 
+#include <AvTranscoder/file/ProbeCache.hpp>
 #include <AvTranscoder/mediaProperty/util.hpp>
 #include <AvTranscoder/mediaProperty/VideoProperties.hpp>
 #include <AvTranscoder/mediaProperty/AudioProperties.hpp>
@@ -17,6 +18,12 @@ extern "C" {
 #include <stdexcept>
 #include <sstream>
 
+#if defined( __WINDOWS__ )
+ #define avtranscoderFseek _fseeki64
+#else
+ #define avtranscoderFseek fseeko
+#endif
+
 namespace avtranscoder
 {
 
@@ -25,6 +32,14 @@ InputFile::InputFile( const std::string& filename )
 	, _properties( _formatContext )
 	, _filename( filename )
 	, _inputStreams()
+	, _maxCacheSize( 0 )
+	, _cacheSize( 0 )
+	, _peakCacheSize( 0 )
+	, _spillFile( NULL )
+	, _spillFilePosition( 0 )
+	, _spilledSize( 0 )
+	, _totalSpilledSize( 0 )
+	, _nbSpilledPackets( 0 )
 {
 	_formatContext.findStreamInfo();
 
@@ -41,18 +56,27 @@ InputFile::~InputFile()
 	{
 		delete (*it);
 	}
+
+	// the temporary file is removed when closed
+	if( _spillFile )
+		fclose( _spillFile );
 }
 
 void InputFile::analyse( IProgress& progress, const EAnalyseLevel level )
 {
+	// the analysis could need packets of all the streams
+	updateStreamsDiscard( false );
 	_properties.extractStreamProperties( progress, level );
+	updateStreamsDiscard();
 }
 
 FileProperties InputFile::analyseFile( const std::string& filename, IProgress& progress, const EAnalyseLevel level )
 {
-	InputFile file( filename );
-	file.analyse( progress, level );
-	return file.getProperties();
+	// the copy keeps the entry of the cache until it is destroyed
+	const FileProperties& properties = ProbeCache::acquireProperties( filename, progress, level );
+	const FileProperties copy( properties );
+	ProbeCache::releaseProperties( properties );
+	return copy;
 }
 
 bool InputFile::readNextPacket( CodedData& data, const size_t streamIndex )
@@ -100,6 +124,26 @@ bool InputFile::seekAtTime( const double time, const int flag )
 void InputFile::activateStream( const size_t streamIndex, bool activate )
 {
 	getStream( streamIndex ).activate( activate );
+	updateStreamsDiscard();
+}
+
+void InputFile::updateStreamsDiscard( const bool discard )
+{
+	bool hasActivatedStream = false;
+	for( std::vector< InputStream* >::const_iterator it = _inputStreams.begin(); it != _inputStreams.end(); ++it )
+	{
+		if( (*it)->isActivated() )
+		{
+			hasActivatedStream = true;
+			break;
+		}
+	}
+
+	for( size_t streamIndex = 0; streamIndex < _inputStreams.size(); ++streamIndex )
+	{
+		const bool isRead = ! discard || ! hasActivatedStream || _inputStreams.at( streamIndex )->isActivated();
+		_formatContext.getAVStream( streamIndex ).discard = isRead ? AVDISCARD_DEFAULT : AVDISCARD_ALL;
+	}
 }
 
 InputStream& InputFile::getStream( size_t index )
@@ -187,8 +231,7 @@ void InputFile::setupUnwrapping( const ProfileLoader::Profile& profile )
 		
 		try
 		{
-			Option& formatOption = _formatContext.getOption( (*it).first );
-			formatOption.setString( (*it).second );
+			_formatContext.setOption( (*it).first, (*it).second );
 		}
 		catch( std::exception& e )
 		{
@@ -197,4 +240,64 @@ void InputFile::setupUnwrapping( const ProfileLoader::Profile& profile )
 	}
 }
 
-}
\ No newline at end of file
+bool InputFile::reserveCacheSize( const size_t size )
+{
+	if( _maxCacheSize && _cacheSize + size > _maxCacheSize )
+		return false;
+
+	_cacheSize += size;
+	if( _cacheSize > _peakCacheSize )
+		_peakCacheSize = _cacheSize;
+	return true;
+}
+
+void InputFile::releaseCacheSize( const size_t size )
+{
+	_cacheSize -= size;
+}
+
+int64_t InputFile::spillData( const unsigned char* data, const size_t size )
+{
+	if( ! _spillFile )
+	{
+		LOG_INFO( "The cache of packets of '" << _filename << "' is full (" << _maxCacheSize << " bytes): write the next packets in a temporary file" )
+		_spillFile = std::tmpfile();
+		if( ! _spillFile )
+			throw std::runtime_error( "Unable to create a temporary file to cache the packets of " + _filename );
+	}
+
+	const int64_t position = _spillFilePosition;
+	if( avtranscoderFseek( _spillFile, position, SEEK_SET ) != 0 ||
+		fwrite( data, 1, size, _spillFile ) != size )
+	{
+		throw std::runtime_error( "Unable to write in the temporary file which caches the packets of " + _filename );
+	}
+
+	_spillFilePosition += size;
+	_spilledSize += size;
+	_totalSpilledSize += size;
+	++_nbSpilledPackets;
+	return position;
+}
+
+void InputFile::readSpilledData( const int64_t position, const size_t size, CodedData& data )
+{
+	data.resize( size );
+	if( avtranscoderFseek( _spillFile, position, SEEK_SET ) != 0 ||
+		fread( data.getData(), 1, size, _spillFile ) != size )
+	{
+		throw std::runtime_error( "Unable to read the temporary file which caches the packets of " + _filename );
+	}
+	releaseSpilledData( size );
+}
+
+void InputFile::releaseSpilledData( const size_t size )
+{
+	_spilledSize -= size;
+
+	// all the spilled packets are read: reuse the temporary file from its beginning
+	if( _spilledSize == 0 )
+		_spillFilePosition = 0;
+}
+
+}
@@ -11,6 +11,7 @@
 
 #include <string>
 #include <vector>
+#include <cstdio>
 
 namespace avtranscoder
 {
@@ -60,6 +61,7 @@ public:
 	/** 
 	 * @brief Activate the indicated stream
 	 * @note Activate a stream results in buffered its data when processing
+	 * @note Once a stream is activated, the demuxer discards the packets of the streams which are not activated.
 	 **/
 	void activateStream( const size_t streamIndex, const bool activate = true );
 
@@ -102,16 +104,68 @@ public:
 	 */
 	virtual void setupUnwrapping( const ProfileLoader::Profile& profile );
 
+	/**
+	 * @brief Set the maximum size of the packets cached in memory for the activated streams, in bytes.
+	 * When this size is reached, the next packets are written in a temporary file and read back when needed.
+	 * @note By default 0 (no limit).
+	 */
+	void setMaxCacheSize( const size_t maxCacheSize ) { _maxCacheSize = maxCacheSize; }
+	size_t getMaxCacheSize() const { return _maxCacheSize; }
+
+	//@{
+	// Statistics of the cache of packets
+	size_t getCacheSize() const { return _cacheSize; }  ///< Size of the packets currently cached in memory, in bytes
+	size_t getPeakCacheSize() const { return _peakCacheSize; }  ///< Maximum size of the packets cached in memory, in bytes
+	size_t getSpilledSize() const { return _spilledSize; }  ///< Size of the packets currently in the temporary file, in bytes
+	size_t getTotalSpilledSize() const { return _totalSpilledSize; }  ///< Size of all the packets written in the temporary file, in bytes
+	size_t getNbSpilledPackets() const { return _nbSpilledPackets; }  ///< Number of packets written in the temporary file
+	//@}
+
+#ifndef SWIG
+	//@{
+	// Management of the cache of packets (used by the InputStreams)
+	/**
+	 * @return If a packet of the given size can be cached in memory.
+	 */
+	bool reserveCacheSize( const size_t size );
+	void releaseCacheSize( const size_t size );
+
+	/**
+	 * @brief Write the given data in the temporary file.
+	 * @return The position of the data in the temporary file.
+	 * @exception throw std::runtime_error if the temporary file can't be created or written
+	 */
+	int64_t spillData( const unsigned char* data, const size_t size );
+
+	/**
+	 * @brief Read back data written with spillData, and release its space in the temporary file.
+	 * @exception throw std::runtime_error if the temporary file can't be read
+	 */
+	void readSpilledData( const int64_t position, const size_t size, CodedData& data );
+	void releaseSpilledData( const size_t size );  ///< Release data of the temporary file without reading it
+	//@}
+#endif
+
 public:
 	/**
 	 * @brief Get media file properties using static method.
 	 * @param filename input filename
 	 * @param progress callback to get analysis progression
 	 * @return structure of media metadatas
+	 * @note The file is analysed only once per process, then its properties are get from the ProbeCache.
+	 * The returned properties keep their entry of the cache valid until they are destroyed.
+	 * @see ProbeCache
 	 **/
 	static FileProperties analyseFile( const std::string& filename, IProgress& progress, const EAnalyseLevel level = eAnalyseLevelFirstGop );
 
 private:
+	/**
+	 * @brief Set which streams are read by the demuxer.
+	 * If no stream is activated, all streams are read. Else, only the activated streams are read.
+	 * @param discard: if false, all streams are read
+	 */
+	void updateStreamsDiscard( const bool discard = true );
+
 	/**
 	 * @brief Get Fps from first video stream
 	 * @note if there is no video stream, return 1.
@@ -123,6 +177,16 @@ protected:
 	FileProperties _properties;
 	std::string _filename;
 	std::vector<InputStream*> _inputStreams;  ///< Has ownership
+
+private:
+	size_t _maxCacheSize;  ///< Maximum size of the packets cached in memory, in bytes (0 if no limit)
+	size_t _cacheSize;  ///< Size of the packets cached in memory, in bytes
+	size_t _peakCacheSize;  ///< Maximum of _cacheSize during the life of the file
+	std::FILE* _spillFile;  ///< Temporary file where packets are written when the cache is full (has ownership, created when needed)
+	int64_t _spillFilePosition;  ///< Position where the next packet is written in the temporary file
+	size_t _spilledSize;  ///< Size of the packets currently in the temporary file, in bytes
+	size_t _totalSpilledSize;  ///< Size of all the packets written in the temporary file, in bytes
+	size_t _nbSpilledPackets;  ///< Number of packets written in the temporary file
 };
 
 }
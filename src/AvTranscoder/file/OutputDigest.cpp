@@ -0,0 +1,183 @@
+#include "OutputDigest.hpp"
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavformat/avio.h>
+#include <libavutil/mem.h>
+}
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+
+namespace avtranscoder
+{
+
+namespace
+{
+
+/// Size of the buffer of the wrapping I/O context, in bytes
+const int ioBufferSize = 32 * 1024;
+
+/// Size of the buffer to read again the file, in bytes
+const size_t readBufferSize = 1024 * 1024;
+
+}
+
+OutputDigest::OutputDigest( const EDigestAlgorithm algorithm, const int64_t startPosition )
+	: _digest( algorithm )
+	, _snapshots()
+	, _fileIOContext( NULL )
+	, _ioContext( NULL )
+	, _position( startPosition )
+	, _digestedSize( 0 )
+	, _firstRewrittenPosition( startPosition ? 0 : -1 )
+{
+}
+
+OutputDigest::~OutputDigest()
+{
+	for( std::vector< std::pair< int64_t, Digest* > >::iterator it = _snapshots.begin(); it != _snapshots.end(); ++it )
+		delete it->second;
+
+	if( _ioContext )
+	{
+		av_free( _ioContext->buffer );
+		av_free( _ioContext );
+	}
+}
+
+void OutputDigest::attach( AVFormatContext& formatContext )
+{
+	if( ! formatContext.pb )
+		throw std::runtime_error( "Unable to digest an output format which has no I/O context" );
+
+	unsigned char* buffer = static_cast<unsigned char*>( av_malloc( ioBufferSize ) );
+	if( buffer )
+		_ioContext = avio_alloc_context( buffer, ioBufferSize, 1, this, NULL, &OutputDigest::writeData, &OutputDigest::seekData );
+	if( ! _ioContext )
+	{
+		av_free( buffer );
+		throw std::runtime_error( "Unable to allocate the I/O context to digest the output file" );
+	}
+
+	_fileIOContext = formatContext.pb;
+	_ioContext->seekable = _fileIOContext->seekable;
+	_ioContext->pos = _position;
+	formatContext.pb = _ioContext;
+}
+
+void OutputDigest::detach( AVFormatContext& formatContext )
+{
+	if( formatContext.pb != _ioContext )
+		return;
+
+	avio_flush( _ioContext );
+	formatContext.pb = _fileIOContext;
+}
+
+int64_t OutputDigest::flush()
+{
+	// the wrapping context writes in the buffer of the file context
+	avio_flush( _ioContext );
+	avio_flush( _fileIOContext );
+	return avio_tell( _fileIOContext );
+}
+
+std::string OutputDigest::getFileDigest( const std::string& filename )
+{
+	if( _firstRewrittenPosition < 0 )
+		return _digest.getHexDigest();
+
+	// restore the last state saved before the first rewritten byte
+	int64_t position = 0;
+	_digest.reset();
+	for( std::vector< std::pair< int64_t, Digest* > >::const_iterator it = _snapshots.begin(); it != _snapshots.end() && it->first <= _firstRewrittenPosition; ++it )
+	{
+		position = it->first;
+		_digest.setState( *it->second );
+	}
+
+	LOG_INFO( "Read again '" << filename << "' from " << position << " bytes to get its digest (bytes rewritten from " << _firstRewrittenPosition << ")" )
+	std::ifstream file( filename.c_str(), std::ios::in | std::ios::binary );
+	file.seekg( position );
+	if( ! file )
+	{
+		std::stringstream os;
+		os << "Unable to read the output file '" << filename << "' from " << position << " bytes to get its digest";
+		throw std::runtime_error( os.str() );
+	}
+
+	std::vector< char > buffer( readBufferSize );
+	while( file )
+	{
+		file.read( &buffer[0], buffer.size() );
+		_digest.update( reinterpret_cast<const unsigned char*>( &buffer[0] ), file.gcount() );
+	}
+	if( file.bad() )
+		throw std::runtime_error( "Unable to read the output file '" + filename + "' to get its digest" );
+
+	// the file is digested in order now
+	_firstRewrittenPosition = -1;
+	return _digest.getHexDigest();
+}
+
+int OutputDigest::writeData( void* opaque, uint8_t* buffer, int size )
+{
+	OutputDigest& outputDigest = *static_cast<OutputDigest*>( opaque );
+	avio_write( outputDigest._fileIOContext, buffer, size );
+	if( outputDigest._fileIOContext->error < 0 )
+		return outputDigest._fileIOContext->error;
+
+	outputDigest.digest( buffer, size );
+	return size;
+}
+
+int64_t OutputDigest::seekData( void* opaque, int64_t offset, int whence )
+{
+	OutputDigest& outputDigest = *static_cast<OutputDigest*>( opaque );
+	if( whence & AVSEEK_SIZE )
+		return avio_size( outputDigest._fileIOContext );
+
+	const int64_t position = avio_seek( outputDigest._fileIOContext, offset, whence & ~AVSEEK_FORCE );
+	if( position >= 0 )
+		outputDigest._position = position;
+	return position;
+}
+
+void OutputDigest::digest( const unsigned char* data, const size_t size )
+{
+	const int64_t position = _position;
+	_position += size;
+
+	// the bytes after a rewritten byte are digested when the file is read again
+	if( _firstRewrittenPosition >= 0 )
+		return;
+
+	if( position != _digestedSize )
+	{
+		_firstRewrittenPosition = std::min( position, _digestedSize );
+		LOG_DEBUG( "Bytes rewritten at " << position << " in the digested output file (" << _digestedSize << " bytes digested in order)" )
+		return;
+	}
+
+	size_t digestedSize = 0;
+	while( digestedSize < size )
+	{
+		const int64_t nextSnapshotSize = ( _digestedSize / outputDigestSnapshotInterval + 1 ) * outputDigestSnapshotInterval;
+		const size_t partSize = std::min( static_cast<int64_t>( size - digestedSize ), nextSnapshotSize - _digestedSize );
+		_digest.update( data + digestedSize, partSize );
+		digestedSize += partSize;
+		_digestedSize += partSize;
+
+		if( _digestedSize == nextSnapshotSize )
+		{
+			Digest* snapshot = new Digest( _digest.getAlgorithm() );
+			snapshot->setState( _digest );
+			_snapshots.push_back( std::make_pair( _digestedSize, snapshot ) );
+		}
+	}
+}
+
+}
@@ -0,0 +1,96 @@
+#ifndef _AV_TRANSCODER_FILE_OUTPUT_DIGEST_HPP_
+#define _AV_TRANSCODER_FILE_OUTPUT_DIGEST_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/Digest.hpp>
+
+#include <string>
+#include <vector>
+
+struct AVIOContext;
+struct AVFormatContext;
+
+namespace avtranscoder
+{
+
+/// Interval between two saved states of an OutputDigest, in bytes of the file
+const int64_t outputDigestSnapshotInterval = 16 * 1024 * 1024;
+
+/**
+ * @brief Compute the digest of an output file while the muxer writes it.
+ * The I/O context of the file is wrapped: the bytes written by the muxer go through the digest, then to the file.
+ * @note When the muxer seeks back to rewrite some bytes (sizes in the header, index...), the following bytes can't be digested in order:
+ * the state of the digest is saved every outputDigestSnapshotInterval bytes,
+ * and the file is read again from the last state saved before the first rewritten byte when the digest is asked.
+ * The formats which do not seek back (mpegts, dv, raw formats...) are never read again.
+ * @note The formats which patch their header at the end (wave, mov without faststart, mxf...) rewrite bytes before the first saved state:
+ * the whole file is then read again by getFileDigest, which costs as much as digesting the file after the process.
+ * @see OutputFile::setDigest
+ */
+class AvExport OutputDigest
+{
+private:
+	OutputDigest( const OutputDigest& outputDigest );
+	OutputDigest& operator=( const OutputDigest& outputDigest );
+
+public:
+	/**
+	 * @param startPosition: position of the I/O context of the file when attached (the bytes before it are read again to get the digest)
+	 */
+	OutputDigest( const EDigestAlgorithm algorithm, const int64_t startPosition = 0 );
+
+	~OutputDigest();
+
+	/**
+	 * @brief Replace the I/O context of the given format by a context which digests the written bytes.
+	 * @exception throw std::runtime_error if the format has no I/O context, or if the context can't be allocated
+	 */
+	void attach( AVFormatContext& formatContext );
+
+	/**
+	 * @brief Write the buffered bytes, and give back its own I/O context to the format.
+	 */
+	void detach( AVFormatContext& formatContext );
+
+	/**
+	 * @brief Write the buffered bytes in the file, through the I/O context of the file too.
+	 * @return the position in the file after the written bytes
+	 */
+	int64_t flush();
+
+	/**
+	 * @brief Returns the digest of the whole file, as an hexadecimal string.
+	 * @note Call it after the file is closed: the rewritten part of the file is read again.
+	 * @exception throw std::runtime_error if the file can't be read
+	 */
+	std::string getFileDigest( const std::string& filename );
+
+	EDigestAlgorithm getAlgorithm() const { return _digest.getAlgorithm(); }
+
+private:
+	//@{
+	// @brief Callbacks of the wrapping I/O context.
+	static int writeData( void* opaque, uint8_t* buffer, int size );
+	static int64_t seekData( void* opaque, int64_t offset, int whence );
+	//@}
+
+	/**
+	 * @brief Digest the bytes written at the current position, if they follow the digested bytes.
+	 */
+	void digest( const unsigned char* data, const size_t size );
+
+private:
+	Digest _digest;  ///< Digest of the first _digestedSize bytes of the file
+	std::vector< std::pair< int64_t, Digest* > > _snapshots;  ///< Saved states of the digest, by number of digested bytes (has ownership)
+
+	AVIOContext* _fileIOContext;  ///< I/O context of the file
+	AVIOContext* _ioContext;  ///< Wrapping I/O context given to the muxer (has ownership)
+
+	int64_t _position;  ///< Position in the file of the next written byte
+	int64_t _digestedSize;  ///< Number of bytes digested from the beginning of the file
+	int64_t _firstRewrittenPosition;  ///< Position of the first byte not digested in order (-1 if none)
+};
+
+}
+
+#endif
@@ -3,6 +3,15 @@
 #include <AvTranscoder/util.hpp>
 
 #include <stdexcept>
+#include <fstream>
+
+#if defined( __WINDOWS__ )
+ #include <io.h>
+ #include <fcntl.h>
+#else
+ #include <unistd.h>
+ #include <sys/types.h>
+#endif
 
 #ifndef FF_INPUT_BUFFER_PADDING_SIZE
  #define FF_INPUT_BUFFER_PADDING_SIZE 16
@@ -11,12 +20,37 @@
 namespace avtranscoder
 {
 
+namespace
+{
+
+/// Remove the data after the given size in the file
+bool truncateFile( const std::string& filename, const int64_t size )
+{
+#if defined( __WINDOWS__ )
+	const int fileDescriptor = _open( filename.c_str(), _O_RDWR | _O_BINARY );
+	if( fileDescriptor < 0 )
+		return false;
+	const bool isTruncated = _chsize_s( fileDescriptor, size ) == 0;
+	_close( fileDescriptor );
+	return isTruncated;
+#else
+	return truncate( filename.c_str(), size ) == 0;
+#endif
+}
+
+}
+
 OutputFile::OutputFile( const std::string& filename, const std::string& formatName, const std::string& mimeType )
 	: _formatContext( AV_OPT_FLAG_ENCODING_PARAM )
 	, _outputStreams()
 	, _frameCount()
+	, _muxStats()
 	, _previousProcessedStreamDuration( 0.0 )
 	, _profile()
+	, _isDigested( false )
+	, _digestAlgorithm( eDigestAlgorithmMd5 )
+	, _outputDigest( NULL )
+	, _digest()
 {
 	_formatContext.setFilename( filename );
 	_formatContext.setOutputFormat( filename, formatName, mimeType );
@@ -24,6 +58,12 @@ OutputFile::OutputFile( const std::string& filename, const std::string& formatNa
 
 OutputFile::~OutputFile()
 {
+	if( _outputDigest )
+	{
+		_outputDigest->detach( _formatContext.getAVFormatContext() );
+		delete _outputDigest;
+	}
+
 	for( std::vector< OutputStream* >::iterator it = _outputStreams.begin(); it != _outputStreams.end(); ++it )
 	{
 		delete (*it);
@@ -148,6 +188,40 @@ bool OutputFile::beginWrap( )
 	LOG_DEBUG( "Begin wrap of OutputFile" )
 
 	_formatContext.openRessource( getFilename(), AVIO_FLAG_WRITE );
+	beginDigest( 0 );
+	_formatContext.writeHeader();
+
+	// set specific wrapping options
+	setupRemainingWrappingOptions();
+
+	_frameCount.clear();
+	_frameCount.resize( _outputStreams.size(), 0 );
+	_muxStats.clear();
+	_muxStats.resize( _outputStreams.size() );
+
+	return true;
+}
+
+bool OutputFile::resumeWrap( const int64_t resumedSize )
+{
+	LOG_DEBUG( "Resume wrap of OutputFile after " << resumedSize << " bytes" )
+
+	const std::string filename = getFilename();
+	std::ifstream existingFile( filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate );
+	if( ! existingFile.is_open() || (int64_t)existingFile.tellg() < resumedSize )
+		throw std::runtime_error( "Unable to resume the wrapping of '" + filename + "': the file is missing or smaller than expected" );
+	existingFile.close();
+
+	if( ! truncateFile( filename, resumedSize ) )
+		throw std::runtime_error( "Unable to remove the data after the resume position of '" + filename + "'" );
+
+	// do not truncate the existing data
+	_formatContext.openRessource( filename, AVIO_FLAG_READ_WRITE );
+	AVIOContext* ioContext = _formatContext.getAVFormatContext().pb;
+	if( ioContext && avio_seek( ioContext, resumedSize, SEEK_SET ) < 0 )
+		throw std::runtime_error( "Unable to seek at the resume position of '" + filename + "'" );
+	beginDigest( resumedSize );
+
 	_formatContext.writeHeader();
 
 	// set specific wrapping options
@@ -155,6 +229,8 @@ bool OutputFile::beginWrap( )
 
 	_frameCount.clear();
 	_frameCount.resize( _outputStreams.size(), 0 );
+	_muxStats.clear();
+	_muxStats.resize( _outputStreams.size() );
 
 	return true;
 }
@@ -172,7 +248,7 @@ IOutputStream::EWrappingStatus OutputFile::wrap( const CodedData& data, const si
 	packet.data = (uint8_t*)data.getData();
 	packet.size = data.getSize();
 
-	_formatContext.writeFrame( packet );
+	writePacket( packet );
 
 	// free packet.side_data, set packet.data to NULL and packet.size to 0
 	av_free_packet( &packet );
@@ -190,15 +266,94 @@ IOutputStream::EWrappingStatus OutputFile::wrap( const CodedData& data, const si
 	return IOutputStream::eWrappingSuccess;
 }
 
+void OutputFile::wrapPacket( AVPacket& packet )
+{
+	LOG_DEBUG( "Wrap packet on stream " << packet.stream_index << " (" << packet.size << " bytes)" )
+
+	const size_t streamIndex = packet.stream_index;
+	writePacket( packet );
+	_frameCount.at( streamIndex )++;
+}
+
+void OutputFile::writePacket( AVPacket& packet )
+{
+	AVIOContext* ioContext = _formatContext.getAVFormatContext().pb;
+	const int64_t previousPosition = ioContext ? avio_tell( ioContext ) : 0;
+	const size_t packetSize = packet.size;
+
+	StageTimer timer( _muxStats.at( packet.stream_index ), "wrap", packet.stream_index );
+	_formatContext.writeFrame( packet );
+	const int64_t writtenSize = ioContext ? avio_tell( ioContext ) - previousPosition : 0;
+	timer.stop( packetSize, writtenSize > 0 ? writtenSize : 0 );
+}
+
+int64_t OutputFile::flush()
+{
+	// write the packets queued to interleave the streams
+	int ret = av_interleaved_write_frame( &_formatContext.getAVFormatContext(), NULL );
+	if( ret < 0 )
+		throw std::runtime_error( "Error when flushing the output file: " + getDescriptionFromErrorCode( ret ) );
+
+	// write the data buffered by the muxer itself (the pending PES packets of mpegts...)
+	ret = av_write_frame( &_formatContext.getAVFormatContext(), NULL );
+	if( ret < 0 )
+		throw std::runtime_error( "Error when flushing the muxer of the output file: " + getDescriptionFromErrorCode( ret ) );
+
+	if( _outputDigest )
+		return _outputDigest->flush();
+
+	AVIOContext* ioContext = _formatContext.getAVFormatContext().pb;
+	if( ! ioContext )
+		return 0;
+	avio_flush( ioContext );
+	return avio_tell( ioContext );
+}
+
 bool OutputFile::endWrap( )
 {
 	LOG_DEBUG( "End wrap of OutputFile" )
 
 	_formatContext.writeTrailer();
+	if( _outputDigest )
+		_outputDigest->detach( _formatContext.getAVFormatContext() );
 	_formatContext.closeRessource();
+
+	if( _outputDigest )
+	{
+		_digest = _outputDigest->getFileDigest( getFilename() );
+		LOG_INFO( getDigestAlgorithmName( _outputDigest->getAlgorithm() ) << " of '" << getFilename() << "': " << _digest )
+		delete _outputDigest;
+		_outputDigest = NULL;
+	}
 	return true;
 }
 
+void OutputFile::setDigest( const EDigestAlgorithm algorithm )
+{
+	_isDigested = true;
+	_digestAlgorithm = algorithm;
+}
+
+void OutputFile::beginDigest( const int64_t startPosition )
+{
+	_digest.clear();
+	delete _outputDigest;
+	_outputDigest = NULL;
+	if( ! _isDigested )
+		return;
+
+	AVFormatContext& formatContext = _formatContext.getAVFormatContext();
+	if( ! formatContext.pb )
+	{
+		LOG_WARN( "Unable to digest the output file '" << getFilename() << "': the format " << getFormatName() << " writes its own files" )
+		return;
+	}
+
+	LOG_DEBUG( "Digest the output file '" << getFilename() << "' with " << getDigestAlgorithmName( _digestAlgorithm ) )
+	_outputDigest = new OutputDigest( _digestAlgorithm, startPosition );
+	_outputDigest->attach( formatContext );
+}
+
 void OutputFile::addMetadata( const PropertyVector& data )
 {
 	for( PropertyVector::const_iterator it = data.begin(); it != data.end(); ++it )
@@ -253,8 +408,7 @@ void OutputFile::setupWrappingOptions( const ProfileLoader::Profile& profile )
 
 		try
 		{
-			Option& formatOption = _formatContext.getOption( (*it).first );
-			formatOption.setString( (*it).second );
+			_formatContext.setOption( (*it).first, (*it).second );
 		}
 		catch( std::exception& e )
 		{
@@ -277,8 +431,7 @@ void OutputFile::setupRemainingWrappingOptions()
 
 		try
 		{
-			Option& formatOption = _formatContext.getOption( (*it).first );
-			formatOption.setString( (*it).second );
+			_formatContext.setOption( (*it).first, (*it).second );
 		}
 		catch( std::exception& e )
 		{
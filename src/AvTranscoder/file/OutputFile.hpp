@@ -5,6 +5,8 @@
 
 #include <AvTranscoder/mediaProperty/util.hpp>
 #include <AvTranscoder/file/FormatContext.hpp>
+#include <AvTranscoder/file/OutputDigest.hpp>
+#include <AvTranscoder/stat/StageStat.hpp>
 
 #include <vector>
 
@@ -45,13 +47,55 @@ public:
 	 */
 	bool beginWrap();
 
+	/**
+	 * @brief Resume the wrapping of an existing output file: its first bytes are kept, and the new data is appended after them.
+	 * @param resumedSize: size of the data kept in the output file, in bytes (the following data is removed)
+	 * @note The header is written again: only for formats which can be cut between two packets (mpegts, dv, raw formats...).
+	 * @note The caller has to restore the timestamps of the output streams.
+	 * @exception throw std::runtime_error if the output file is smaller than the resumed size
+	 * @see Transcoder::setCheckpoint
+	 */
+	bool resumeWrap( const int64_t resumedSize );
+
 	IOutputStream::EWrappingStatus wrap( const CodedData& data, const size_t streamIndex );
 
+	/**
+	 * @brief Write the packets buffered by the muxer, and flush the output ressource.
+	 * @return the size of the data written in the output file, in bytes
+	 */
+	int64_t flush();
+
+#ifndef SWIG
+	/**
+	 * @brief Wrap the given packet as it is (no copy of its data).
+	 * @param packet: its stream index and its timestamps (in the time base of the output stream) have to be set by the caller.
+	 * The packet must be free by the caller.
+	 * @see Remuxer
+	 */
+	void wrapPacket( AVPacket& packet );
+#endif
+
 	/**
 	 * @brief Close ressource and write trailer.
+	 * @note If the output file is digested, its digest is available after this call.
+	 * @see getDigest
          */
 	bool endWrap();
 
+	/**
+	 * @brief Compute the digest of the output file while it is written, instead of reading it again after endWrap.
+	 * @note Call it before beginWrap (or resumeWrap, which reads again the resumed bytes at the end).
+	 * @note Only the end of the file from the first byte rewritten by the muxer is read again:
+	 * the formats which patch their header at the end (wave, mov without faststart, mxf...) are read again from the beginning.
+	 * @see OutputDigest
+	 */
+	void setDigest( const EDigestAlgorithm algorithm );
+
+	/**
+	 * @brief Returns the digest of the output file as an hexadecimal string, after endWrap (empty if not digested).
+	 */
+	std::string getDigest() const { return _digest; }
+
 	/**
 	 * @brief Add metadata to the output file.
 	 * @note Depending on the format, you are not sure to find your metadata after the transcode.
@@ -61,6 +105,13 @@ public:
 	
 	IOutputStream& getStream( const size_t streamIndex );
 
+	/**
+	 * @brief Returns the statistics of the packets wrapped in the stream at the given index, since beginWrap.
+	 * @note The output size is the number of bytes written in the file while wrapping the packets of the stream
+	 * (the muxer can delay the writing of the packets to interleave the streams).
+	 */
+	const StageStat& getMuxStat( const size_t streamIndex ) const { return _muxStats.at( streamIndex ); }
+
 	std::string getFilename() const;
 
 	/**
@@ -98,10 +149,25 @@ private:
 	void setupRemainingWrappingOptions();
 	//@}
 
+	/**
+	 * @brief Start to digest the bytes written in the output ressource, if asked.
+	 * @param startPosition: current position in the output ressource
+	 * @see setDigest
+	 */
+	void beginDigest( const int64_t startPosition );
+
+#ifndef SWIG
+	/**
+	 * @brief Write the packet in the output ressource, and update the statistics of its stream.
+	 */
+	void writePacket( AVPacket& packet );
+#endif
+
 private:
 	FormatContext _formatContext;
 	std::vector<OutputStream*> _outputStreams;  ///< Has ownership
 	std::vector<size_t> _frameCount;  ///< Number of wrapped frames
+	std::vector<StageStat> _muxStats;  ///< Statistics of the wrapped frames per stream
 
 	double _previousProcessedStreamDuration;  ///< To manage process streams order
 
@@ -111,6 +177,11 @@ private:
 	 * @see beginWrap
 	 */
 	ProfileLoader::Profile _profile;
+
+	bool _isDigested;  ///< If the output file has to be digested
+	EDigestAlgorithm _digestAlgorithm;
+	OutputDigest* _outputDigest;  ///< Digest of the bytes written between beginWrap and endWrap (has ownership)
+	std::string _digest;  ///< Digest of the output file, set when endWrap
 };
 
 }
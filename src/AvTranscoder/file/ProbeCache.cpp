@@ -0,0 +1,235 @@
+#include "ProbeCache.hpp"
+
+#include <AvTranscoder/file/InputFile.hpp>
+#include <AvTranscoder/progress/NoDisplayProgress.hpp>
+#include <AvTranscoder/thread.hpp>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+
+namespace avtranscoder
+{
+
+namespace
+{
+	Mutex probeCacheMutex;  ///< Protect the static members of the ProbeCache
+}
+
+std::map< std::string, ProbeCache::CacheEntry > ProbeCache::_entries;
+std::vector< ProbeCache::CacheEntry > ProbeCache::_retiredEntries;
+size_t ProbeCache::_maxNbEntries = ProbeCache::defaultMaxNbEntries;
+size_t ProbeCache::_nbAccesses = 0;
+
+const FileProperties& ProbeCache::getProperties( const std::string& filename, IProgress& progress, const EAnalyseLevel level )
+{
+	return getEntryProperties( filename, progress, level, false );
+}
+
+const FileProperties& ProbeCache::getProperties( const std::string& filename, const EAnalyseLevel level )
+{
+	NoDisplayProgress progress;
+	return getEntryProperties( filename, progress, level, false );
+}
+
+const FileProperties& ProbeCache::acquireProperties( const std::string& filename, IProgress& progress, const EAnalyseLevel level )
+{
+	return getEntryProperties( filename, progress, level, true );
+}
+
+const FileProperties& ProbeCache::acquireProperties( const std::string& filename, const EAnalyseLevel level )
+{
+	NoDisplayProgress progress;
+	return getEntryProperties( filename, progress, level, true );
+}
+
+bool ProbeCache::acquireProperties( const FileProperties& properties )
+{
+	ScopedLock lock( probeCacheMutex );
+	for( std::map< std::string, CacheEntry >::iterator it = _entries.begin(); it != _entries.end(); ++it )
+	{
+		if( &it->second._inputFile->getProperties() == &properties )
+		{
+			++it->second._nbUsers;
+			return true;
+		}
+	}
+	for( std::vector< CacheEntry >::iterator it = _retiredEntries.begin(); it != _retiredEntries.end(); ++it )
+	{
+		if( &it->_inputFile->getProperties() == &properties )
+		{
+			++it->_nbUsers;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ProbeCache::releaseProperties( const FileProperties& properties )
+{
+	ScopedLock lock( probeCacheMutex );
+	for( std::map< std::string, CacheEntry >::iterator it = _entries.begin(); it != _entries.end(); ++it )
+	{
+		if( &it->second._inputFile->getProperties() == &properties )
+		{
+			if( it->second._nbUsers )
+				--it->second._nbUsers;
+			return;
+		}
+	}
+	for( std::vector< CacheEntry >::iterator it = _retiredEntries.begin(); it != _retiredEntries.end(); ++it )
+	{
+		if( &it->_inputFile->getProperties() == &properties )
+		{
+			if( --it->_nbUsers == 0 )
+			{
+				delete it->_inputFile;
+				_retiredEntries.erase( it );
+			}
+			return;
+		}
+	}
+	LOG_WARN( "Release properties which are not acquired from the probe cache" )
+}
+
+const FileProperties& ProbeCache::getEntryProperties( const std::string& filename, IProgress& progress, const EAnalyseLevel level, const bool acquire )
+{
+	int64_t fileSize = -1;
+	int64_t modificationTime = -1;
+	getFileStatus( filename, fileSize, modificationTime );
+
+	// Cache hit
+	{
+		ScopedLock lock( probeCacheMutex );
+		std::map< std::string, CacheEntry >::iterator it = _entries.find( filename );
+		if( it != _entries.end() &&
+			it->second._level >= level &&
+			it->second._fileSize == fileSize &&
+			it->second._modificationTime == modificationTime )
+		{
+			LOG_DEBUG( "Get properties of '" << filename << "' from the probe cache" )
+			it->second._lastUse = ++_nbAccesses;
+			if( acquire )
+				++it->second._nbUsers;
+			return it->second._inputFile->getProperties();
+		}
+	}
+
+	// Cache miss: open and analyse the file without holding the lock
+	LOG_DEBUG( "Analyse '" << filename << "' to fill the probe cache" )
+	InputFile* inputFile = new InputFile( filename );
+	try
+	{
+		inputFile->analyse( progress, level );
+	}
+	catch( ... )
+	{
+		delete inputFile;
+		throw;
+	}
+	// only the description of the file is kept: release its file descriptor
+	inputFile->getFormatContext().closeInputRessource();
+
+	CacheEntry entry;
+	entry._inputFile = inputFile;
+	entry._level = level;
+	entry._fileSize = fileSize;
+	entry._modificationTime = modificationTime;
+	entry._nbUsers = acquire ? 1 : 0;
+
+	ScopedLock lock( probeCacheMutex );
+	entry._lastUse = ++_nbAccesses;
+	std::map< std::string, CacheEntry >::iterator it = _entries.find( filename );
+	if( it != _entries.end() )
+	{
+		// The file could have been analysed by another thread in the meantime
+		if( it->second._level >= level &&
+			it->second._fileSize == fileSize &&
+			it->second._modificationTime == modificationTime )
+		{
+			delete inputFile;
+			it->second._lastUse = entry._lastUse;
+			if( acquire )
+				++it->second._nbUsers;
+			return it->second._inputFile->getProperties();
+		}
+		removeEntry( it->second );
+		it->second = entry;
+	}
+	else
+	{
+		_entries.insert( std::make_pair( filename, entry ) );
+	}
+	removeLeastRecentlyUsedEntries();
+	return inputFile->getProperties();
+}
+
+void ProbeCache::removeEntry( const CacheEntry& entry )
+{
+	// Keep the entry alive while its properties are acquired
+	if( entry._nbUsers )
+		_retiredEntries.push_back( entry );
+	else
+		delete entry._inputFile;
+}
+
+void ProbeCache::removeLeastRecentlyUsedEntries()
+{
+	while( _entries.size() > _maxNbEntries )
+	{
+		std::map< std::string, CacheEntry >::iterator leastRecentlyUsed = _entries.begin();
+		for( std::map< std::string, CacheEntry >::iterator it = _entries.begin(); it != _entries.end(); ++it )
+		{
+			if( it->second._lastUse < leastRecentlyUsed->second._lastUse )
+				leastRecentlyUsed = it;
+		}
+		LOG_DEBUG( "Remove '" << leastRecentlyUsed->first << "' from the probe cache" )
+		removeEntry( leastRecentlyUsed->second );
+		_entries.erase( leastRecentlyUsed );
+	}
+}
+
+void ProbeCache::clear()
+{
+	ScopedLock lock( probeCacheMutex );
+	for( std::map< std::string, CacheEntry >::iterator it = _entries.begin(); it != _entries.end(); ++it )
+	{
+		removeEntry( it->second );
+	}
+	_entries.clear();
+}
+
+size_t ProbeCache::getNbEntries()
+{
+	ScopedLock lock( probeCacheMutex );
+	return _entries.size();
+}
+
+void ProbeCache::setMaxNbEntries( const size_t maxNbEntries )
+{
+	ScopedLock lock( probeCacheMutex );
+	_maxNbEntries = std::max( maxNbEntries, (size_t)1 );
+	removeLeastRecentlyUsedEntries();
+}
+
+size_t ProbeCache::getMaxNbEntries()
+{
+	ScopedLock lock( probeCacheMutex );
+	return _maxNbEntries;
+}
+
+void ProbeCache::getFileStatus( const std::string& filename, int64_t& fileSize, int64_t& modificationTime )
+{
+	struct stat fileStatus;
+	if( stat( filename.c_str(), &fileStatus ) != 0 )
+	{
+		fileSize = -1;
+		modificationTime = -1;
+		return;
+	}
+	fileSize = fileStatus.st_size;
+	modificationTime = fileStatus.st_mtime;
+}
+
+}
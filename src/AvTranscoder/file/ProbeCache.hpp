@@ -0,0 +1,125 @@
+#ifndef _AV_TRANSCODER_FILE_PROBE_CACHE_HPP_
+#define _AV_TRANSCODER_FILE_PROBE_CACHE_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/file/util.hpp>
+#include <AvTranscoder/mediaProperty/FileProperties.hpp>
+#include <AvTranscoder/progress/IProgress.hpp>
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace avtranscoder
+{
+
+class InputFile;
+
+/**
+ * @brief Process-wide cache of analysed media files.
+ * A file is opened and analysed once, then its properties are shared by all the components which need them
+ * (Transcoder, readers, InputFile::analyseFile...).
+ * An entry is identified by the path of the file, its size and its last modification time:
+ * if the file changes on disk, or if a deeper analysis is requested, the file is analysed again.
+ * The file is closed once analysed (only its description is kept), and the least recently used entries
+ * are removed when the cache is full.
+ * @note All methods are thread safe.
+ */
+class AvExport ProbeCache
+{
+private:
+	ProbeCache();
+
+public:
+	static const size_t defaultMaxNbEntries = 64;
+
+	/**
+	 * @brief Get the properties of the given file, analysed at least at the given level.
+	 * @param filename input filename
+	 * @param progress callback to get analysis progression (only called if the file is analysed)
+	 * @param level by default eAnalyseLevelFirstGop
+	 * @warning The returned reference is valid until the entry is removed from the cache (when the cache is full or cleared):
+	 * use acquireProperties, or a copy of the properties, to keep it valid.
+	 */
+	static const FileProperties& getProperties( const std::string& filename, IProgress& progress, const EAnalyseLevel level = eAnalyseLevelFirstGop );
+	static const FileProperties& getProperties( const std::string& filename, const EAnalyseLevel level = eAnalyseLevelFirstGop );  ///< Call getProperties with no display of progression
+
+	//@{
+	/**
+	 * @brief Get the properties of the given file like getProperties, and keep them valid until they are released.
+	 * @note Each call of acquireProperties has to be followed by a call of releaseProperties.
+	 */
+	static const FileProperties& acquireProperties( const std::string& filename, IProgress& progress, const EAnalyseLevel level = eAnalyseLevelFirstGop );
+	static const FileProperties& acquireProperties( const std::string& filename, const EAnalyseLevel level = eAnalyseLevelFirstGop );
+	static void releaseProperties( const FileProperties& properties );
+	//@}
+
+	/**
+	 * @brief Acquire again the given properties, if they are the ones of an entry of the cache.
+	 * @return false if the properties are not from the cache (nothing to release then)
+	 * @see FileProperties copy constructor
+	 */
+	static bool acquireProperties( const FileProperties& properties );
+
+	/**
+	 * @brief Remove all the entries of the cache.
+	 * @warning The properties get with getProperties are invalidated. The acquired ones are kept until they are released.
+	 */
+	static void clear();
+
+	/**
+	 * @return Number of files currently cached.
+	 */
+	static size_t getNbEntries();
+
+	/**
+	 * @brief Set the maximum number of files in the cache (at least 1).
+	 * @note By default defaultMaxNbEntries.
+	 */
+	static void setMaxNbEntries( const size_t maxNbEntries );
+	static size_t getMaxNbEntries();
+
+private:
+	struct CacheEntry
+	{
+		InputFile* _inputFile;  ///< Has ownership
+		EAnalyseLevel _level;  ///< Level of analysis of the file
+		int64_t _fileSize;  ///< -1 if unknown
+		int64_t _modificationTime;  ///< -1 if unknown
+		size_t _nbUsers;  ///< Number of acquired references to the properties
+		size_t _lastUse;  ///< Number of the last access to the entry, to remove the least recently used one
+	};
+
+	/**
+	 * @brief Get the entry of the given file, analysed at least at the given level, and add a user to it if acquired.
+	 */
+	static const FileProperties& getEntryProperties( const std::string& filename, IProgress& progress, const EAnalyseLevel level, const bool acquire );
+
+	/**
+	 * @brief Remove the given entry: it is deleted if it has no users, retired until released otherwise.
+	 * @note Has to be called with the lock.
+	 */
+	static void removeEntry( const CacheEntry& entry );
+
+	/**
+	 * @brief Remove the least recently used entries until the cache is not full.
+	 * @note Has to be called with the lock.
+	 */
+	static void removeLeastRecentlyUsedEntries();
+
+	/**
+	 * @brief Fill the size and the modification time of the given file.
+	 * @note Set -1 if the file can't be accessed in the filesystem (streams, urls...).
+	 */
+	static void getFileStatus( const std::string& filename, int64_t& fileSize, int64_t& modificationTime );
+
+private:
+	static std::map< std::string, CacheEntry > _entries;  ///< Analysed files per filename
+	static std::vector< CacheEntry > _retiredEntries;  ///< Removed entries which properties are still acquired
+	static size_t _maxNbEntries;
+	static size_t _nbAccesses;  ///< Number of accesses to the cache, to date the use of the entries
+};
+
+}
+
+#endif
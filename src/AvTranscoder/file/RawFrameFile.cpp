@@ -0,0 +1,281 @@
+#include "RawFrameFile.hpp"
+
+#if defined( __WINDOWS__ )
+ #include <windows.h>
+#else
+ #include <sys/mman.h>
+ #include <sys/types.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+#endif
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace avtranscoder
+{
+
+RawFrameFile::RawFrameFile( const std::string& filename, const VideoFrameDesc& frameDesc, const size_t expectedNbFrames )
+	: _filename( filename )
+	, _description()
+#if defined( __WINDOWS__ )
+	, _fileHandle( INVALID_HANDLE_VALUE )
+	, _mappingHandle( NULL )
+#else
+	, _fileDescriptor( -1 )
+#endif
+	, _mapping( NULL )
+	, _mappingSize( 0 )
+	, _writePosition( rawFrameFileAlignment )
+	, _index()
+{
+	std::ostringstream description;
+	description << "mediaType=video" << std::endl;
+	description << "width=" << frameDesc.getWidth() << std::endl;
+	description << "height=" << frameDesc.getHeight() << std::endl;
+	description << "pixelFormat=" << frameDesc.getPixelFormatName() << std::endl;
+	description << "fps=" << frameDesc.getFps() << std::endl;
+	_description = description.str();
+
+	open( rawFrameFileAlignment + expectedNbFrames * align( frameDesc.getDataSize() ) );
+}
+
+RawFrameFile::RawFrameFile( const std::string& filename, const AudioFrameDesc& frameDesc, const size_t expectedNbFrames, const size_t expectedNbSamplesPerFrame )
+	: _filename( filename )
+	, _description()
+#if defined( __WINDOWS__ )
+	, _fileHandle( INVALID_HANDLE_VALUE )
+	, _mappingHandle( NULL )
+#else
+	, _fileDescriptor( -1 )
+#endif
+	, _mapping( NULL )
+	, _mappingSize( 0 )
+	, _writePosition( rawFrameFileAlignment )
+	, _index()
+{
+	std::ostringstream description;
+	description << "mediaType=audio" << std::endl;
+	description << "sampleRate=" << frameDesc.getSampleRate() << std::endl;
+	description << "channels=" << frameDesc.getChannels() << std::endl;
+	description << "sampleFormat=" << frameDesc.getSampleFormatName() << std::endl;
+	_description = description.str();
+
+	const size_t frameSize = expectedNbSamplesPerFrame * frameDesc.getChannels() * av_get_bytes_per_sample( frameDesc.getSampleFormat() );
+	open( rawFrameFileAlignment + expectedNbFrames * align( frameSize ) );
+}
+
+RawFrameFile::~RawFrameFile()
+{
+	try
+	{
+		close();
+	}
+	catch( const std::exception& e )
+	{
+		LOG_ERROR( "Unable to close the raw frame file '" << _filename << "': " << e.what() )
+	}
+}
+
+void RawFrameFile::writeFrame( const Frame& frame )
+{
+	if( ! _mapping )
+		throw std::runtime_error( "Unable to write a frame in the closed file '" + _filename + "'" );
+
+	const int64_t frameSize = frame.getSize();
+	reserve( _writePosition + frameSize );
+
+	LOG_DEBUG( "Write frame " << _index.size() << " in '" << _filename << "' (" << frameSize << " bytes at " << _writePosition << ")" )
+	if( frameSize )
+		memcpy( _mapping + _writePosition, frame.getData(), frameSize );
+
+	_index.push_back( std::make_pair( _writePosition, frameSize ) );
+	_writePosition = align( _writePosition + frameSize );
+}
+
+void RawFrameFile::close()
+{
+	if( ! isOpen() )
+		return;
+
+	// the mapping is lost if the file can't grow: there is nothing to write
+	if( ! _mapping )
+	{
+		closeFile( -1 );
+		throw std::runtime_error( "Unable to write the index of the raw frame file '" + _filename + "'" );
+	}
+
+	int64_t fileSize = 0;
+	try
+	{
+		fileSize = writeIndexAndHeader();
+	}
+	catch( ... )
+	{
+		// the file is closed, even if it is incomplete
+		closeFile( -1 );
+		throw;
+	}
+	closeFile( fileSize );
+
+	LOG_INFO( "Close the raw frame file '" << _filename << "' (" << _index.size() << " frames)" )
+}
+
+int64_t RawFrameFile::writeIndexAndHeader()
+{
+	// index
+	const int64_t indexOffset = _writePosition;
+	const int64_t indexSize = _index.size() * 2 * sizeof( int64_t );
+	reserve( indexOffset + indexSize );
+	for( size_t i = 0; i < _index.size(); ++i )
+	{
+		int64_t* entry = reinterpret_cast<int64_t*>( _mapping + indexOffset ) + 2 * i;
+		entry[0] = _index.at( i ).first;
+		entry[1] = _index.at( i ).second;
+	}
+
+	// header
+	std::ostringstream header;
+	header << "avtranscoder raw frames" << std::endl;
+	header << "version=1" << std::endl;
+	header << _description;
+	header << "alignment=" << rawFrameFileAlignment << std::endl;
+	header << "nbFrames=" << _index.size() << std::endl;
+	header << "indexOffset=" << indexOffset << std::endl;
+	const std::string headerStr = header.str();
+	if( headerStr.size() >= rawFrameFileAlignment )
+		throw std::runtime_error( "The header of the raw frame file '" + _filename + "' is too long" );
+	memset( _mapping, 0, rawFrameFileAlignment );
+	memcpy( _mapping, headerStr.c_str(), headerStr.size() );
+
+	return indexOffset + indexSize;
+}
+
+void RawFrameFile::closeFile( const int64_t fileSize )
+{
+	unmap();
+
+	// remove the preallocated space which is not used
+	bool isResized = true;
+#if defined( __WINDOWS__ )
+	if( fileSize >= 0 )
+	{
+		LARGE_INTEGER size;
+		size.QuadPart = fileSize;
+		isResized = SetFilePointerEx( _fileHandle, size, NULL, FILE_BEGIN ) && SetEndOfFile( _fileHandle );
+	}
+	CloseHandle( _fileHandle );
+	_fileHandle = INVALID_HANDLE_VALUE;
+#else
+	if( fileSize >= 0 )
+		isResized = ftruncate( _fileDescriptor, fileSize ) == 0;
+	::close( _fileDescriptor );
+	_fileDescriptor = -1;
+#endif
+	if( ! isResized )
+		throw std::runtime_error( "Unable to set the size of the raw frame file '" + _filename + "'" );
+}
+
+void RawFrameFile::open( const int64_t preallocatedSize )
+{
+#if defined( __WINDOWS__ )
+	_fileHandle = CreateFileA( _filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL );
+	if( _fileHandle == INVALID_HANDLE_VALUE )
+		throw std::runtime_error( "Unable to create the raw frame file '" + _filename + "'" );
+#else
+	_fileDescriptor = ::open( _filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+	if( _fileDescriptor < 0 )
+		throw std::runtime_error( "Unable to create the raw frame file '" + _filename + "'" );
+#endif
+	try
+	{
+		map( align( preallocatedSize ) );
+	}
+	catch( ... )
+	{
+		// the destructor is not called when the constructor throws
+		closeFile( -1 );
+		throw;
+	}
+}
+
+bool RawFrameFile::isOpen() const
+{
+#if defined( __WINDOWS__ )
+	return _fileHandle != INVALID_HANDLE_VALUE;
+#else
+	return _fileDescriptor >= 0;
+#endif
+}
+
+void RawFrameFile::reserve( const int64_t size )
+{
+	if( size <= _mappingSize )
+		return;
+
+	// grow by doubling the size, to remap the file a few times
+	int64_t newSize = 2 * _mappingSize;
+	if( newSize < size )
+		newSize = size;
+
+	unmap();
+	map( align( newSize ) );
+}
+
+void RawFrameFile::map( const int64_t size )
+{
+	LOG_DEBUG( "Map " << size << " bytes of the raw frame file '" << _filename << "'" )
+
+#if defined( __WINDOWS__ )
+	// the file grows to the size of the mapping
+	_mappingHandle = CreateFileMappingA( _fileHandle, NULL, PAGE_READWRITE, (DWORD)( size >> 32 ), (DWORD)( size & 0xFFFFFFFF ), NULL );
+	if( _mappingHandle )
+	{
+		_mapping = static_cast<unsigned char*>( MapViewOfFile( _mappingHandle, FILE_MAP_WRITE, 0, 0, (SIZE_T)size ) );
+		if( ! _mapping )
+		{
+			CloseHandle( _mappingHandle );
+			_mappingHandle = NULL;
+		}
+	}
+#else
+	if( ftruncate( _fileDescriptor, size ) == 0 )
+	{
+		void* mapping = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0 );
+		if( mapping != MAP_FAILED )
+			_mapping = static_cast<unsigned char*>( mapping );
+	}
+#endif
+	if( ! _mapping )
+	{
+		std::ostringstream os;
+		os << "Unable to map " << size << " bytes of the raw frame file '" << _filename << "'";
+		throw std::runtime_error( os.str() );
+	}
+	_mappingSize = size;
+}
+
+void RawFrameFile::unmap()
+{
+	if( ! _mapping )
+		return;
+
+#if defined( __WINDOWS__ )
+	UnmapViewOfFile( _mapping );
+	CloseHandle( _mappingHandle );
+	_mappingHandle = NULL;
+#else
+	munmap( _mapping, _mappingSize );
+#endif
+	_mapping = NULL;
+	_mappingSize = 0;
+}
+
+int64_t RawFrameFile::align( const int64_t size )
+{
+	const int64_t alignment = rawFrameFileAlignment;
+	return ( size + alignment - 1 ) / alignment * alignment;
+}
+
+}
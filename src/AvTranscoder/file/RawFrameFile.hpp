@@ -0,0 +1,119 @@
+#ifndef _AV_TRANSCODER_FILE_RAW_FRAME_FILE_HPP_
+#define _AV_TRANSCODER_FILE_RAW_FRAME_FILE_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/frame/VideoFrame.hpp>
+#include <AvTranscoder/frame/AudioFrame.hpp>
+
+#include <string>
+#include <vector>
+
+namespace avtranscoder
+{
+
+/// Alignment of the header, of the data of each frame and of the index in a RawFrameFile (size of a memory page)
+const size_t rawFrameFileAlignment = 4096;
+
+/**
+ * @brief Write decoded frames in a memory-mapped file, without encoding nor wrapping.
+ * Layout of the file:
+ *  - a text header of rawFrameFileAlignment bytes, with a "key=value" per line (description of the frames, nbFrames, indexOffset), padded with '\0'.
+ *  - the data of each frame, as it is in the Frame, starting at an offset aligned on rawFrameFileAlignment bytes.
+ *  - the index, at indexOffset: for each frame, the offset and the size of its data (two int64_t in native byte order).
+ * @note Each frame can be read in place by mapping the file (its data is aligned on a memory page).
+ * @note The file is preallocated, and grows by doubling its size if more frames are written.
+ */
+class AvExport RawFrameFile
+{
+private:
+	RawFrameFile( const RawFrameFile& rawFrameFile );
+	RawFrameFile& operator=( const RawFrameFile& rawFrameFile );
+
+public:
+	/**
+	 * @brief Create a file to write video frames of the given description.
+	 * @param expectedNbFrames: number of frames for which the file is preallocated
+	 * @exception throw std::runtime_error if the file can't be created
+	 */
+	RawFrameFile( const std::string& filename, const VideoFrameDesc& frameDesc, const size_t expectedNbFrames = 0 );
+
+	/**
+	 * @brief Create a file to write audio frames of the given description.
+	 * @param expectedNbFrames: number of frames of expectedNbSamplesPerFrame for which the file is preallocated
+	 * @exception throw std::runtime_error if the file can't be created
+	 */
+	RawFrameFile( const std::string& filename, const AudioFrameDesc& frameDesc, const size_t expectedNbFrames = 0, const size_t expectedNbSamplesPerFrame = 1024 );
+
+	/**
+	 * @note Close the file.
+	 */
+	~RawFrameFile();
+
+	/**
+	 * @brief Copy the data of the frame at the end of the file.
+	 * @exception throw std::runtime_error if the file is closed, or can't grow
+	 */
+	void writeFrame( const Frame& frame );
+
+	/**
+	 * @brief Write the index and the header, and close the file.
+	 * @note This can be called several times with no side effects.
+	 * @exception throw std::runtime_error if the index or the header can't be written (the file is closed anyway)
+	 */
+	void close();
+
+	std::string getFilename() const { return _filename; }
+	size_t getNbFrames() const { return _index.size(); }
+
+private:
+	/**
+	 * @brief Create the file, preallocated with the given size.
+	 */
+	void open( const int64_t preallocatedSize );
+
+	/**
+	 * @brief Write the index after the frames, and the header at the beginning of the file.
+	 * @return the size of the file, in bytes
+	 */
+	int64_t writeIndexAndHeader();
+
+	/**
+	 * @brief Unmap and close the file, cut at the given size (not cut if negative).
+	 */
+	void closeFile( const int64_t fileSize );
+
+	bool isOpen() const;
+
+	/**
+	 * @brief Grow the mapping of the file if it is smaller than the given size.
+	 */
+	void reserve( const int64_t size );
+
+	void map( const int64_t size );
+	void unmap();
+
+	/**
+	 * @brief Returns the given size rounded up to the alignment.
+	 */
+	static int64_t align( const int64_t size );
+
+private:
+	std::string _filename;
+	std::string _description;  ///< Lines of the header which describe the frames
+
+#if defined( __WINDOWS__ )
+	void* _fileHandle;  ///< HANDLE of the file
+	void* _mappingHandle;  ///< HANDLE of the file mapping
+#else
+	int _fileDescriptor;
+#endif
+	unsigned char* _mapping;  ///< Data of the file mapped in memory (NULL if closed)
+	int64_t _mappingSize;  ///< Size of the file mapped in memory, in bytes
+	int64_t _writePosition;  ///< Position of the next frame in the file
+
+	std::vector< std::pair< int64_t, int64_t > > _index;  ///< Offset and size of each frame written
+};
+
+}
+
+#endif
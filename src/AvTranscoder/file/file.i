@@ -4,10 +4,29 @@
 #include <AvTranscoder/file/InputFile.hpp>
 #include <AvTranscoder/file/IOutputFile.hpp>
 #include <AvTranscoder/file/OutputFile.hpp>
+#include <AvTranscoder/file/ProbeCache.hpp>
+#include <AvTranscoder/file/RawFrameFile.hpp>
+#include <AvTranscoder/file/ImageSequenceWriter.hpp>
+#include <AvTranscoder/file/ImageSequenceReader.hpp>
 %}
 
+%thread avtranscoder::InputFile::InputFile;
+%thread avtranscoder::InputFile::analyse;
+%thread avtranscoder::InputFile::analyseFile;
+%thread avtranscoder::ProbeCache::getProperties;
+%thread avtranscoder::ProbeCache::acquireProperties;
+%thread avtranscoder::ImageSequenceWriter::writeFrame;
+%thread avtranscoder::ImageSequenceWriter::flush;
+%thread avtranscoder::ImageSequenceWriter::~ImageSequenceWriter;
+%thread avtranscoder::ImageSequenceReader::readNextFrame;
+%thread avtranscoder::ImageSequenceReader::~ImageSequenceReader;
+
 %include <AvTranscoder/file/util.hpp>
 %include <AvTranscoder/file/FormatContext.hpp>
 %include <AvTranscoder/file/InputFile.hpp>
 %include <AvTranscoder/file/IOutputFile.hpp>
 %include <AvTranscoder/file/OutputFile.hpp>
+%include <AvTranscoder/file/ProbeCache.hpp>
+%include <AvTranscoder/file/RawFrameFile.hpp>
+%include <AvTranscoder/file/ImageSequenceWriter.hpp>
+%include <AvTranscoder/file/ImageSequenceReader.hpp>
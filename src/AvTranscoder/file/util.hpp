@@ -11,7 +11,7 @@ enum EAnalyseLevel
 {
 	eAnalyseLevelHeader = 0,
 	eAnalyseLevelFirstGop = 1,
-	//eAnalyseLevelFull = 2,
+	eAnalyseLevelFull = 2,  ///< Decode all the video and audio frames, to detect the black, frozen and silent segments
 };
 
 }
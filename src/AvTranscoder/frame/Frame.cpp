@@ -2,6 +2,10 @@
 
 #include <cstring>
 
+#ifndef FF_INPUT_BUFFER_PADDING_SIZE
+ #define FF_INPUT_BUFFER_PADDING_SIZE 16
+#endif
+
 namespace avtranscoder
 {
 
@@ -40,10 +44,31 @@ void Frame::resize( const size_t newSize )
 {
 	if( (int) newSize < _packet.size )
 		av_shrink_packet( &_packet, newSize );
-	 else if( (int) newSize > _packet.size )
+	else if( newSize <= getCapacity() )
+	{
+		// the data is not moved
+		_packet.size = newSize;
+		memset( _packet.data + newSize, 0, FF_INPUT_BUFFER_PADDING_SIZE );
+	}
+	else if( (int) newSize > _packet.size )
 		av_grow_packet( &_packet, newSize - _packet.size );
 }
 
+size_t Frame::getCapacity() const
+{
+#if LIBAVCODEC_VERSION_MAJOR > 54
+	// the buffer is not shared, and not a reference to external data
+	if( ! _packet.buf || ! _packet.data || ! av_buffer_is_writable( _packet.buf ) ||
+		_packet.data < _packet.buf->data || _packet.data >= _packet.buf->data + _packet.buf->size )
+		return _packet.size;
+
+	const int capacity = _packet.buf->size - ( _packet.data - _packet.buf->data ) - FF_INPUT_BUFFER_PADDING_SIZE;
+	return capacity > _packet.size ? capacity : _packet.size;
+#else
+	return _packet.size;
+#endif
+}
+
 void Frame::refData( unsigned char* buffer, const size_t size )
 {
 	_packet.data = buffer;
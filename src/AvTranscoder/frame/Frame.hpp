@@ -31,11 +31,16 @@ public:
 	Frame& operator=( const Frame& other );
 
 	/// Free buffer of data
-	~Frame();
+	/// @note Virtual: the frames are deleted and cast from Frame* (VideoFrame, AudioFrame)
+	virtual ~Frame();
 
 	/// Resize data buffer
+	/// @note The buffer is reallocated only if the new size is larger than its capacity: the data is not moved when a frame shrinks and grows again.
 	void resize( const size_t newSize );
 
+	/// Size of the allocated buffer, which the data can reach without reallocation
+	size_t getCapacity() const;
+
 	///@{
 	/// Ref to external data buffer
 	void refData( Frame& frame );
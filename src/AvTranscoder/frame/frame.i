@@ -6,6 +6,345 @@
 #include <AvTranscoder/frame/AudioFrame.hpp>
 %}
 
+#if SWIGPYTHON
+%{
+extern "C" {
+#include <libavutil/pixdesc.h>
+#include <libavutil/imgutils.h>
+}
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+namespace
+{
+
+/**
+ * @brief Layout of data viewed as a numpy array.
+ */
+struct ArrayLayout
+{
+	std::vector< size_t > _shape;
+	std::vector< size_t > _strides;  ///< In bytes, for each dimension of the shape
+	size_t _offset;  ///< Position of the first element in the data of the frame, in bytes
+	std::string _typeString;  ///< numpy type string of an element
+};
+
+/// Returns the numpy type string of an element of the given kind ('u', 'i' or 'f') and size (in bytes)
+std::string getArrayTypeString( const char kind, const size_t size, const bool isBigEndian )
+{
+	std::string typeString( 1, size == 1 ? '|' : ( isBigEndian ? '>' : '<' ) );
+	typeString += kind;
+	typeString += static_cast<char>( '0' + size );
+	return typeString;
+}
+
+bool isNativeBigEndian()
+{
+	const unsigned short one = 1;
+	return *reinterpret_cast<const unsigned char*>( &one ) == 0;
+}
+
+/// Set the layout of the given number of bytes
+void setBytesLayout( const size_t size, ArrayLayout& layout )
+{
+	layout._shape.assign( 1, size );
+	layout._strides.assign( 1, 1 );
+	layout._offset = 0;
+	layout._typeString = "|u1";
+}
+
+/**
+ * @brief Get the layout of a plane of a video frame: (height, width) or (height, width, elements) if the plane has several components.
+ * @return false if the components of the plane are not bytes or words, at the same step (bitstream, palette, yuyv422...)
+ */
+bool getVideoPlaneLayout( avtranscoder::VideoFrame& frame, const size_t plane, ArrayLayout& layout )
+{
+	const avtranscoder::VideoFrameDesc& desc = frame.desc();
+	const AVPixFmtDescriptor* pixFmtDesc = av_pix_fmt_desc_get( desc.getPixelFormat() );
+	if( ! pixFmtDesc || ( pixFmtDesc->flags & ( AV_PIX_FMT_FLAG_PAL | AV_PIX_FMT_FLAG_BITSTREAM | AV_PIX_FMT_FLAG_HWACCEL ) ) || plane >= 4 )
+		return false;
+
+	// lines and planes of the frame (allocated without padding, see VideoFrameDesc::getDataSize)
+	int linesizes[4];
+	uint8_t* planes[4];
+	if( av_image_fill_linesizes( linesizes, desc.getPixelFormat(), desc.getWidth() ) < 0 )
+		return false;
+	const int dataSize = av_image_fill_pointers( planes, desc.getPixelFormat(), desc.getHeight(), frame.getData(), linesizes );
+	if( dataSize < 0 || (size_t)dataSize > frame.getSize() || linesizes[plane] <= 0 )
+		return false;
+
+	// the components of the plane have the same size and step
+	size_t componentSize = 0;
+	size_t step = 0;
+	for( size_t component = 0; component < pixFmtDesc->nb_components; ++component )
+	{
+		const AVComponentDescriptor& componentDesc = pixFmtDesc->comp[component];
+		if( componentDesc.plane != plane )
+			continue;
+		const size_t size = ( componentDesc.depth_minus1 + 8 ) / 8;
+		if( ( componentSize && size != componentSize ) || ( step && step != (size_t)componentDesc.step_minus1 + 1 ) )
+			return false;
+		componentSize = size;
+		step = componentDesc.step_minus1 + 1;
+	}
+	if( ( componentSize != 1 && componentSize != 2 ) || step % componentSize || linesizes[plane] % step )
+		return false;
+
+	// the chroma planes are subsampled
+	const size_t height = ( plane == 1 || plane == 2 ) ? -( ( -(int)desc.getHeight() ) >> pixFmtDesc->log2_chroma_h ) : desc.getHeight();
+	layout._shape.clear();
+	layout._shape.push_back( height );
+	layout._shape.push_back( linesizes[plane] / step );
+	layout._strides.clear();
+	layout._strides.push_back( linesizes[plane] );
+	layout._strides.push_back( step );
+	if( step > componentSize )
+	{
+		layout._shape.push_back( step / componentSize );
+		layout._strides.push_back( componentSize );
+	}
+	layout._offset = planes[plane] - frame.getData();
+	layout._typeString = getArrayTypeString( 'u', componentSize, pixFmtDesc->flags & AV_PIX_FMT_FLAG_BE );
+	return true;
+}
+
+/// Returns the number of planes of the video frame
+size_t getNbVideoPlanes( avtranscoder::VideoFrame& frame )
+{
+	const AVPixFmtDescriptor* pixFmtDesc = av_pix_fmt_desc_get( frame.desc().getPixelFormat() );
+	if( ! pixFmtDesc )
+		return 0;
+	size_t nbPlanes = 0;
+	for( size_t component = 0; component < pixFmtDesc->nb_components; ++component )
+	{
+		if( (size_t)pixFmtDesc->comp[component].plane + 1 > nbPlanes )
+			nbPlanes = pixFmtDesc->comp[component].plane + 1;
+	}
+	return nbPlanes;
+}
+
+/**
+ * @brief Get the layout of a channel of a planar audio frame, or of all the channels of an interleaved audio frame (see getFrameLayout).
+ * @return false if the samples are not viewed as numbers
+ */
+bool getAudioPlaneLayout( avtranscoder::AudioFrame& frame, const size_t plane, ArrayLayout& layout )
+{
+	const AVSampleFormat sampleFormat = frame.desc().getSampleFormat();
+	const size_t nbChannels = frame.desc().getChannels();
+	const int sampleSize = av_get_bytes_per_sample( sampleFormat );
+	if( sampleSize <= 0 || ! nbChannels || frame.getSize() % ( sampleSize * nbChannels ) )
+		return false;
+
+	char kind = 0;
+	switch( av_get_packed_sample_fmt( sampleFormat ) )
+	{
+		case AV_SAMPLE_FMT_U8:
+			kind = 'u';
+			break;
+		case AV_SAMPLE_FMT_S16:
+		case AV_SAMPLE_FMT_S32:
+			kind = 'i';
+			break;
+		case AV_SAMPLE_FMT_FLT:
+		case AV_SAMPLE_FMT_DBL:
+			kind = 'f';
+			break;
+		default:
+			return false;
+	}
+
+	const size_t nbSamples = frame.getSize() / ( sampleSize * nbChannels );
+	const bool isPlanar = av_sample_fmt_is_planar( sampleFormat );
+	if( plane >= ( isPlanar ? nbChannels : 1 ) )
+		return false;
+
+	layout._shape.assign( 1, nbSamples );
+	layout._strides.assign( 1, isPlanar ? sampleSize : sampleSize * nbChannels );
+	if( ! isPlanar )
+	{
+		layout._shape.push_back( nbChannels );
+		layout._strides.push_back( sampleSize );
+	}
+	layout._offset = plane * nbSamples * sampleSize;
+	layout._typeString = getArrayTypeString( kind, sampleSize, isNativeBigEndian() );
+	return true;
+}
+
+/**
+ * @brief Get the layout of the data of the frame.
+ * @note Video with one plane is viewed as (height, width, components), with several planes of the same size as (planes, height, width),
+ * audio as (samples, channels) or (channels, samples) if planar.
+ * Other data (subsampled planes, coded data...) is viewed as bytes: see getPlaneLayout.
+ */
+void getFrameLayout( avtranscoder::Frame& frame, ArrayLayout& layout )
+{
+	setBytesLayout( frame.getSize(), layout );
+
+	avtranscoder::VideoFrame* videoFrame = dynamic_cast<avtranscoder::VideoFrame*>( &frame );
+	if( videoFrame )
+	{
+		const size_t nbPlanes = getNbVideoPlanes( *videoFrame );
+		ArrayLayout firstPlaneLayout;
+		if( ! nbPlanes || ! getVideoPlaneLayout( *videoFrame, 0, firstPlaneLayout ) )
+			return;
+		if( nbPlanes == 1 )
+		{
+			layout = firstPlaneLayout;
+			return;
+		}
+
+		// planes of one component, of the same size, one after the other
+		if( firstPlaneLayout._shape.size() != 2 )
+			return;
+		const size_t planeStride = firstPlaneLayout._strides.at( 0 ) * firstPlaneLayout._shape.at( 0 );
+		for( size_t plane = 1; plane < nbPlanes; ++plane )
+		{
+			ArrayLayout planeLayout;
+			if( ! getVideoPlaneLayout( *videoFrame, plane, planeLayout ) || planeLayout._shape != firstPlaneLayout._shape ||
+				planeLayout._strides != firstPlaneLayout._strides || planeLayout._offset != firstPlaneLayout._offset + plane * planeStride )
+				return;
+		}
+		layout = firstPlaneLayout;
+		layout._shape.insert( layout._shape.begin(), nbPlanes );
+		layout._strides.insert( layout._strides.begin(), planeStride );
+		return;
+	}
+
+	avtranscoder::AudioFrame* audioFrame = dynamic_cast<avtranscoder::AudioFrame*>( &frame );
+	if( audioFrame )
+	{
+		ArrayLayout channelLayout;
+		if( ! getAudioPlaneLayout( *audioFrame, 0, channelLayout ) )
+			return;
+		layout = channelLayout;
+		if( av_sample_fmt_is_planar( audioFrame->desc().getSampleFormat() ) )
+		{
+			layout._shape.insert( layout._shape.begin(), audioFrame->desc().getChannels() );
+			layout._strides.insert( layout._strides.begin(), channelLayout._shape.at( 0 ) * channelLayout._strides.at( 0 ) );
+		}
+	}
+}
+
+/**
+ * @brief Get the layout of a plane of the frame: a plane of a video frame, a channel of a planar audio frame, or all the data.
+ * @exception throw std::out_of_range if the frame has no such plane
+ */
+void getPlaneLayout( avtranscoder::Frame& frame, const size_t plane, ArrayLayout& layout )
+{
+	avtranscoder::VideoFrame* videoFrame = dynamic_cast<avtranscoder::VideoFrame*>( &frame );
+	avtranscoder::AudioFrame* audioFrame = dynamic_cast<avtranscoder::AudioFrame*>( &frame );
+	if( videoFrame && plane < getNbVideoPlanes( *videoFrame ) )
+	{
+		if( ! getVideoPlaneLayout( *videoFrame, plane, layout ) )
+			throw std::out_of_range( "the plane of the video frame can't be viewed as an array" );
+	}
+	else if( audioFrame )
+	{
+		if( ! getAudioPlaneLayout( *audioFrame, plane, layout ) )
+			throw std::out_of_range( "no such channel in the audio frame" );
+	}
+	else if( ! videoFrame && plane == 0 )
+		setBytesLayout( frame.getSize(), layout );
+	else
+		throw std::out_of_range( "no such plane in the frame" );
+}
+
+/// Data of the views of empty frames (a view can't point to NULL)
+char emptyFrameData = 0;
+
+/// Returns the numpy array interface of the given layout of the data of the frame
+PyObject* getArrayInterface( avtranscoder::Frame& frame, const ArrayLayout& layout )
+{
+	PyObject* pyShape = PyTuple_New( layout._shape.size() );
+	PyObject* pyStrides = PyTuple_New( layout._strides.size() );
+	for( size_t i = 0; i < layout._shape.size(); ++i )
+	{
+		PyTuple_SET_ITEM( pyShape, i, PyLong_FromSize_t( layout._shape.at( i ) ) );
+		PyTuple_SET_ITEM( pyStrides, i, PyLong_FromSize_t( layout._strides.at( i ) ) );
+	}
+
+	char* data = frame.getData() ? reinterpret_cast<char*>( frame.getData() ) + layout._offset : &emptyFrameData;
+	return Py_BuildValue( "{s:N,s:N,s:s,s:(N,O),s:i}",
+		"shape", pyShape,
+		"strides", pyStrides,
+		"typestr", layout._typeString.c_str(),
+		"data", PyLong_FromVoidPtr( data ), Py_False,
+		"version", 3 );
+}
+
+}
+%}
+
+%extend avtranscoder::Frame
+{
+	/**
+	 * @brief Returns a writable memoryview on the data of the frame, without copy.
+	 * @warning The view does not keep a reference to the frame: it is valid while the frame exists and is not resized.
+	 * Prefer numpy.asarray( frame ), which keeps a reference to the frame (see also reader.i for the frames of the readers).
+	 */
+	PyObject* getDataView()
+	{
+		char* data = $self->getData() ? reinterpret_cast<char*>( $self->getData() ) : &emptyFrameData;
+#if PY_VERSION_HEX >= 0x03030000
+		return PyMemoryView_FromMemory( data, $self->getSize(), PyBUF_WRITE );
+#else
+		return PyBuffer_FromReadWriteMemory( data, $self->getSize() );
+#endif
+	}
+
+	/**
+	 * @brief Returns the numpy array interface of the data of the frame, with its shape and strides (see getFrameLayout).
+	 */
+	PyObject* getArrayInterface()
+	{
+		ArrayLayout layout;
+		getFrameLayout( *$self, layout );
+		return getArrayInterface( *$self, layout );
+	}
+
+	/**
+	 * @brief Returns the numpy array interface of the given plane of the frame (see getPlaneLayout).
+	 */
+	PyObject* getPlaneArrayInterface( const size_t plane )
+	{
+		ArrayLayout layout;
+		getPlaneLayout( *$self, plane, layout );
+		return getArrayInterface( *$self, layout );
+	}
+
+	%pythoncode
+	%{
+		# numpy.asarray( frame ) views the data of the frame without copy, and keeps a reference to the frame
+		__array_interface__ = property( getArrayInterface )
+
+		def getPlanes( self ):
+			"""
+			Returns the planes of the frame (the subsampled planes of a video frame, the channels of a planar audio frame...):
+			numpy.asarray( plane ) views the data of the plane without copy, and keeps a reference to the frame.
+			"""
+			planes = []
+			while True:
+				try:
+					planes.append( FramePlane( self, len(planes) ) )
+				except IndexError:
+					return planes
+	%}
+}
+
+%pythoncode
+%{
+class FramePlane( object ):
+	"""
+	A plane of the data of a frame, viewed by numpy.asarray( plane ) without copy.
+	"""
+	def __init__( self, frame, plane ):
+		self.__array_interface__ = frame.getPlaneArrayInterface( plane )
+		self._frame = frame
+%}
+#endif
+
 %include <AvTranscoder/frame/Frame.hpp>
 %include <AvTranscoder/frame/VideoFrame.hpp>
 %include <AvTranscoder/frame/AudioFrame.hpp>
@@ -1,32 +1,239 @@
 #include "log.hpp"
 
+#include <AvTranscoder/thread.hpp>
+
+#include <cstdio>
+#include <cstring>
+
 namespace avtranscoder
 {
 
 std::string Logger::logHeaderMessage = "";
+int Logger::_logLevel = AV_LOG_INFO;
 
-void callbackToWriteInFile( void *ptr, int level, const char *fmt, va_list vl )
+namespace
 {
-	std::ofstream outputFile;
-	outputFile.open( LOG_FILE, std::ios::out | std::ios::app );
 
+/// Maximum size of a line of log (same as the default callback of ffmpeg/libav)
+const size_t maxLineSize = 1024;
+
+void formatLine( void* ptr, int level, const char* fmt, va_list vl, char* line )
+{
 #ifdef AVTRANSCODER_FFMPEG_DEPENDENCY
 	// Format a line of log the same way as the default callback
-	char line[1024];
 	static int print_prefix = 1;
-	av_log_format_line(ptr, level, fmt, vl, line, sizeof(line), &print_prefix); //only available with ffmpeg
-	outputFile << line;
+	av_log_format_line( ptr, level, fmt, vl, line, maxLineSize, &print_prefix ); //only available with ffmpeg
 #else
-	outputFile << "Warning: currently can't log in file with avtranscoder when depending on libav" << std::endl;
+	vsnprintf( line, maxLineSize, fmt, vl );
 #endif
+}
+
+/**
+ * @brief Write the log messages in a file from a background thread.
+ * The messages are pushed in a bounded lock-free ring buffer (multiple producers / single consumer),
+ * so logging never blocks the caller: if the buffer is full the message is dropped.
+ * @see Dmitry Vyukov's bounded MPMC queue
+ */
+class AsyncLogSink
+{
+public:
+	AsyncLogSink()
+		: _slots( NULL )
+		, _enqueuePosition( 0 )
+		, _dequeuePosition( 0 )
+		, _writtenPosition( 0 )
+		, _nbDroppedLogs( 0 )
+		, _isRunning( 0 )
+	{}
+
+	~AsyncLogSink()
+	{
+		if( _thread.isRunning() )
+			av_log_set_callback( av_log_default_callback );
+		stop();
+		delete[] _slots;
+	}
+
+	/**
+	 * @brief Start the background thread which writes in the given file (its content is removed).
+	 */
+	void start( const std::string& filename )
+	{
+		stop();
+
+		// The buffer is kept between two starts: a message could be pushed at the same time
+		if( ! _slots )
+		{
+			_slots = new Slot[nbSlots];
+			for( size_t i = 0; i < nbSlots; ++i )
+				_slots[i]._sequence.store( i );
+		}
+
+		_outputFile.open( filename.c_str(), std::ios::out | std::ios::trunc );
+		_isRunning.store( 1 );
+		_thread.start( &AsyncLogSink::run, this );
+	}
+
+	/**
+	 * @brief Write the remaining messages, and stop the background thread.
+	 * @note The file keeps its content.
+	 */
+	void stop()
+	{
+		if( ! _thread.isRunning() )
+			return;
+		_isRunning.store( 0 );
+		_thread.join();
+		_outputFile.close();
+	}
+
+	bool isRunning() const { return _thread.isRunning(); }
+
+	/**
+	 * @brief Wait until the messages pushed before the call are written in the file.
+	 */
+	void flush()
+	{
+		const unsigned long position = _enqueuePosition.load();
+		while( _thread.isRunning() && (long)( (unsigned long)_writtenPosition.load() - position ) < 0 )
+			Thread::sleep( 1 );
+	}
+
+	/**
+	 * @return If the message has been pushed (false if the buffer is full).
+	 */
+	bool push( const char* line )
+	{
+		Slot* slot = NULL;
+		unsigned long position = _enqueuePosition.load();
+		while( true )
+		{
+			slot = &_slots[ position & ( nbSlots - 1 ) ];
+			const long diff = (long)( (unsigned long)slot->_sequence.load() - position );
+			if( diff == 0 )
+			{
+				if( _enqueuePosition.compareAndSwap( position, position + 1 ) )
+					break;
+				position = _enqueuePosition.load();
+			}
+			else if( diff < 0 )
+			{
+				_nbDroppedLogs.fetchAdd( 1 );
+				return false;
+			}
+			else
+				position = _enqueuePosition.load();
+		}
+
+		strncpy( slot->_line, line, maxLineSize - 1 );
+		slot->_line[maxLineSize - 1] = '\0';
+		slot->_sequence.store( position + 1 );
+		return true;
+	}
 
+	size_t getNbDroppedLogs() const { return _nbDroppedLogs.load(); }
+
+private:
+	/**
+	 * @return If a message has been popped (false if the buffer is empty).
+	 */
+	bool pop( char* line )
+	{
+		// Only the background thread pops the messages
+		const unsigned long position = _dequeuePosition.load();
+		Slot& slot = _slots[ position & ( nbSlots - 1 ) ];
+		if( (long)( (unsigned long)slot._sequence.load() - ( position + 1 ) ) < 0 )
+			return false;
+		_dequeuePosition.store( position + 1 );
+
+		strcpy( line, slot._line );
+		slot._sequence.store( position + nbSlots );
+		return true;
+	}
+
+	static void run( void* sink )
+	{
+		AsyncLogSink* self = static_cast<AsyncLogSink*>( sink );
+		char line[maxLineSize];
+		while( true )
+		{
+			// Read the flag before popping, so no message pushed before stop is lost
+			const bool isRunning = self->_isRunning.load();
+			bool isEmpty = true;
+			while( self->pop( line ) )
+			{
+				self->_outputFile << line;
+				isEmpty = false;
+			}
+			if( ! isEmpty )
+			{
+				self->_outputFile.flush();
+				self->_writtenPosition.store( self->_dequeuePosition.load() );
+			}
+			if( ! isRunning )
+				break;
+			if( isEmpty )
+				Thread::sleep( 10 );
+		}
+	}
+
+private:
+	/// Number of messages in the ring buffer (a power of 2)
+	static const size_t nbSlots = 4096;
+
+	struct Slot
+	{
+		AtomicInt _sequence;  ///< Position at which the slot can be pushed (if equal) or popped (if equal + 1)
+		char _line[maxLineSize];
+	};
+
+	Slot* _slots;  ///< Ring buffer of nbSlots messages (has ownership)
+	AtomicInt _enqueuePosition;
+	AtomicInt _dequeuePosition;
+	AtomicInt _writtenPosition;  ///< Position of the messages written and flushed in the file
+	AtomicInt _nbDroppedLogs;
+	AtomicInt _isRunning;
+
+	std::ofstream _outputFile;  ///< Only written by the background thread
+	Thread _thread;
+};
+
+AsyncLogSink asyncLogSink;
+Mutex logInFileMutex;  ///< Protect the switch between the logging modes
+
+}
+
+void callbackToWriteInFile( void *ptr, int level, const char *fmt, va_list vl )
+{
+	// A custom callback is called whatever the log level
+	if( level > av_log_get_level() )
+		return;
+
+	char line[maxLineSize];
+	formatLine( ptr, level, fmt, vl, line );
+
+	std::ofstream outputFile;
+	outputFile.open( LOG_FILE, std::ios::out | std::ios::app );
+	outputFile << line;
 	outputFile.close();
 }
 
+void callbackToWriteInAsyncSink( void *ptr, int level, const char *fmt, va_list vl )
+{
+	// A custom callback is called whatever the log level
+	if( level > av_log_get_level() )
+		return;
+
+	char line[maxLineSize];
+	formatLine( ptr, level, fmt, vl, line );
+	asyncLogSink.push( line );
+}
+
 void Logger::setLogLevel( const int level )
 {
 	// set ffmpeg log level
 	av_log_set_level( level );
+	Logger::_logLevel = level;
 
 	// set avtranscoder header message
 	std::string levelStr;
@@ -52,20 +259,50 @@ void Logger::setLogLevel( const int level )
 
 void Logger::log( const int level, const std::string& msg )
 {
+	if( ! isEnabled( level ) )
+		return;
+
 	std::string logMessage = Logger::logHeaderMessage;
 	logMessage += msg;
 	logMessage += "\n";
 	av_log( NULL, level, logMessage.c_str() );
 }
 
-void Logger::logInFile()
+void Logger::logInFile( const bool async )
 {
+	ScopedLock lock( logInFileMutex );
+
+	if( async )
+	{
+		// the sink cleans the log file
+		asyncLogSink.start( LOG_FILE );
+		av_log_set_callback( callbackToWriteInAsyncSink );
+		return;
+	}
+
 	av_log_set_callback( callbackToWriteInFile );
 
+	// from the asynchronous mode: write the remaining messages, and keep logging in the same file
+	if( asyncLogSink.isRunning() )
+	{
+		asyncLogSink.stop();
+		return;
+	}
+
 	// clean log file
 	std::ofstream outputFile;
 	outputFile.open( LOG_FILE );
 	outputFile.close();
 }
 
+void Logger::flush()
+{
+	asyncLogSink.flush();
+}
+
+size_t Logger::getNbDroppedLogs()
+{
+	return asyncLogSink.getNbDroppedLogs();
+}
+
 }
@@ -14,10 +14,21 @@ namespace avtranscoder
 {
 
 #define LOG_FILE "avtranscoder.log"
-#define LOG_DEBUG( ... ) { std::stringstream os; os << __VA_ARGS__; Logger::log( AV_LOG_DEBUG, os.str() ); }
-#define LOG_INFO( ... ) { std::stringstream os; os << __VA_ARGS__; Logger::log( AV_LOG_INFO, os.str() ); }
-#define LOG_WARN( ... ) { std::stringstream os; os << __VA_ARGS__; Logger::log( AV_LOG_WARNING, os.str() ); }
-#define LOG_ERROR( ... ) { std::stringstream os; os << __VA_ARGS__; Logger::log( AV_LOG_ERROR, os.str() ); }
+
+/**
+ * The message is formatted only if its level is enabled.
+ * Define AVTRANSCODER_DISABLE_DEBUG_LOG to remove the debug messages at compile time.
+ */
+#define LOG_LEVEL( level, ... ) { if( Logger::isEnabled( level ) ) { std::stringstream os; os << __VA_ARGS__; Logger::log( level, os.str() ); } }
+#ifdef AVTRANSCODER_DISABLE_DEBUG_LOG
+ // still compiled (no unused variables) but removed as dead code
+ #define LOG_DEBUG( ... ) { if( false ) { std::stringstream os; os << __VA_ARGS__; } }
+#else
+ #define LOG_DEBUG( ... ) LOG_LEVEL( AV_LOG_DEBUG, __VA_ARGS__ )
+#endif
+#define LOG_INFO( ... ) LOG_LEVEL( AV_LOG_INFO, __VA_ARGS__ )
+#define LOG_WARN( ... ) LOG_LEVEL( AV_LOG_WARNING, __VA_ARGS__ )
+#define LOG_ERROR( ... ) LOG_LEVEL( AV_LOG_ERROR, __VA_ARGS__ )
 
 /// Logger class which contains static functions to use ffmpeg/libav log system
 class AvExport Logger
@@ -31,22 +42,46 @@ public:
 	 */
 	static void setLogLevel( const int level );
 
+	/**
+	 * @return If a message of the given level would be logged.
+	 * @note Cheap enough to be checked before formatting a message in the hot paths.
+	 */
+	static bool isEnabled( const int level ) { return level <= _logLevel; }
+
 	/**
 	 * @brief Log with the ffmpeg/libav log system
 	 * @note you can use macro LOG_* to log at DEBUG/INFO/WARN/ERROR level
 	 * @param msg: the message will be prefixed by '[avTranscoder - <level>]'
 	 * @param msg: the message will be suffixed by '\n'
+	 * @note Nothing is done if the level is not enabled.
 	 */
 	static void log( const int level, const std::string& msg );
 
 	/**
 	 * @brief Log ffmpeg/libav and avtranscoder informations in a text file.
+	 * @param async: if true, the messages are pushed in a bounded ring buffer and written by a background thread,
+	 * so the transcoding threads never wait for the file.
+	 * When the buffer is full the new messages are dropped (see getNbDroppedLogs).
 	 * @note log filename is avtranscoder.log
+	 * @note The log file is cleaned, except when switching from the asynchronous mode to the synchronous one:
+	 * then the remaining messages are written and the next ones are appended.
+	 */
+	static void logInFile( const bool async = false );
+
+	/**
+	 * @brief Wait until the messages logged before the call are written in the log file.
+	 * @note Only needed in the asynchronous mode (see logInFile).
+	 */
+	static void flush();
+
+	/**
+	 * @return Number of messages dropped because the buffer of the asynchronous logging was full.
 	 */
-	static void logInFile();
+	static size_t getNbDroppedLogs();
 
 private:
 	static std::string logHeaderMessage;  ///< First caracters present for each logging message
+	static int _logLevel;  ///< Current log level (same as the one of ffmpeg/libav)
 };
 
 }
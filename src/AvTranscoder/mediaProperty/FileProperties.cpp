@@ -1,6 +1,13 @@
 #include "FileProperties.hpp"
 
+#include <AvTranscoder/file/ProbeCache.hpp>
 #include <AvTranscoder/progress/NoDisplayProgress.hpp>
+#include <AvTranscoder/stat/ContentDetector.hpp>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
 
 #include <stdexcept>
 #include <sstream>
@@ -8,6 +15,66 @@
 namespace avtranscoder
 {
 
+namespace
+{
+
+/// Detectors of the content of the streams of a file, and their decoded frame, released even if the analysis throws
+class ContentDetectors
+{
+private:
+	ContentDetectors( const ContentDetectors& detectors );
+	ContentDetectors& operator=( const ContentDetectors& detectors );
+
+public:
+	ContentDetectors( AVFormatContext& formatContext )
+		: _videoDetectors()
+		, _audioDetectors()
+		, _avFrame( NULL )
+		, _formatContext( formatContext )
+	{
+#if LIBAVCODEC_VERSION_MAJOR > 54
+		_avFrame = av_frame_alloc();
+#else
+		_avFrame = avcodec_alloc_frame();
+#endif
+	}
+
+	~ContentDetectors()
+	{
+		// the decoders are left opened, like the decoder of the GOP analysis
+		for( std::map< size_t, VideoContentDetector* >::iterator it = _videoDetectors.begin(); it != _videoDetectors.end(); ++it )
+		{
+			avcodec_flush_buffers( _formatContext.streams[it->first]->codec );
+			delete it->second;
+		}
+		for( std::map< size_t, AudioContentDetector* >::iterator it = _audioDetectors.begin(); it != _audioDetectors.end(); ++it )
+		{
+			avcodec_flush_buffers( _formatContext.streams[it->first]->codec );
+			delete it->second;
+		}
+
+#if LIBAVCODEC_VERSION_MAJOR > 54
+		av_frame_free( &_avFrame );
+#else
+#if LIBAVCODEC_VERSION_MAJOR > 53
+		avcodec_free_frame( &_avFrame );
+#else
+		av_free( _avFrame );
+#endif
+#endif
+	}
+
+public:
+	std::map< size_t, VideoContentDetector* > _videoDetectors;  ///< Detectors per video stream index (has ownership)
+	std::map< size_t, AudioContentDetector* > _audioDetectors;  ///< Detectors per audio stream index (has ownership)
+	AVFrame* _avFrame;  ///< Frame decoded by all the streams (has ownership)
+
+private:
+	AVFormatContext& _formatContext;  ///< Has link (no ownership)
+};
+
+}
+
 FileProperties::FileProperties( const FormatContext& formatContext )
 	: _formatContext( &formatContext )
 	, _avFormatContext( &formatContext.getAVFormatContext() )
@@ -17,6 +84,11 @@ FileProperties::FileProperties( const FormatContext& formatContext )
 	, _subtitleStreams()
 	, _attachementStreams()
 	, _unknownStreams()
+	, _metadatas()
+	, _blackSegments()
+	, _freezeSegments()
+	, _silenceSegments()
+	, _cachedProperties( NULL )
 {
 	if( _avFormatContext )
 		detail::fillMetadataDictionnary( _avFormatContext->metadata, _metadatas );
@@ -25,6 +97,48 @@ FileProperties::FileProperties( const FormatContext& formatContext )
 	extractStreamProperties( progress, eAnalyseLevelHeader );
 }
 
+FileProperties::FileProperties( const FileProperties& properties )
+	: _cachedProperties( NULL )
+{
+	*this = properties;
+}
+
+FileProperties& FileProperties::operator=( const FileProperties& properties )
+{
+	if( &properties == this )
+		return *this;
+
+	// acquire the entry of the cache before releasing the previous one, which could be the same
+	const FileProperties& cachedProperties = properties._cachedProperties ? *properties._cachedProperties : properties;
+	const FileProperties* previousCachedProperties = _cachedProperties;
+	_cachedProperties = ProbeCache::acquireProperties( cachedProperties ) ? &cachedProperties : NULL;
+	if( previousCachedProperties )
+		ProbeCache::releaseProperties( *previousCachedProperties );
+
+	_formatContext = properties._formatContext;
+	_avFormatContext = properties._avFormatContext;
+	_videoStreams = properties._videoStreams;
+	_audioStreams = properties._audioStreams;
+	_dataStreams = properties._dataStreams;
+	_subtitleStreams = properties._subtitleStreams;
+	_attachementStreams = properties._attachementStreams;
+	_unknownStreams = properties._unknownStreams;
+	_metadatas = properties._metadatas;
+	_blackSegments = properties._blackSegments;
+	_freezeSegments = properties._freezeSegments;
+	_silenceSegments = properties._silenceSegments;
+
+	// the map refers to the properties of this copy
+	mapStreamProperties();
+	return *this;
+}
+
+FileProperties::~FileProperties()
+{
+	if( _cachedProperties )
+		ProbeCache::releaseProperties( *_cachedProperties );
+}
+
 void FileProperties::extractStreamProperties( IProgress& progress, const EAnalyseLevel level )
 {
 	clearStreamProperties();
@@ -81,40 +195,12 @@ void FileProperties::extractStreamProperties( IProgress& progress, const EAnalys
 	}
 
 	// once the streams vectors are filled, add their references the base streams vector
-	for( size_t streamIndex = 0; streamIndex < _videoStreams.size(); ++streamIndex )
-	{
-		const size_t videoStreamIndex = _videoStreams.at( streamIndex ).getStreamIndex();
-		_streams[ videoStreamIndex ] = &_videoStreams.at( streamIndex );
-	}
-
-	for( size_t streamIndex = 0; streamIndex < _audioStreams.size(); ++ streamIndex )
-	{
-		const size_t audioStreamIndex = _audioStreams.at( streamIndex ).getStreamIndex();
-		_streams[ audioStreamIndex ] = &_audioStreams.at(streamIndex);
-	}
+	mapStreamProperties();
 
-	for( size_t streamIndex = 0; streamIndex < _dataStreams.size(); ++ streamIndex )
-	{
-		const size_t dataStreamIndex = _dataStreams.at( streamIndex ).getStreamIndex();
-		_streams[ dataStreamIndex ] = &_dataStreams.at(streamIndex);
-	}
-
-	for( size_t streamIndex = 0; streamIndex < _subtitleStreams.size(); ++ streamIndex )
-	{
-		const size_t subtitleStreamIndex = _subtitleStreams.at( streamIndex ).getStreamIndex();
-		_streams[ subtitleStreamIndex ] = &_subtitleStreams.at(streamIndex);
-	}
-
-	for( size_t streamIndex = 0; streamIndex < _attachementStreams.size(); ++ streamIndex )
-	{
-		const size_t attachementStreamIndex = _attachementStreams.at( streamIndex ).getStreamIndex();
-		_streams[ attachementStreamIndex ] = &_attachementStreams.at(streamIndex);
-	}
-
-	for( size_t streamIndex = 0; streamIndex < _unknownStreams.size(); ++ streamIndex )
+	if( level >= eAnalyseLevelFull )
 	{
-		const size_t unknownStreamIndex = _unknownStreams.at( streamIndex ).getStreamIndex();
-		_streams[ unknownStreamIndex ] = &_unknownStreams.at(streamIndex);
+		const_cast<FormatContext*>( _formatContext )->seek( 0, AVSEEK_FLAG_BACKWARD );
+		detectContent( progress );
 	}
 
 	// if the analysis level has decoded some streams parts, return at the beginning
@@ -206,6 +292,181 @@ size_t FileProperties::getNbStreams() const
 	return _avFormatContext->nb_streams;
 }
 
+namespace
+{
+
+std::vector< DetectedSegment > getSegments( const std::map< size_t, std::vector< DetectedSegment > >& segments, const size_t streamIndex )
+{
+	std::map< size_t, std::vector< DetectedSegment > >::const_iterator it = segments.find( streamIndex );
+	return it != segments.end() ? it->second : std::vector< DetectedSegment >();
+}
+
+/**
+ * @brief Open the decoder of the stream, if it is not opened by a previous analysis.
+ */
+bool openDecoder( AVCodecContext& codecContext )
+{
+	if( avcodec_is_open( &codecContext ) )
+		return true;
+	AVCodec* codec = avcodec_find_decoder( codecContext.codec_id );
+	return codec && avcodec_open2( &codecContext, codec, NULL ) >= 0;
+}
+
+}
+
+std::vector< DetectedSegment > FileProperties::getBlackSegments( const size_t streamIndex ) const
+{
+	return getSegments( _blackSegments, streamIndex );
+}
+
+std::vector< DetectedSegment > FileProperties::getFreezeSegments( const size_t streamIndex ) const
+{
+	return getSegments( _freezeSegments, streamIndex );
+}
+
+std::vector< DetectedSegment > FileProperties::getSilenceSegments( const size_t streamIndex ) const
+{
+	return getSegments( _silenceSegments, streamIndex );
+}
+
+void FileProperties::detectContent( IProgress& progress )
+{
+	AVFormatContext& formatContext = const_cast<AVFormatContext&>( *_avFormatContext );
+
+	ContentDetectors detectors( formatContext );
+	std::map< size_t, VideoContentDetector* >& videoDetectors = detectors._videoDetectors;
+	std::map< size_t, AudioContentDetector* >& audioDetectors = detectors._audioDetectors;
+	for( size_t i = 0; i < _videoStreams.size(); ++i )
+	{
+		const size_t streamIndex = _videoStreams.at( i ).getStreamIndex();
+		AVCodecContext& codecContext = *formatContext.streams[streamIndex]->codec;
+		if( ! openDecoder( codecContext ) )
+		{
+			LOG_WARN( "Unable to decode the video stream at index " << streamIndex << " to detect its content" )
+			continue;
+		}
+		avcodec_flush_buffers( &codecContext );
+		const VideoFrameDesc frameDesc( codecContext.width, codecContext.height, codecContext.pix_fmt );
+		videoDetectors[streamIndex] = new VideoContentDetector( frameDesc, _videoStreams.at( i ).getFps() );
+	}
+	for( size_t i = 0; i < _audioStreams.size(); ++i )
+	{
+		const size_t streamIndex = _audioStreams.at( i ).getStreamIndex();
+		AVCodecContext& codecContext = *formatContext.streams[streamIndex]->codec;
+		if( ! openDecoder( codecContext ) )
+		{
+			LOG_WARN( "Unable to decode the audio stream at index " << streamIndex << " to detect its content" )
+			continue;
+		}
+		avcodec_flush_buffers( &codecContext );
+		const AudioFrameDesc frameDesc( codecContext.sample_rate, codecContext.channels, codecContext.sample_fmt );
+		audioDetectors[streamIndex] = new AudioContentDetector( frameDesc );
+	}
+
+	AVFrame* avFrame = detectors._avFrame;
+	Frame frame;
+	const double duration = getDuration();
+
+	// read the file once for all the streams, and flush the delayed frames at the end of the file
+	AVPacket packet;
+	av_init_packet( &packet );
+	bool isEndOfFile = false;
+	bool stopAnalyse = false;
+	while( ! stopAnalyse && ! isEndOfFile )
+	{
+		isEndOfFile = av_read_frame( &formatContext, &packet ) < 0;
+
+		std::vector< size_t > streamIndexes;
+		if( ! isEndOfFile )
+			streamIndexes.push_back( packet.stream_index );
+		else
+		{
+			for( std::map< size_t, VideoContentDetector* >::iterator it = videoDetectors.begin(); it != videoDetectors.end(); ++it )
+				streamIndexes.push_back( it->first );
+			for( std::map< size_t, AudioContentDetector* >::iterator it = audioDetectors.begin(); it != audioDetectors.end(); ++it )
+				streamIndexes.push_back( it->first );
+		}
+
+		for( std::vector< size_t >::const_iterator streamIndex = streamIndexes.begin(); streamIndex != streamIndexes.end(); ++streamIndex )
+		{
+			AVCodecContext& codecContext = *formatContext.streams[*streamIndex]->codec;
+			AVPacket data;
+			av_init_packet( &data );
+			data.data = isEndOfFile ? NULL : packet.data;
+			data.size = isEndOfFile ? 0 : packet.size;
+
+			if( videoDetectors.count( *streamIndex ) )
+			{
+				int gotFrame = 1;
+				while( gotFrame )
+				{
+					gotFrame = 0;
+					if( avcodec_decode_video2( &codecContext, avFrame, &gotFrame, &data ) < 0 )
+						break;
+					if( gotFrame )
+					{
+						frame.resize( avpicture_get_size( codecContext.pix_fmt, codecContext.width, codecContext.height ) );
+						avpicture_layout( (AVPicture*)avFrame, codecContext.pix_fmt, codecContext.width, codecContext.height, frame.getData(), frame.getSize() );
+						videoDetectors[*streamIndex]->process( frame );
+					}
+					// only the delayed frames are decoded again
+					if( ! isEndOfFile )
+						break;
+				}
+			}
+			else if( audioDetectors.count( *streamIndex ) )
+			{
+				const bool hasDelay = ( codecContext.codec->capabilities & CODEC_CAP_DELAY ) != 0;
+				while( data.size > 0 || ( isEndOfFile && hasDelay ) )
+				{
+					int gotFrame = 0;
+					const int decodedSize = avcodec_decode_audio4( &codecContext, avFrame, &gotFrame, &data );
+					if( decodedSize < 0 || ( isEndOfFile && ! gotFrame ) )
+						break;
+					data.data += decodedSize;
+					data.size -= decodedSize;
+					if( gotFrame )
+					{
+						// the planes of the planar formats are consecutive
+						frame.resize( av_samples_get_buffer_size( NULL, codecContext.channels, avFrame->nb_samples, codecContext.sample_fmt, 1 ) );
+						std::vector< uint8_t* > planes( codecContext.channels );
+						av_samples_fill_arrays( &planes[0], NULL, frame.getData(), codecContext.channels, avFrame->nb_samples, codecContext.sample_fmt, 1 );
+						av_samples_copy( &planes[0], avFrame->extended_data, 0, 0, avFrame->nb_samples, codecContext.channels, codecContext.sample_fmt );
+						audioDetectors[*streamIndex]->process( frame );
+					}
+				}
+			}
+		}
+
+		if( ! isEndOfFile )
+		{
+			const AVStream& stream = *formatContext.streams[packet.stream_index];
+			if( packet.dts != AV_NOPTS_VALUE && progress.progress( packet.dts * av_q2d( stream.time_base ), duration ) == eJobStatusCancel )
+				stopAnalyse = true;
+			av_free_packet( &packet );
+		}
+	}
+
+	// the segments of a part of the file would be taken for the whole file
+	if( stopAnalyse )
+	{
+		LOG_WARN( "The analysis of the content of the file is cancelled: no segment is detected" )
+		return;
+	}
+
+	for( std::map< size_t, VideoContentDetector* >::iterator it = videoDetectors.begin(); it != videoDetectors.end(); ++it )
+	{
+		it->second->flush();
+		_blackSegments[it->first] = it->second->getBlackSegments();
+		_freezeSegments[it->first] = it->second->getFreezeSegments();
+	}
+	for( std::map< size_t, AudioContentDetector* >::iterator it = audioDetectors.begin(); it != audioDetectors.end(); ++it )
+	{
+		it->second->flush();
+		_silenceSegments[it->first] = it->second->getSilenceSegments();
+	}
+}
+
 PropertyVector FileProperties::getPropertiesAsVector() const
 {
 	PropertyVector data;
@@ -245,6 +506,51 @@ void FileProperties::clearStreamProperties()
 	_subtitleStreams.clear();
 	_attachementStreams.clear();
 	_unknownStreams.clear();
+
+	_blackSegments.clear();
+	_freezeSegments.clear();
+	_silenceSegments.clear();
+}
+
+void FileProperties::mapStreamProperties()
+{
+	_streams.clear();
+
+	for( size_t streamIndex = 0; streamIndex < _videoStreams.size(); ++streamIndex )
+	{
+		const size_t videoStreamIndex = _videoStreams.at( streamIndex ).getStreamIndex();
+		_streams[ videoStreamIndex ] = &_videoStreams.at( streamIndex );
+	}
+
+	for( size_t streamIndex = 0; streamIndex < _audioStreams.size(); ++ streamIndex )
+	{
+		const size_t audioStreamIndex = _audioStreams.at( streamIndex ).getStreamIndex();
+		_streams[ audioStreamIndex ] = &_audioStreams.at(streamIndex);
+	}
+
+	for( size_t streamIndex = 0; streamIndex < _dataStreams.size(); ++ streamIndex )
+	{
+		const size_t dataStreamIndex = _dataStreams.at( streamIndex ).getStreamIndex();
+		_streams[ dataStreamIndex ] = &_dataStreams.at(streamIndex);
+	}
+
+	for( size_t streamIndex = 0; streamIndex < _subtitleStreams.size(); ++ streamIndex )
+	{
+		const size_t subtitleStreamIndex = _subtitleStreams.at( streamIndex ).getStreamIndex();
+		_streams[ subtitleStreamIndex ] = &_subtitleStreams.at(streamIndex);
+	}
+
+	for( size_t streamIndex = 0; streamIndex < _attachementStreams.size(); ++ streamIndex )
+	{
+		const size_t attachementStreamIndex = _attachementStreams.at( streamIndex ).getStreamIndex();
+		_streams[ attachementStreamIndex ] = &_attachementStreams.at(streamIndex);
+	}
+
+	for( size_t streamIndex = 0; streamIndex < _unknownStreams.size(); ++ streamIndex )
+	{
+		const size_t unknownStreamIndex = _unknownStreams.at( streamIndex ).getStreamIndex();
+		_streams[ unknownStreamIndex ] = &_unknownStreams.at(streamIndex);
+	}
 }
 
 }
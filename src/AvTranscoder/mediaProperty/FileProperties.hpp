@@ -13,6 +13,7 @@
 #include <AvTranscoder/mediaProperty/SubtitleProperties.hpp>
 #include <AvTranscoder/mediaProperty/AttachementProperties.hpp>
 #include <AvTranscoder/mediaProperty/UnknownProperties.hpp>
+#include <AvTranscoder/stat/DetectedSegment.hpp>
 
 #include <string>
 #include <vector>
@@ -31,6 +32,17 @@ public:
 	 */
 	FileProperties( const FormatContext& formatContext );
 
+	/**
+	 * @brief Copy the properties of a file.
+	 * @note If the properties come from the ProbeCache, its entry is acquired until the copy is destroyed:
+	 * the copy stays valid when the entry is removed from the cache.
+	 * @see ProbeCache::acquireProperties
+	 */
+	FileProperties( const FileProperties& properties );
+	FileProperties& operator=( const FileProperties& properties );
+
+	~FileProperties();
+
 	/**
 	 * @brief Relaunch streams analysis with a specific level.
 	 * @param progress callback to get analysis progression
@@ -81,6 +93,16 @@ public:
 	const AVFormatContext& getAVFormatContext() { return *_avFormatContext; }
 #endif
 
+	//@{
+	// @brief Get the segments detected in the decoded frames of the stream at the indicated index
+	// @note Only with the analyse level eAnalyseLevelFull (empty otherwise, or if the analysis is cancelled)
+	// @see VideoContentDetector
+	// @see AudioContentDetector
+	std::vector< avtranscoder::DetectedSegment > getBlackSegments( const size_t streamIndex ) const;
+	std::vector< avtranscoder::DetectedSegment > getFreezeSegments( const size_t streamIndex ) const;
+	std::vector< avtranscoder::DetectedSegment > getSilenceSegments( const size_t streamIndex ) const;
+	//@}
+
 	PropertyVector getPropertiesAsVector() const;  ///< Return all file properties as a vector (name of property: value)
 
 private:
@@ -100,6 +122,12 @@ private:
 #endif
 
 	void clearStreamProperties();  ///< Clear all array of stream properties
+	void mapStreamProperties();  ///< Fill the map of properties per stream index from the arrays of stream properties
+
+	/**
+	 * @brief Decode all the video and audio streams in a single read of the file, to detect their black, frozen and silent segments.
+	 */
+	void detectContent( IProgress& progress );
 
 private:
 	const FormatContext* _formatContext;  ///< Has link (no ownership)
@@ -115,6 +143,15 @@ private:
 	std::vector< UnknownProperties > _unknownStreams;  ///< Array of properties per unknown stream
 
 	PropertyVector _metadatas;
+
+	//@{
+	// @brief Segments detected per stream index
+	std::map< size_t, std::vector< DetectedSegment > > _blackSegments;
+	std::map< size_t, std::vector< DetectedSegment > > _freezeSegments;
+	std::map< size_t, std::vector< DetectedSegment > > _silenceSegments;
+	//@}
+
+	const FileProperties* _cachedProperties;  ///< Properties of the ProbeCache acquired by this copy, released when destroyed (NULL if not a copy from the cache)
 };
 
 }
@@ -43,6 +43,17 @@ float StreamProperties::getDuration() const
 	return ( timeBase.num / (float) timeBase.den ) * _formatContext->streams[_streamIndex]->duration;
 }
 
+double StreamProperties::getStartTime() const
+{
+	if( ! _formatContext )
+		throw std::runtime_error( "unknown format context" );
+
+	const AVStream& avStream = *_formatContext->streams[_streamIndex];
+	if( avStream.start_time == (int64_t)AV_NOPTS_VALUE )
+		return 0.;
+	return avStream.start_time * av_q2d( avStream.time_base );
+}
+
 AVMediaType StreamProperties::getStreamType() const
 {
 	if( ! _formatContext )
@@ -19,6 +19,7 @@ public:
 	size_t getStreamId() const;
 	Rational getTimeBase() const;
 	float getDuration() const;  ///< in seconds
+	double getStartTime() const;  ///< Time in seconds of the first timestamp of the stream, origin of the times in the stream (0 if unknown)
 	AVMediaType getStreamType() const;
 	const PropertyVector& getMetadatas() const { return _metadatas; }
 
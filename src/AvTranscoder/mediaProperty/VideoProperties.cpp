@@ -45,7 +45,7 @@ VideoProperties::VideoProperties( const FormatContext& formatContext, const size
 		_firstGopTimeCode = _codecContext->timecode_frame_start;
 	}
 
-	if( level == eAnalyseLevelFirstGop )
+	if( level >= eAnalyseLevelFirstGop )
 		analyseGopStructure( progress );
 }
 
@@ -9,10 +9,13 @@
 #include <AvTranscoder/mediaProperty/SubtitleProperties.hpp>
 #include <AvTranscoder/mediaProperty/AttachementProperties.hpp>
 #include <AvTranscoder/mediaProperty/UnknownProperties.hpp>
+#include <AvTranscoder/stat/DetectedSegment.hpp>
 
 using namespace avtranscoder;
 %}
 
+%include <AvTranscoder/stat/DetectedSegment.hpp>
+
 namespace std {
 // Allow vector of object with no default constructor
 %ignore vector< avtranscoder::VideoProperties >::vector(size_type); 
@@ -44,6 +47,8 @@ namespace std {
 %template(GopVector)       vector< pair< char, bool > >;
 
 %template(ChannelVector)   vector< avtranscoder::Channel >;
+
+%template(DetectedSegmentVector)  vector< avtranscoder::DetectedSegment >;
 }
 
 %include <AvTranscoder/mediaProperty/util.hpp>
@@ -35,19 +35,7 @@ void ProfileLoader::loadProfile( const std::string& avProfileFileName )
 
 void ProfileLoader::loadProfiles( const std::string& avProfilesPath )
 {
-	std::string realAvProfilesPath = avProfilesPath;
-	if( realAvProfilesPath.empty() )
-	{
-		// get custom profiles location from AVPROFILES environment variable
-		if( std::getenv( "AVPROFILES" ) )
-			realAvProfilesPath = std::getenv( "AVPROFILES" );
-		// else get default profiles location
-		else
-			realAvProfilesPath = AVTRANSCODER_DEFAULT_AVPROFILES;
-	}
-
-	std::vector< std::string > paths;
-	split( paths, realAvProfilesPath, ":" );
+	std::vector< std::string > paths = getProfilesDirectories( avProfilesPath );
 	for( std::vector< std::string >::iterator dirIt = paths.begin(); dirIt != paths.end(); ++dirIt )
 	{
 		std::vector< std::string > files;
@@ -118,6 +106,16 @@ bool ProfileLoader::hasProfile( const Profile& profile ) const
 	return false;
 }
 
+bool ProfileLoader::hasProfile( const std::string& avProfileIdentificator ) const
+{
+	for( Profiles::const_iterator it = _profiles.begin(); it != _profiles.end(); ++it )
+	{
+		if( (*it).find( constants::avProfileIdentificator )->second == avProfileIdentificator )
+			return true;
+	}
+	return false;
+}
+
 const ProfileLoader::Profiles& ProfileLoader::getProfiles() const
 {
 	return _profiles;
@@ -174,6 +172,23 @@ const ProfileLoader::Profile& ProfileLoader::getProfile( const std::string& avPr
 	throw std::runtime_error( "unable to find profile: " + avProfileIdentificator );
 }
 
+std::vector< std::string > ProfileLoader::getProfilesDirectories( const std::string& avProfilesPath )
+{
+	std::string realAvProfilesPath = avProfilesPath;
+	if( realAvProfilesPath.empty() )
+	{
+		// get custom profiles location from AVPROFILES environment variable
+		if( std::getenv( "AVPROFILES" ) )
+			realAvProfilesPath = std::getenv( "AVPROFILES" );
+		// else get default profiles location
+		else
+			realAvProfilesPath = AVTRANSCODER_DEFAULT_AVPROFILES;
+	}
+
+	std::vector< std::string > paths;
+	split( paths, realAvProfilesPath, ":" );
+	return paths;
+}
 
 bool ProfileLoader::checkFormatProfile( const Profile& profileToCheck )
 {
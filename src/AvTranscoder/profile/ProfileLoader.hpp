@@ -59,6 +59,7 @@ public:
 	void loadProfile( const Profile& profile );
 
 	bool hasProfile( const Profile& profile ) const;
+	bool hasProfile( const std::string& avProfileIdentificator ) const;
 
 	const Profiles& getProfiles() const;
 
@@ -69,6 +70,12 @@ public:
 	const Profile& getProfile( const std::string& avProfileIdentificator ) const;
 
 public:
+	/**
+	 * @brief Get the list of directories which contain the profiles.
+	 * @param avProfilesPath: if empty, the path is replaced by value of AVPROFILES environment variable
+	 */
+	static std::vector< std::string > getProfilesDirectories( const std::string& avProfilesPath = "" );
+
 	static bool checkFormatProfile( const Profile& profileToCheck );
 	static bool checkVideoProfile( const Profile& profileToCheck );
 	static bool checkAudioProfile( const Profile& profileToCheck );
@@ -0,0 +1,157 @@
+#include "ProfileRegistry.hpp"
+
+#include "util.hpp"
+
+#include <AvTranscoder/thread.hpp>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdexcept>
+
+namespace avtranscoder
+{
+
+namespace
+{
+	Mutex profileRegistryMutex;  ///< Protect the instance of the ProfileRegistry
+}
+
+ProfileRegistry& ProfileRegistry::getInstance()
+{
+	// lock the creation of the instance (not thread safe in C++98)
+	ScopedLock lock( profileRegistryMutex );
+	static ProfileRegistry instance;
+	return instance;
+}
+
+ProfileRegistry::ProfileRegistry()
+	: _profiles()
+	, _files()
+	, _filePaths()
+	, _lastUpdateTime( 0 )
+{}
+
+bool ProfileRegistry::hasProfile( const std::string& avProfileIdentificator )
+{
+	ScopedLock lock( profileRegistryMutex );
+	update();
+	return _profiles.find( avProfileIdentificator ) != _profiles.end();
+}
+
+ProfileLoader::Profile ProfileRegistry::getProfile( const std::string& avProfileIdentificator )
+{
+	ScopedLock lock( profileRegistryMutex );
+	update();
+	std::map< std::string, ProfileLoader::Profile >::const_iterator it = _profiles.find( avProfileIdentificator );
+	if( it == _profiles.end() )
+		throw std::runtime_error( "unable to find profile: " + avProfileIdentificator );
+	return it->second;
+}
+
+ProfileLoader::Profiles ProfileRegistry::getProfiles()
+{
+	ScopedLock lock( profileRegistryMutex );
+	update();
+	ProfileLoader::Profiles profiles;
+	for( std::map< std::string, ProfileLoader::Profile >::const_iterator it = _profiles.begin(); it != _profiles.end(); ++it )
+	{
+		profiles.push_back( it->second );
+	}
+	return profiles;
+}
+
+void ProfileRegistry::reload()
+{
+	ScopedLock lock( profileRegistryMutex );
+	_files.clear();
+	_filePaths.clear();
+	_lastUpdateTime = 0;
+	update();
+}
+
+void ProfileRegistry::update()
+{
+	// check the profile files at most once per second
+	const std::time_t currentTime = std::time( NULL );
+	if( _lastUpdateTime != 0 && currentTime == _lastUpdateTime )
+		return;
+	_lastUpdateTime = currentTime;
+
+	bool hasChanged = false;
+	std::map< std::string, ProfileFile > files;
+	std::vector< std::string > filePaths;
+
+	const std::vector< std::string > paths = ProfileLoader::getProfilesDirectories();
+	for( std::vector< std::string >::const_iterator dirIt = paths.begin(); dirIt != paths.end(); ++dirIt )
+	{
+		std::vector< std::string > filenames;
+		if( getFilesInDir( *dirIt, filenames ) != 0 )
+			continue;
+
+		for( std::vector< std::string >::const_iterator fileIt = filenames.begin(); fileIt != filenames.end(); ++fileIt )
+		{
+			const std::string absPath = ( *dirIt ) + "/" + ( *fileIt );
+			if( files.count( absPath ) )
+				continue;
+
+			struct stat fileStatus;
+			if( stat( absPath.c_str(), &fileStatus ) != 0 )
+				continue;
+
+			// the file has not changed since the last check
+			filePaths.push_back( absPath );
+			std::map< std::string, ProfileFile >::iterator previousIt = _files.find( absPath );
+			if( previousIt != _files.end() &&
+				previousIt->second._fileSize == fileStatus.st_size &&
+				previousIt->second._modificationTime == fileStatus.st_mtime )
+			{
+				files[ absPath ] = previousIt->second;
+				continue;
+			}
+
+			// parse the new or modified file
+			hasChanged = true;
+			ProfileFile& profileFile = files[ absPath ];
+			profileFile._fileSize = fileStatus.st_size;
+			profileFile._modificationTime = fileStatus.st_mtime;
+			try
+			{
+				ProfileLoader profileLoader;
+				profileLoader.loadProfile( absPath );
+				profileFile._profiles = profileLoader.getProfiles();
+			}
+			catch( const std::exception& e )
+			{
+				LOG_WARN( e.what() )
+			}
+		}
+	}
+
+	// some profile files were removed, or the directories were reordered
+	if( filePaths != _filePaths )
+		hasChanged = true;
+
+	if( ! hasChanged )
+		return;
+
+	// index the profiles per name, in the order of the directories: the first definition of a profile is kept, like ProfileLoader
+	_files.swap( files );
+	_filePaths.swap( filePaths );
+	_profiles.clear();
+	for( std::vector< std::string >::const_iterator pathIt = _filePaths.begin(); pathIt != _filePaths.end(); ++pathIt )
+	{
+		const ProfileLoader::Profiles& profiles = _files[ *pathIt ]._profiles;
+		for( ProfileLoader::Profiles::const_iterator profileIt = profiles.begin(); profileIt != profiles.end(); ++profileIt )
+		{
+			const std::string& name = profileIt->find( constants::avProfileIdentificator )->second;
+			if( _profiles.count( name ) )
+			{
+				LOG_WARN( "Profile '" << name << "' is defined several times: ignore the one of '" << *pathIt << "'." )
+				continue;
+			}
+			_profiles[ name ] = *profileIt;
+		}
+	}
+}
+
+}
@@ -0,0 +1,72 @@
+#ifndef _AV_TRANSCODER_PROFILE_REGISTRY_HPP_
+#define _AV_TRANSCODER_PROFILE_REGISTRY_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/profile/ProfileLoader.hpp>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <ctime>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Process-wide registry of the profiles found in the AVPROFILES directories.
+ * The profile files are parsed once, and are parsed again only if they change on disk
+ * (the directories are checked at most once per second).
+ * If a profile is defined several times, the one of the first AVPROFILES directory is kept.
+ * @note All methods are thread safe, and return copies of the profiles.
+ */
+class AvExport ProfileRegistry
+{
+private:
+	ProfileRegistry();
+	ProfileRegistry( const ProfileRegistry& profileRegistry );
+	ProfileRegistry& operator=( const ProfileRegistry& profileRegistry );
+
+public:
+	/**
+	 * @return The instance shared by the whole process.
+	 */
+	static ProfileRegistry& getInstance();
+
+	bool hasProfile( const std::string& avProfileIdentificator );
+
+	/**
+	 * @exception throw std::runtime_error if the profile does not exist
+	 */
+	ProfileLoader::Profile getProfile( const std::string& avProfileIdentificator );
+
+	ProfileLoader::Profiles getProfiles();
+
+	/**
+	 * @brief Parse again all the profile files.
+	 */
+	void reload();
+
+private:
+	struct ProfileFile
+	{
+		int64_t _fileSize;
+		int64_t _modificationTime;
+		ProfileLoader::Profiles _profiles;  ///< Profiles defined in the file
+	};
+
+	/**
+	 * @brief Parse the profile files which were added or modified since the last check.
+	 * @note The caller has to lock the registry.
+	 */
+	void update();
+
+private:
+	std::map< std::string, ProfileLoader::Profile > _profiles;  ///< Profiles per name
+	std::map< std::string, ProfileFile > _files;  ///< Profile files per absolute path
+	std::vector< std::string > _filePaths;  ///< Absolute paths of the profile files, in the order of the AVPROFILES directories
+	std::time_t _lastUpdateTime;  ///< 0 if never updated
+};
+
+}
+
+#endif
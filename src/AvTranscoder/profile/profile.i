@@ -1,5 +1,6 @@
 %{
 #include <AvTranscoder/profile/ProfileLoader.hpp>
+#include <AvTranscoder/profile/ProfileRegistry.hpp>
 %}
 
 namespace std {
@@ -8,3 +9,4 @@ namespace std {
 }
 
 %include <AvTranscoder/profile/ProfileLoader.hpp>
+%include <AvTranscoder/profile/ProfileRegistry.hpp>
@@ -34,7 +34,7 @@
 namespace avtranscoder
 {
 
-void split( std::vector< std::string >& splitString, const std::string& inputString, const std::string& splitChars )
+inline void split( std::vector< std::string >& splitString, const std::string& inputString, const std::string& splitChars )
 {
 	char* part = strtok( const_cast<char*>( inputString.c_str() ), splitChars.c_str() );
 	while( part != NULL )
@@ -44,7 +44,7 @@ void split( std::vector< std::string >& splitString, const std::string& inputStr
 	}
 }
 
-int getFilesInDir( const std::string& dir, std::vector< std::string >& files )
+inline int getFilesInDir( const std::string& dir, std::vector< std::string >& files )
 {
 #if defined ( __WINDOWS__ )
 	WIN32_FIND_DATA findData;
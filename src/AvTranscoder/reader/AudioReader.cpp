@@ -3,15 +3,26 @@
 #include <AvTranscoder/decoder/AudioDecoder.hpp>
 #include <AvTranscoder/frame/AudioFrame.hpp>
 #include <AvTranscoder/transform/AudioTransform.hpp>
-#include <AvTranscoder/progress/NoDisplayProgress.hpp>
+#include <AvTranscoder/file/ProbeCache.hpp>
 #include <AvTranscoder/mediaProperty/print.hpp>
 
+extern "C" {
+#include <libavutil/audio_fifo.h>
+}
+
+#include <cstring>
+#include <stdexcept>
+
 namespace avtranscoder
 {
 
 AudioReader::AudioReader( const std::string& filename, const size_t audioStreamIndex, const size_t sampleRate, const size_t nbChannels, const std::string& sampleFormat )
 	: IReader( filename, audioStreamIndex )
 	, _audioStreamProperties(NULL)
+	, _fifo( NULL )
+	, _planes()
+	, _samplePosition( 0 )
+	, _isEndOfStream( false )
 	, _sampleRate( sampleRate )
 	, _nbChannels( nbChannels )
 	, _sampleFormat( av_get_sample_fmt( sampleFormat.c_str() ) )
@@ -22,6 +33,10 @@ AudioReader::AudioReader( const std::string& filename, const size_t audioStreamI
 AudioReader::AudioReader( InputFile& inputFile, const size_t audioStreamIndex, const size_t sampleRate, const size_t nbChannels, const std::string& sampleFormat  )
 	: IReader( inputFile, audioStreamIndex )
 	, _audioStreamProperties(NULL)
+	, _fifo( NULL )
+	, _planes()
+	, _samplePosition( 0 )
+	, _isEndOfStream( false )
 	, _sampleRate( sampleRate )
 	, _nbChannels( nbChannels )
 	, _sampleFormat( av_get_sample_fmt( sampleFormat.c_str() ) )
@@ -31,10 +46,9 @@ AudioReader::AudioReader( InputFile& inputFile, const size_t audioStreamIndex, c
 
 void AudioReader::init()
 {
-	// analyse InputFile
-	avtranscoder::NoDisplayProgress p;
-	_inputFile->analyse( p );
-	_streamProperties = &_inputFile->getProperties().getStreamPropertiesWithIndex(_streamIndex);
+	// get properties of the analysed file (shared between all readers of the process)
+	_fileProperties = &ProbeCache::acquireProperties( _inputFile->getFilename() );
+	_streamProperties = &_fileProperties->getStreamPropertiesWithIndex(_streamIndex);
 	_audioStreamProperties = static_cast<const AudioProperties*>(_streamProperties);
 	_inputFile->activateStream( _streamIndex );
 
@@ -55,14 +69,27 @@ void AudioReader::init()
 
 	// create transform
 	_transform = new AudioTransform();
+
+	// create fifo (grows with the samples written), last as it is not freed if the constructor throws
+	_planes.resize( av_sample_fmt_is_planar( _sampleFormat ) ? _nbChannels : 1, NULL );
+	_fifo = av_audio_fifo_alloc( _sampleFormat, _nbChannels, 1 );
+	if( ! _fifo )
+		throw std::runtime_error( "Unable to allocate the audio FIFO of the reader" );
 }
 
 AudioReader::~AudioReader()
 {
-	delete _decoder;
-	delete _srcFrame;
-	delete _dstFrame;
-	delete _transform;
+	av_audio_fifo_free( _fifo );
+}
+
+Frame* AudioReader::allocateFrame( const Frame& frame ) const
+{
+	// the transform converts the next samples in a frame of the same size
+	const AudioFrame& audioFrame = static_cast<const AudioFrame&>( frame );
+	AudioFrame* newFrame = new AudioFrame( audioFrame.desc() );
+	newFrame->resize( audioFrame.getSize() );
+	newFrame->setNbSamples( audioFrame.getNbSamples() );
+	return newFrame;
 }
 
 size_t AudioReader::getSampleRate()
@@ -85,4 +112,127 @@ void AudioReader::printInfo()
 	std::cout << *_audioStreamProperties << std::endl;
 }
 
+size_t AudioReader::readSamples( unsigned char* buffer, const size_t nbSamples )
+{
+	fillFifo( nbSamples );
+
+	const size_t nbSamplesInFifo = av_audio_fifo_size( _fifo );
+	const size_t nbSamplesRead = nbSamplesInFifo < nbSamples ? nbSamplesInFifo : nbSamples;
+	fillPlanes( buffer, nbSamples );
+	if( av_audio_fifo_read( _fifo, (void**)&_planes.at( 0 ), nbSamplesRead ) < (int)nbSamplesRead )
+		throw std::runtime_error( "Unable to read samples from the audio FIFO of the reader" );
+
+	_samplePosition += nbSamplesRead;
+	return nbSamplesRead;
+}
+
+size_t AudioReader::readSamples( AudioFrame& frame, const size_t nbSamples )
+{
+	const size_t sampleSize = av_get_bytes_per_sample( _sampleFormat );
+	frame.resize( nbSamples * _nbChannels * sampleSize );
+
+	const size_t nbSamplesRead = readSamples( frame.getData(), nbSamples );
+	if( nbSamplesRead < nbSamples )
+	{
+		// the planes are next to each other
+		if( av_sample_fmt_is_planar( _sampleFormat ) )
+		{
+			for( size_t channel = 1; channel < _nbChannels; ++channel )
+				memmove( frame.getData() + channel * nbSamplesRead * sampleSize, frame.getData() + channel * nbSamples * sampleSize, nbSamplesRead * sampleSize );
+		}
+		frame.resize( nbSamplesRead * _nbChannels * sampleSize );
+	}
+	frame.setNbSamples( nbSamplesRead );
+	return nbSamplesRead;
+}
+
+bool AudioReader::seekAtSample( const size_t sample )
+{
+	// the samples of the stream start at its first timestamp, as in StreamTranscoder
+	if( ! _inputFile->seekAtTime( _streamProperties->getStartTime() + (double)sample / _sampleRate, AVSEEK_FLAG_BACKWARD ) )
+		return false;
+
+	_inputFile->getStream( _streamIndex ).clearBuffering();
+	_decoder->flushDecoder();
+
+	// the delay of the resampler has samples from before the seek
+	delete _transform;
+	_transform = new AudioTransform();
+	av_audio_fifo_reset( _fifo );
+	_isEndOfStream = false;
+
+	if( ! decodeInFifo() )
+	{
+		_samplePosition = sample;
+		return true;
+	}
+
+	// position of the first decoded sample
+	size_t firstSample = sample;
+	const int64_t timestamp = _decoder->getLastDecodedTimestamp();
+	if( timestamp != (int64_t)AV_NOPTS_VALUE )
+	{
+		const AVStream& avStream = _inputFile->getFormatContext().getAVStream( _streamIndex );
+		const int64_t streamStartTime = ( avStream.start_time != (int64_t)AV_NOPTS_VALUE ) ? avStream.start_time : 0;
+		const int64_t position = av_rescale( timestamp - streamStartTime, (int64_t)avStream.time_base.num * _sampleRate, avStream.time_base.den );
+		firstSample = position > 0 ? position : 0;
+	}
+	if( firstSample > sample )
+	{
+		LOG_WARN( "Seek at sample " << firstSample << " instead of " << sample << " (no keyframe before)" )
+		_samplePosition = firstSample;
+		return true;
+	}
+
+	// skip the samples before the given one
+	size_t nbSamplesToSkip = sample - firstSample;
+	while( nbSamplesToSkip )
+	{
+		if( ! av_audio_fifo_size( _fifo ) && ! decodeInFifo() )
+			break;
+		const size_t nbSamplesInFifo = av_audio_fifo_size( _fifo );
+		const size_t nbSamplesSkipped = nbSamplesInFifo < nbSamplesToSkip ? nbSamplesInFifo : nbSamplesToSkip;
+		av_audio_fifo_drain( _fifo, nbSamplesSkipped );
+		nbSamplesToSkip -= nbSamplesSkipped;
+	}
+	_samplePosition = sample - nbSamplesToSkip;
+	LOG_DEBUG( "Seek at sample " << _samplePosition << " (decoded from sample " << firstSample << ")" )
+	return true;
+}
+
+void AudioReader::fillFifo( const size_t nbSamples )
+{
+	while( (size_t)av_audio_fifo_size( _fifo ) < nbSamples && decodeInFifo() )
+	{}
+}
+
+bool AudioReader::decodeInFifo()
+{
+	if( _isEndOfStream )
+		return false;
+
+	AudioTransform* transform = static_cast<AudioTransform*>( _transform );
+	if( _decoder->decodeNextFrame( *_srcFrame ) )
+		transform->convert( *_srcFrame, *_dstFrame );
+	else if( ! transform->flush( *_dstFrame ) )
+	{
+		_isEndOfStream = true;
+		return false;
+	}
+
+	AudioFrame* dstFrame = static_cast<AudioFrame*>( _dstFrame );
+	const size_t nbSamples = dstFrame->getNbSamples();
+	fillPlanes( dstFrame->getData(), nbSamples );
+	if( av_audio_fifo_write( _fifo, (void**)&_planes.at( 0 ), nbSamples ) < (int)nbSamples )
+		throw std::runtime_error( "Unable to write samples in the audio FIFO of the reader" );
+	return true;
+}
+
+void AudioReader::fillPlanes( unsigned char* buffer, const size_t nbSamples )
+{
+	const size_t planeSize = nbSamples * av_get_bytes_per_sample( _sampleFormat ) * ( av_sample_fmt_is_planar( _sampleFormat ) ? 1 : _nbChannels );
+	for( size_t plane = 0; plane < _planes.size(); ++plane )
+		_planes.at( plane ) = buffer + plane * planeSize;
+}
+
 }
@@ -5,6 +5,11 @@
 
 #include <AvTranscoder/file/InputFile.hpp>
 #include <AvTranscoder/mediaProperty/AudioProperties.hpp>
+#include <AvTranscoder/frame/AudioFrame.hpp>
+
+#include <vector>
+
+struct AVAudioFifo;
 
 namespace avtranscoder
 {
@@ -34,12 +39,64 @@ public:
 
 	void printInfo();
 
+	/**
+	 * @brief Read the given number of samples per channel from the current sample position, in the output format.
+	 * The decoded samples are buffered in a FIFO: the number of samples read does not depend on the size of the decoded frames.
+	 * @param buffer: nbSamples * getChannels() samples, interleaved (or the planes one after the other if the output format is planar)
+	 * @return the number of samples read per channel (less than nbSamples at the end of the stream)
+	 * @warning Do not mix with readNextFrame / readPrevFrame / readFrameAt.
+	 */
+#ifndef SWIG
+	size_t readSamples( unsigned char* buffer, const size_t nbSamples );
+#endif
+
+	/**
+	 * @brief Read the given number of samples per channel in the given frame.
+	 * @note The frame is resized to the samples read (its buffer is reused if it is large enough).
+	 */
+	size_t readSamples( AudioFrame& frame, const size_t nbSamples );
+
+	/**
+	 * @brief Seek at the given sample (at the output sample rate), from the beginning of the stream.
+	 * The stream is decoded from the previous keyframe, and the samples before the given one are skipped.
+	 * @return false if the seek failed
+	 */
+	bool seekAtSample( const size_t sample );
+
+	/**
+	 * @brief Returns the index of the next sample read (at the output sample rate).
+	 */
+	size_t getSamplePosition() const { return _samplePosition; }
+
 private:
 	void init();
 
+	Frame* allocateFrame( const Frame& frame ) const;
+
+	/**
+	 * @brief Decode and convert frames until the FIFO has the given number of samples, or until the end of the stream.
+	 */
+	void fillFifo( const size_t nbSamples );
+
+	/**
+	 * @brief Decode and convert the next frame, and write its samples in the FIFO.
+	 * @return false at the end of the stream
+	 */
+	bool decodeInFifo();
+
+	/**
+	 * @brief Point the planes of the given buffer of nbSamples per channel in the output format.
+	 */
+	void fillPlanes( unsigned char* buffer, const size_t nbSamples );
+
 private:
 	const AudioProperties* _audioStreamProperties;  ///< Properties of the source audio stream read (no ownership, has link)
 
+	AVAudioFifo* _fifo;  ///< Decoded samples in the output format, not read yet (has ownership)
+	std::vector< unsigned char* > _planes;  ///< Pointers to the planes of the data given to / read from the FIFO
+	size_t _samplePosition;  ///< Index of the next sample read
+	bool _isEndOfStream;  ///< The decoder and the resampler have no more samples
+
 	//@{
 	// @brief Output info
 	size_t _sampleRate;
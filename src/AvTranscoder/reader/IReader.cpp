@@ -1,5 +1,6 @@
 #include "IReader.hpp"
 
+#include <AvTranscoder/file/ProbeCache.hpp>
 #include <AvTranscoder/mediaProperty/print.hpp>
 
 #include <cassert>
@@ -9,6 +10,7 @@ namespace avtranscoder
 
 IReader::IReader( const std::string& filename, const size_t streamIndex )
 	: _inputFile( NULL )
+	, _fileProperties( NULL )
 	, _streamProperties( NULL )
 	, _decoder( NULL )
 	, _srcFrame( NULL )
@@ -23,6 +25,7 @@ IReader::IReader( const std::string& filename, const size_t streamIndex )
 
 IReader::IReader( InputFile& inputFile, const size_t streamIndex )
 	: _inputFile( &inputFile )
+	, _fileProperties( NULL )
 	, _streamProperties( NULL )
 	, _decoder( NULL )
 	, _srcFrame( NULL )
@@ -35,6 +38,14 @@ IReader::IReader( InputFile& inputFile, const size_t streamIndex )
 
 IReader::~IReader()
 {
+	// allocated by the readers, and deleted here even if their constructor throws
+	delete _decoder;
+	delete _srcFrame;
+	delete _dstFrame;
+	delete _transform;
+
+	if( _fileProperties )
+		ProbeCache::releaseProperties( *_fileProperties );
 	if( _inputFileAllocated )
 		delete _inputFile;
 }
@@ -70,6 +81,15 @@ Frame* IReader::readFrameAt( const size_t frame )
 	return _dstFrame;
 }
 
+Frame* IReader::releaseFrame()
+{
+	assert( _dstFrame != NULL );
+
+	Frame* frame = _dstFrame;
+	_dstFrame = allocateFrame( *frame );
+	return frame;
+}
+
 void IReader::printInfo()
 {
 	assert( _streamProperties != NULL );
@@ -46,20 +46,33 @@ public:
 	 */
 	Frame* readFrameAt( const size_t frame );
 
+	/**
+	 * @brief Give the frame returned by the last read to the caller, who has to delete it: the next read is done in a new frame.
+	 * @note The frame returned by a read is overwritten, and can be reallocated, by the next read: this keeps its data valid.
+	 */
+	Frame* releaseFrame();
+
 	/**
 	 * @brief Print info of the source stream read.
 	 */
 	virtual void printInfo();
 
+protected:
+	/**
+	 * @brief Returns a new frame in the output format of the reader, of the size of the given frame.
+	 */
+	virtual Frame* allocateFrame( const Frame& frame ) const = 0;
+
 protected:
 	InputFile* _inputFile;
+	const FileProperties* _fileProperties;  ///< Acquired from the ProbeCache (released when the reader is destroyed)
 	const StreamProperties* _streamProperties;
-	IDecoder* _decoder;
+	IDecoder* _decoder;  ///< Has ownership
 
-	Frame* _srcFrame;
-	Frame* _dstFrame;
+	Frame* _srcFrame;  ///< Has ownership
+	Frame* _dstFrame;  ///< Has ownership
 
-	ITransform* _transform;
+	ITransform* _transform;  ///< Has ownership
 
 	size_t _streamIndex;
 
@@ -3,7 +3,7 @@
 #include <AvTranscoder/decoder/VideoDecoder.hpp>
 #include <AvTranscoder/frame/VideoFrame.hpp>
 #include <AvTranscoder/transform/VideoTransform.hpp>
-#include <AvTranscoder/progress/NoDisplayProgress.hpp>
+#include <AvTranscoder/file/ProbeCache.hpp>
 #include <AvTranscoder/mediaProperty/print.hpp>
 
 namespace avtranscoder
@@ -31,10 +31,9 @@ VideoReader::VideoReader( InputFile& inputFile, const size_t videoStreamIndex, c
 
 void VideoReader::init()
 {
-	// analyse InputFile
-	avtranscoder::NoDisplayProgress p;
-	_inputFile->analyse( p );
-	_streamProperties = &_inputFile->getProperties().getStreamPropertiesWithIndex(_streamIndex);
+	// get properties of the analysed file (shared between all readers of the process)
+	_fileProperties = &ProbeCache::acquireProperties( _inputFile->getFilename() );
+	_streamProperties = &_fileProperties->getStreamPropertiesWithIndex(_streamIndex);
 	_videoStreamProperties = static_cast<const VideoProperties*>(_streamProperties);
 	_inputFile->activateStream( _streamIndex );
 
@@ -59,10 +58,11 @@ void VideoReader::init()
 
 VideoReader::~VideoReader()
 {
-	delete _decoder;
-	delete _srcFrame;
-	delete _dstFrame;
-	delete _transform;
+}
+
+Frame* VideoReader::allocateFrame( const Frame& frame ) const
+{
+	return new VideoFrame( static_cast<const VideoFrame&>( frame ).desc() );
 }
 
 size_t VideoReader::getWidth()
@@ -41,6 +41,8 @@ public:
 private:
 	void init();
 
+	Frame* allocateFrame( const Frame& frame ) const;
+
 private:
 	const VideoProperties* _videoStreamProperties;  ///< Properties of the source video stream read (no ownership, has link)
 
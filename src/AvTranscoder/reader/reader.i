@@ -5,6 +5,53 @@
  #include <AvTranscoder/reader/AudioReader.hpp>
 %}
 
+#if SWIGPYTHON
+/*
+ * The frames returned by a reader are owned by the reader, and overwritten (or reallocated) by the next read.
+ * Before the next read, the last frame is given to Python if it is still referenced (by numpy arrays on its data, see frame.i):
+ * its data stays valid, and the reader reads in a new frame.
+ */
+%define AVTRANSCODER_READER_OWNS_FRAME( method )
+%pythonprepend avtranscoder::IReader::method %{
+	self._releaseReferencedFrame()
+%}
+%pythonappend avtranscoder::IReader::method %{
+	if val is not None:
+		self._lastFrame = weakref.ref( val )
+%}
+%enddef
+
+AVTRANSCODER_READER_OWNS_FRAME( readNextFrame )
+AVTRANSCODER_READER_OWNS_FRAME( readPrevFrame )
+AVTRANSCODER_READER_OWNS_FRAME( readFrameAt )
+
+%extend avtranscoder::IReader
+{
+	%pythoncode
+	%{
+		def _releaseReferencedFrame( self ):
+			"""
+			Give the frame of the last read to Python if it is still referenced.
+			"""
+			lastFrame = getattr( self, '_lastFrame', None )
+			frame = lastFrame() if lastFrame is not None else None
+			if frame is not None:
+				self.releaseFrame()
+				frame.thisown = True
+			self._lastFrame = None
+	%}
+}
+
+%pythoncode
+%{
+import weakref
+%}
+#endif
+
+%thread avtranscoder::IReader::readNextFrame;
+%thread avtranscoder::IReader::readPrevFrame;
+%thread avtranscoder::IReader::readFrameAt;
+
 %include <AvTranscoder/common.hpp>
 %include <AvTranscoder/reader/IReader.hpp>
 %include <AvTranscoder/reader/VideoReader.hpp>
@@ -2,6 +2,11 @@
 #define  _AV_TRANSCODER_AUDIOSTAT_HPP
 
 #include <AvTranscoder/common.hpp>
+#include <AvTranscoder/stat/DetectedSegment.hpp>
+#include <AvTranscoder/stat/StageStat.hpp>
+
+#include <string>
+#include <vector>
 
 namespace avtranscoder
 {
@@ -15,11 +20,31 @@ public:
 	AudioStat( const float duration, const size_t nbPackets )
 	: _duration( duration )
 	, _nbPackets( nbPackets )
+	, _decodedDigest()
+	, _encodedDigest()
+	, _silenceSegments()
+	, _demuxStat()
+	, _decodeStat()
+	, _convertStat()
+	, _encodeStat()
+	, _muxStat()
 	{}
 
 public:
 	float _duration;
 	size_t _nbPackets;
+	std::string _decodedDigest;  ///< Digest of the frames decoded from the input. Empty if not digested.
+	std::string _encodedDigest;  ///< Digest of the packets given to the output. Empty if not digested.
+	std::vector< DetectedSegment > _silenceSegments;  ///< Silence detected in the decoded frames (see Transcoder::setContentDetection). Empty if not detected.
+
+	//@{
+	// @brief Time spent and data processed in each stage of the process of the stream.
+	StageStat _demuxStat;  ///< Packets read from the input stream (empty for a generated stream)
+	StageStat _decodeStat;  ///< Frames decoded or generated (without the time spent to demux the packets)
+	StageStat _convertStat;  ///< Frames converted to the format of the encoder
+	StageStat _encodeStat;  ///< Frames encoded (empty when rewrapping)
+	StageStat _muxStat;  ///< Packets wrapped in the output file
+	//@}
 };
 
 }
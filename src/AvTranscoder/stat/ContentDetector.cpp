@@ -0,0 +1,427 @@
+#include "ContentDetector.hpp"
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+#include <libavutil/samplefmt.h>
+}
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+ #define AVTRANSCODER_CONTENT_DETECTOR_SSE2
+ #include <emmintrin.h>
+#endif
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+namespace avtranscoder
+{
+
+namespace
+{
+
+/**
+ * @brief Returns the number of samples lower or equal to the threshold.
+ */
+template< typename Sample >
+uint64_t countSamplesBelow( const Sample* samples, const size_t nbSamples, const size_t threshold )
+{
+	uint64_t count = 0;
+	for( size_t i = 0; i < nbSamples; ++i )
+	{
+		if( samples[i] <= threshold )
+			++count;
+	}
+	return count;
+}
+
+/**
+ * @brief Returns the sum of the absolute differences of the samples.
+ */
+template< typename Sample >
+uint64_t sumAbsoluteDifferences( const Sample* samples1, const Sample* samples2, const size_t nbSamples )
+{
+	uint64_t sum = 0;
+	for( size_t i = 0; i < nbSamples; ++i )
+		sum += samples1[i] > samples2[i] ? samples1[i] - samples2[i] : samples2[i] - samples1[i];
+	return sum;
+}
+
+#ifdef AVTRANSCODER_CONTENT_DETECTOR_SSE2
+template<>
+uint64_t countSamplesBelow<uint8_t>( const uint8_t* samples, const size_t nbSamples, const size_t threshold )
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i ones = _mm_set1_epi8( 1 );
+	const __m128i thresholdVector = _mm_set1_epi8( static_cast<char>( threshold ) );
+	const size_t vectorSize = nbSamples - nbSamples % 16;
+
+	// the count of each half of the vectors is in a 64 bits lane
+	__m128i count = zero;
+	for( size_t i = 0; i < vectorSize; i += 16 )
+	{
+		const __m128i vector = _mm_loadu_si128( reinterpret_cast<const __m128i*>( samples + i ) );
+		const __m128i isBelow = _mm_cmpeq_epi8( _mm_max_epu8( vector, thresholdVector ), thresholdVector );
+		count = _mm_add_epi64( count, _mm_sad_epu8( _mm_and_si128( isBelow, ones ), zero ) );
+	}
+	uint64_t lanes[2];
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), count );
+
+	uint64_t tailCount = 0;
+	for( size_t i = vectorSize; i < nbSamples; ++i )
+	{
+		if( samples[i] <= threshold )
+			++tailCount;
+	}
+	return lanes[0] + lanes[1] + tailCount;
+}
+
+template<>
+uint64_t sumAbsoluteDifferences<uint8_t>( const uint8_t* samples1, const uint8_t* samples2, const size_t nbSamples )
+{
+	const size_t vectorSize = nbSamples - nbSamples % 16;
+	__m128i sum = _mm_setzero_si128();
+	for( size_t i = 0; i < vectorSize; i += 16 )
+	{
+		const __m128i vector1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( samples1 + i ) );
+		const __m128i vector2 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( samples2 + i ) );
+		sum = _mm_add_epi64( sum, _mm_sad_epu8( vector1, vector2 ) );
+	}
+	uint64_t lanes[2];
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), sum );
+
+	uint64_t tailSum = 0;
+	for( size_t i = vectorSize; i < nbSamples; ++i )
+		tailSum += samples1[i] > samples2[i] ? samples1[i] - samples2[i] : samples2[i] - samples1[i];
+	return lanes[0] + lanes[1] + tailSum;
+}
+#endif
+
+//@{
+/// Returns the absolute amplitude of the audio sample, as a ratio of the full scale
+double getAmplitude( const uint8_t sample ) { return std::abs( static_cast<int>( sample ) - 128 ) / 128.0; }
+double getAmplitude( const int16_t sample ) { return std::abs( static_cast<int>( sample ) ) / 32768.0; }
+double getAmplitude( const int32_t sample ) { return std::fabs( static_cast<double>( sample ) ) / 2147483648.0; }
+double getAmplitude( const float sample ) { return std::fabs( sample ); }
+double getAmplitude( const double sample ) { return std::fabs( sample ); }
+//@}
+
+/**
+ * @brief Returns the peak amplitude of the audio samples, as a ratio of the full scale.
+ */
+template< typename Sample >
+double getPeakAmplitude( const Sample* samples, const size_t nbSamples )
+{
+	double peak = 0;
+	for( size_t i = 0; i < nbSamples; ++i )
+		peak = std::max( peak, getAmplitude( samples[i] ) );
+	return peak;
+}
+
+#ifdef AVTRANSCODER_CONTENT_DETECTOR_SSE2
+template<>
+double getPeakAmplitude<int16_t>( const int16_t* samples, const size_t nbSamples )
+{
+	const __m128i zero = _mm_setzero_si128();
+	const size_t vectorSize = nbSamples - nbSamples % 8;
+
+	// the absolute value of -32768 saturates to 32767
+	__m128i peak = zero;
+	for( size_t i = 0; i < vectorSize; i += 8 )
+	{
+		const __m128i vector = _mm_loadu_si128( reinterpret_cast<const __m128i*>( samples + i ) );
+		peak = _mm_max_epi16( peak, _mm_max_epi16( vector, _mm_subs_epi16( zero, vector ) ) );
+	}
+	int16_t lanes[8];
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), peak );
+
+	int peakValue = 0;
+	for( size_t i = 0; i < 8; ++i )
+		peakValue = std::max( peakValue, static_cast<int>( lanes[i] ) );
+	for( size_t i = vectorSize; i < nbSamples; ++i )
+		peakValue = std::max( peakValue, std::abs( static_cast<int>( samples[i] ) ) );
+	return peakValue / 32768.0;
+}
+#endif
+
+/**
+ * @brief Returns if the sample at the given index is silent on all the channels.
+ * @param nbSamples: number of samples per channel
+ */
+template< typename Sample >
+bool isSilentSample( const Sample* samples, const size_t index, const size_t nbSamples, const size_t nbChannels, const bool isPlanar, const double noise )
+{
+	for( size_t channel = 0; channel < nbChannels; ++channel )
+	{
+		const Sample sample = isPlanar ? samples[channel * nbSamples + index] : samples[index * nbChannels + channel];
+		if( getAmplitude( sample ) > noise )
+			return false;
+	}
+	return true;
+}
+
+/// Number of samples per channel analysed together to detect the silence
+const size_t silenceBlockSize = 256;
+
+bool isNativeBigEndian()
+{
+	const unsigned short one = 1;
+	return *reinterpret_cast<const unsigned char*>( &one ) == 0;
+}
+
+}
+
+void SegmentBuilder::update( const bool isDetected, const double startTime, const double endTime )
+{
+	if( isDetected )
+	{
+		if( _startTime < 0 )
+			_startTime = startTime;
+	}
+	else
+	{
+		flush( endTime );
+	}
+}
+
+void SegmentBuilder::flush( const double endTime )
+{
+	if( _startTime < 0 )
+		return;
+
+	if( endTime - _startTime >= _minDuration )
+		_segments.push_back( DetectedSegment( _startTime, endTime ) );
+	_startTime = -1;
+}
+
+VideoContentDetector::VideoContentDetector( const VideoFrameDesc& frameDesc, const double frameRate )
+	: _frameDesc( frameDesc )
+	, _frameDuration( frameRate > 0 ? 1. / frameRate : 0 )
+	, _startTime( 0 )
+	, _sampleSize( 0 )
+	, _maxValue( 0 )
+	, _isFullRange( false )
+	, _blackThreshold( 0 )
+	, _blackPictureRatio( 0 )
+	, _freezeNoise( 0 )
+	, _previousLuma()
+	, _nbProcessedFrames( 0 )
+	, _blackSegments()
+	, _freezeSegments()
+{
+	// a luma plane first, with samples of 8 to 16 bits in native byte order
+	const AVPixFmtDescriptor* pixFmtDesc = av_pix_fmt_desc_get( _frameDesc.getPixelFormat() );
+	if( pixFmtDesc && pixFmtDesc->nb_components &&
+		! ( pixFmtDesc->flags & ( AV_PIX_FMT_FLAG_PAL | AV_PIX_FMT_FLAG_BITSTREAM | AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_RGB ) ) &&
+		( ( pixFmtDesc->flags & AV_PIX_FMT_FLAG_PLANAR ) || pixFmtDesc->nb_components == 1 ) &&
+		pixFmtDesc->comp[0].plane == 0 && pixFmtDesc->comp[0].shift == 0 )
+	{
+		const size_t depth = pixFmtDesc->comp[0].depth_minus1 + 1;
+		const bool isNativeByteOrder = ( ( pixFmtDesc->flags & AV_PIX_FMT_FLAG_BE ) != 0 ) == isNativeBigEndian();
+		if( depth == 8 || ( depth > 8 && depth <= 16 && isNativeByteOrder ) )
+		{
+			_sampleSize = depth > 8 ? 2 : 1;
+			_maxValue = ( 1 << depth ) - 1;
+			_isFullRange = pixFmtDesc->nb_components == 1 || ! strncmp( pixFmtDesc->name, "yuvj", 4 );
+		}
+	}
+	if( ! isSupported() )
+		LOG_WARN( "Unable to detect the black and frozen frames in " << _frameDesc.getPixelFormatName() )
+
+	setBlackThresholds( 0.1, 0.98 );
+	setFreezeThreshold( 0.001 );
+}
+
+void VideoContentDetector::setBlackThresholds( const double pixelThreshold, const double pictureRatio )
+{
+	// limited range: from 16 to 235 in 8 bits
+	const double scale = ( _maxValue + 1 ) / 256.;
+	if( _isFullRange )
+		_blackThreshold = static_cast<size_t>( pixelThreshold * _maxValue );
+	else
+		_blackThreshold = static_cast<size_t>( ( 16 + pixelThreshold * ( 235 - 16 ) ) * scale );
+	_blackPictureRatio = pictureRatio;
+}
+
+void VideoContentDetector::setFreezeThreshold( const double noise )
+{
+	_freezeNoise = noise;
+}
+
+void VideoContentDetector::setMinDuration( const double minDuration )
+{
+	_blackSegments.setMinDuration( minDuration );
+	_freezeSegments.setMinDuration( minDuration );
+}
+
+void VideoContentDetector::process( const Frame& frame )
+{
+	if( ! isSupported() )
+		return;
+
+	// the luma plane is at the beginning of the data of the frame
+	const size_t nbSamples = _frameDesc.getWidth() * _frameDesc.getHeight();
+	const size_t lumaSize = nbSamples * _sampleSize;
+	if( frame.getSize() < lumaSize || ! nbSamples )
+	{
+		LOG_WARN( "Unable to detect the content of a frame of " << frame.getSize() << " bytes" )
+		return;
+	}
+
+	const double time = _startTime + _nbProcessedFrames * _frameDuration;
+	const unsigned char* luma = frame.getData();
+
+	uint64_t nbBlackSamples = 0;
+	if( _sampleSize == 1 )
+		nbBlackSamples = countSamplesBelow( luma, nbSamples, _blackThreshold );
+	else
+		nbBlackSamples = countSamplesBelow( reinterpret_cast<const uint16_t*>( luma ), nbSamples, _blackThreshold );
+	_blackSegments.update( nbBlackSamples >= _blackPictureRatio * nbSamples, time, time );
+
+	// a frozen segment starts at the frame repeated by the next ones
+	if( ! _previousLuma.empty() )
+	{
+		uint64_t difference = 0;
+		if( _sampleSize == 1 )
+			difference = sumAbsoluteDifferences( luma, &_previousLuma[0], nbSamples );
+		else
+			difference = sumAbsoluteDifferences( reinterpret_cast<const uint16_t*>( luma ), reinterpret_cast<const uint16_t*>( &_previousLuma[0] ), nbSamples );
+		_freezeSegments.update( difference <= _freezeNoise * _maxValue * nbSamples, time - _frameDuration, time );
+	}
+	_previousLuma.assign( luma, luma + lumaSize );
+
+	++_nbProcessedFrames;
+}
+
+void VideoContentDetector::flush()
+{
+	const double endTime = _startTime + _nbProcessedFrames * _frameDuration;
+	_blackSegments.flush( endTime );
+	_freezeSegments.flush( endTime );
+}
+
+AudioContentDetector::AudioContentDetector( const AudioFrameDesc& frameDesc )
+	: _frameDesc( frameDesc )
+	, _startTime( 0 )
+	, _noise( 0.001 )
+	, _nbProcessedSamples( 0 )
+	, _silenceSegments()
+{
+	if( ! isSupported() )
+		LOG_WARN( "Unable to detect the silence in " << _frameDesc.getSampleFormatName() << " samples" )
+}
+
+void AudioContentDetector::setSilenceThreshold( const double noise )
+{
+	_noise = noise;
+}
+
+bool AudioContentDetector::isSupported() const
+{
+	if( ! _frameDesc.getChannels() || ! _frameDesc.getSampleRate() )
+		return false;
+
+	switch( av_get_packed_sample_fmt( _frameDesc.getSampleFormat() ) )
+	{
+		case AV_SAMPLE_FMT_U8:
+		case AV_SAMPLE_FMT_S16:
+		case AV_SAMPLE_FMT_S32:
+		case AV_SAMPLE_FMT_FLT:
+		case AV_SAMPLE_FMT_DBL:
+			return true;
+		default:
+			return false;
+	}
+}
+
+void AudioContentDetector::process( const Frame& frame )
+{
+	if( ! isSupported() )
+		return;
+
+	const size_t nbSamples = frame.getSize() / ( _frameDesc.getChannels() * av_get_bytes_per_sample( _frameDesc.getSampleFormat() ) );
+	switch( av_get_packed_sample_fmt( _frameDesc.getSampleFormat() ) )
+	{
+		case AV_SAMPLE_FMT_U8:
+			processSamples<uint8_t>( frame.getData(), nbSamples );
+			break;
+		case AV_SAMPLE_FMT_S16:
+			processSamples<int16_t>( frame.getData(), nbSamples );
+			break;
+		case AV_SAMPLE_FMT_S32:
+			processSamples<int32_t>( frame.getData(), nbSamples );
+			break;
+		case AV_SAMPLE_FMT_FLT:
+			processSamples<float>( frame.getData(), nbSamples );
+			break;
+		case AV_SAMPLE_FMT_DBL:
+			processSamples<double>( frame.getData(), nbSamples );
+			break;
+		default:
+			break;
+	}
+	_nbProcessedSamples += nbSamples;
+}
+
+template< typename Sample >
+void AudioContentDetector::processSamples( const unsigned char* data, const size_t nbSamples )
+{
+	const Sample* samples = reinterpret_cast<const Sample*>( data );
+	const size_t nbChannels = _frameDesc.getChannels();
+	const double sampleRate = _frameDesc.getSampleRate();
+
+	// most of the frames are silent or not from their first to their last sample
+	const double time = _startTime + _nbProcessedSamples / sampleRate;
+	if( getPeakAmplitude( samples, nbSamples * nbChannels ) <= _noise )
+	{
+		_silenceSegments.update( true, time, time );
+		return;
+	}
+
+	// the silence inside a block which is not silent is shorter than a block: it is not searched if the segments are longer
+	const bool isPlanar = av_sample_fmt_is_planar( _frameDesc.getSampleFormat() );
+	const size_t blockSize = _silenceSegments.getMinDuration() * sampleRate >= silenceBlockSize ? silenceBlockSize : 1;
+	for( size_t blockStart = 0; blockStart < nbSamples; blockStart += blockSize )
+	{
+		const size_t blockEnd = std::min( blockStart + blockSize, nbSamples );
+		double peak = 0;
+		if( isPlanar )
+		{
+			for( size_t channel = 0; channel < nbChannels; ++channel )
+				peak = std::max( peak, getPeakAmplitude( samples + channel * nbSamples + blockStart, blockEnd - blockStart ) );
+		}
+		else
+			peak = getPeakAmplitude( samples + blockStart * nbChannels, ( blockEnd - blockStart ) * nbChannels );
+
+		if( peak <= _noise )
+		{
+			const double blockTime = _startTime + ( _nbProcessedSamples + blockStart ) / sampleRate;
+			_silenceSegments.update( true, blockTime, blockTime );
+			continue;
+		}
+
+		// the current segment ends at the first loud sample, and the next one can start after the last loud sample
+		size_t firstLoudSample = blockStart;
+		while( isSilentSample( samples, firstLoudSample, nbSamples, nbChannels, isPlanar, _noise ) )
+			++firstLoudSample;
+		size_t lastLoudSample = blockEnd - 1;
+		while( isSilentSample( samples, lastLoudSample, nbSamples, nbChannels, isPlanar, _noise ) )
+			--lastLoudSample;
+
+		const double endTime = _startTime + ( _nbProcessedSamples + firstLoudSample ) / sampleRate;
+		_silenceSegments.update( false, endTime, endTime );
+		if( lastLoudSample + 1 < blockEnd )
+		{
+			const double startTime = _startTime + ( _nbProcessedSamples + lastLoudSample + 1 ) / sampleRate;
+			_silenceSegments.update( true, startTime, startTime );
+		}
+	}
+}
+
+void AudioContentDetector::flush()
+{
+	_silenceSegments.flush( _startTime + _nbProcessedSamples / static_cast<double>( _frameDesc.getSampleRate() ) );
+}
+
+}
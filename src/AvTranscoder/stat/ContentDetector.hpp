@@ -0,0 +1,179 @@
+#ifndef _AV_TRANSCODER_STAT_CONTENT_DETECTOR_HPP_
+#define _AV_TRANSCODER_STAT_CONTENT_DETECTOR_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/frame/VideoFrame.hpp>
+#include <AvTranscoder/frame/AudioFrame.hpp>
+#include <AvTranscoder/stat/DetectedSegment.hpp>
+
+#include <vector>
+
+namespace avtranscoder
+{
+
+/// Default minimum duration, in seconds, of a detected segment
+const double defaultMinDetectedDuration = 2.0;
+
+/**
+ * @brief Build the segments of consecutive detected frames, which last at least a minimum duration.
+ */
+class AvExport SegmentBuilder
+{
+public:
+	SegmentBuilder()
+	: _minDuration( defaultMinDetectedDuration )
+	, _startTime( -1 )
+	, _segments()
+	{}
+
+	/**
+	 * @param startTime: start of the segment if the frame is the first detected one
+	 * @param endTime: end of the segment if the frame is the first one not detected
+	 */
+	void update( const bool isDetected, const double startTime, const double endTime );
+
+	/**
+	 * @brief End the current segment at the given time.
+	 */
+	void flush( const double endTime );
+
+	void setMinDuration( const double minDuration ) { _minDuration = minDuration; }
+	double getMinDuration() const { return _minDuration; }
+
+	const std::vector< DetectedSegment >& getSegments() const { return _segments; }
+
+private:
+	double _minDuration;
+	double _startTime;  ///< Start of the current segment (<0 if no current segment)
+	std::vector< DetectedSegment > _segments;
+};
+
+/**
+ * @brief Detect the black and the frozen frames of a video stream, from the statistics of their luma plane.
+ * Like the blackdetect and freezedetect filters of ffmpeg, on frames already decoded.
+ * @note Only the YUV and gray pixel formats with samples of 8 to 16 bits are analysed (see isSupported).
+ */
+class AvExport VideoContentDetector
+{
+public:
+	/**
+	 * @param frameRate: to get the time of the frames, from the first given frame
+	 */
+	VideoContentDetector( const VideoFrameDesc& frameDesc, const double frameRate );
+
+	/// Time of the first given frame in the stream, in seconds, added to the time of the segments (by default 0)
+	void setStartTime( const double startTime ) { _startTime = startTime; }
+
+	/**
+	 * @param pixelThreshold: a luma sample is black below this ratio of the luma range (by default 0.1)
+	 * @param pictureRatio: a frame is black if this ratio of its luma samples are black (by default 0.98)
+	 */
+	void setBlackThresholds( const double pixelThreshold, const double pictureRatio );
+
+	/**
+	 * @param noise: a frame is frozen if its mean absolute luma difference with the previous frame is below this ratio of the luma range
+	 * (by default 0.001, -60dB)
+	 */
+	void setFreezeThreshold( const double noise );
+
+	/// Minimum duration of the detected segments, in seconds (by default 2)
+	void setMinDuration( const double minDuration );
+
+	/**
+	 * @brief Returns if the frames can be analysed.
+	 */
+	bool isSupported() const { return _sampleSize != 0; }
+
+	/**
+	 * @brief Analyse the next frame of the stream (a frame of the description given at the construction).
+	 */
+	void process( const Frame& frame );
+
+	/**
+	 * @brief End the current segments at the end of the last frame.
+	 */
+	void flush();
+
+	const std::vector< DetectedSegment >& getBlackSegments() const { return _blackSegments.getSegments(); }
+	const std::vector< DetectedSegment >& getFreezeSegments() const { return _freezeSegments.getSegments(); }
+
+	size_t getNbProcessedFrames() const { return _nbProcessedFrames; }
+
+private:
+	const VideoFrameDesc _frameDesc;
+	const double _frameDuration;  ///< In seconds
+	double _startTime;  ///< Time of the first processed frame, in seconds
+	size_t _sampleSize;  ///< Size of a luma sample in bytes (0 if the frames can't be analysed)
+	size_t _maxValue;  ///< Maximum value of a luma sample
+	bool _isFullRange;  ///< If the luma samples use the full range of values
+
+	size_t _blackThreshold;  ///< Maximum value of a black luma sample
+	double _blackPictureRatio;
+	double _freezeNoise;
+
+	std::vector< unsigned char > _previousLuma;  ///< Luma plane of the previous frame
+	size_t _nbProcessedFrames;
+	SegmentBuilder _blackSegments;
+	SegmentBuilder _freezeSegments;
+};
+
+/**
+ * @brief Detect the silence of an audio stream: the samples of all the channels are below a noise level.
+ * Like the silencedetect filter of ffmpeg, on frames already decoded.
+ * @note The samples of integer and floating point formats are analysed, packed or planar.
+ * @note The samples are analysed by blocks, from the peak of their samples (vectorized for s16):
+ * only the first and the last loud samples of the blocks which are not silent are searched one by one.
+ */
+class AvExport AudioContentDetector
+{
+public:
+	AudioContentDetector( const AudioFrameDesc& frameDesc );
+
+	/// Time of the first given sample in the stream, in seconds, added to the time of the segments (by default 0)
+	void setStartTime( const double startTime ) { _startTime = startTime; }
+
+	/**
+	 * @param noise: a sample is silent if its absolute amplitude is below this ratio of the full scale (by default 0.001, -60dB)
+	 */
+	void setSilenceThreshold( const double noise );
+
+	/// Minimum duration of the detected segments, in seconds (by default 2)
+	void setMinDuration( const double minDuration ) { _silenceSegments.setMinDuration( minDuration ); }
+
+	/**
+	 * @brief Returns if the samples can be analysed.
+	 */
+	bool isSupported() const;
+
+	/**
+	 * @brief Analyse the next frame of the stream (samples of the description given at the construction).
+	 */
+	void process( const Frame& frame );
+
+	/**
+	 * @brief End the current segment at the end of the last sample.
+	 */
+	void flush();
+
+	const std::vector< DetectedSegment >& getSilenceSegments() const { return _silenceSegments.getSegments(); }
+
+	size_t getNbProcessedSamples() const { return _nbProcessedSamples; }
+
+private:
+	/**
+	 * @brief Detect the silent samples of the frame, in the given format.
+	 */
+	template< typename Sample >
+	void processSamples( const unsigned char* data, const size_t nbSamples );
+
+private:
+	const AudioFrameDesc _frameDesc;
+	double _startTime;  ///< Time of the first processed sample, in seconds
+	double _noise;
+	size_t _nbProcessedSamples;  ///< Number of samples per channel
+	SegmentBuilder _silenceSegments;
+};
+
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _AV_TRANSCODER_STAT_DETECTED_SEGMENT_HPP_
+#define _AV_TRANSCODER_STAT_DETECTED_SEGMENT_HPP_
+
+#include <AvTranscoder/common.hpp>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief A part of a stream in which some content is detected (black or frozen frames, silence...).
+ * @see VideoContentDetector
+ * @see AudioContentDetector
+ */
+class AvExport DetectedSegment
+{
+public:
+	DetectedSegment( const double startTime = 0, const double endTime = 0 )
+	: _startTime( startTime )
+	, _endTime( endTime )
+	{}
+
+	double getDuration() const { return _endTime - _startTime; }
+
+public:
+	double _startTime;  ///< Time in seconds of the first detected frame, from the first analysed frame of the stream
+	double _endTime;  ///< Time in seconds of the end of the last detected frame
+};
+
+}
+
+#endif
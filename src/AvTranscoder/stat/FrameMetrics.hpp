@@ -0,0 +1,64 @@
+#ifndef _AV_TRANSCODER_STAT_FRAME_METRICS_HPP_
+#define _AV_TRANSCODER_STAT_FRAME_METRICS_HPP_
+
+#include <AvTranscoder/common.hpp>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Metrics of a packet given to an output stream (encoded or rewrapped).
+ * @see IMetricsObserver
+ */
+class AvExport FrameMetrics
+{
+public:
+	FrameMetrics()
+	: _streamIndex( 0 )
+	, _frame( 0 )
+	, _time( 0 )
+	, _size( 0 )
+	, _quality( 0 )
+	, _qp( 0 )
+	, _pictureType( '?' )
+	, _isKeyFrame( false )
+	, _decodeTime( 0 )
+	, _convertTime( 0 )
+	, _encodeTime( 0 )
+	, _wrapTime( 0 )
+	, _nbCachedPackets( 0 )
+	, _nbEncoderFrames( 0 )
+	{}
+
+public:
+	size_t _streamIndex;  ///< Index of the output stream
+	size_t _frame;  ///< Number of the packet in the output stream, from 0
+	double _time;  ///< Duration of the output stream after the packet, in seconds
+
+	//@{
+	// @brief Result of the encoder (or of the input stream when rewrapping).
+	size_t _size;  ///< Size of the packet in bytes
+	int _quality;  ///< Lambda of the encoded picture, between 1 (good) and FF_LAMBDA_MAX (bad). 0 if unknown.
+	double _qp;  ///< Quantizer of the encoded picture, from its lambda. 0 if unknown.
+	char _pictureType;  ///< 'I', 'P', 'B'... of the encoded picture ('?' if unknown)
+	bool _isKeyFrame;
+	//@}
+
+	//@{
+	// @brief Time in seconds spent in each stage of the process of the last frame given to the stream (0 if not called).
+	double _decodeTime;  ///< Without the time spent to demux the packets
+	double _convertTime;
+	double _encodeTime;
+	double _wrapTime;
+	//@}
+
+	//@{
+	// @brief Depth of the queues of the stream.
+	size_t _nbCachedPackets;  ///< Packets of the input stream read by the input file, and waiting to be processed
+	size_t _nbEncoderFrames;  ///< Frames given to the encoder, and waiting to be encoded
+	//@}
+};
+
+}
+
+#endif
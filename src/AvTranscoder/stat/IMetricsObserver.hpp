@@ -0,0 +1,33 @@
+#ifndef _AV_TRANSCODER_STAT_I_METRICS_OBSERVER_HPP_
+#define _AV_TRANSCODER_STAT_I_METRICS_OBSERVER_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/stat/FrameMetrics.hpp>
+
+#include <vector>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Base class to receive the metrics of the frames while they are processed (to feed a dashboard...).
+ * The metrics are sampled, and delivered by batches, to bound the cost of the calls.
+ * You can inherit this class in C++, but also in python / Java binding (the instance has to be kept alive during the process).
+ * @see Transcoder::setMetricsObserver
+ */
+class AvExport IMetricsObserver
+{
+public:
+	virtual ~IMetricsObserver() {};
+
+	/**
+	 * @brief Receive the metrics of the last sampled frames of a stream.
+	 * @param metrics: in the order of the frames in the output stream
+	 * @note Called by the thread of the process.
+	 */
+	virtual void onFrameMetrics( const std::vector< FrameMetrics >& metrics ) = 0;
+};
+
+}
+
+#endif
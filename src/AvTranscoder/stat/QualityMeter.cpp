@@ -0,0 +1,627 @@
+#include "QualityMeter.hpp"
+
+#include <AvTranscoder/stat/VideoStat.hpp>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+#include <libavutil/mem.h>
+#include <libavutil/time.h>
+}
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+ #define AVTRANSCODER_QUALITY_METER_SSE2
+ #include <emmintrin.h>
+#endif
+
+#include <stdexcept>
+#include <cstring>
+#include <algorithm>
+
+#ifndef FF_INPUT_BUFFER_PADDING_SIZE
+ #define FF_INPUT_BUFFER_PADDING_SIZE 16
+#endif
+
+namespace avtranscoder
+{
+
+namespace
+{
+
+/// Sums of a block of 4x4 samples of two planes, to compute their SSIM
+struct BlockSums
+{
+	int64_t _sum1;  ///< Sum of the samples of the first plane
+	int64_t _sum2;  ///< Sum of the samples of the second plane
+	int64_t _squareSum;  ///< Sum of the squares of the samples of both planes
+	int64_t _productSum;  ///< Sum of the products of the samples of the first plane by the samples of the second plane
+};
+
+/**
+ * @param step: number of samples from a sample to the next one in the lines
+ */
+template< typename Sample >
+uint64_t scalarSquaredError( const Sample* line1, const Sample* line2, const size_t width, const size_t step = 1 )
+{
+	uint64_t error = 0;
+	for( size_t x = 0; x < width; ++x )
+	{
+		const int64_t difference = static_cast<int64_t>( line1[x * step] ) - line2[x * step];
+		error += difference * difference;
+	}
+	return error;
+}
+
+/**
+ * @param step: number of samples from a sample to the next one in the lines
+ */
+template< typename Sample >
+void scalarBlockSums( const Sample* block1, const Sample* block2, const size_t lineSize, BlockSums& sums, const size_t step = 1 )
+{
+	sums._sum1 = sums._sum2 = sums._squareSum = sums._productSum = 0;
+	for( size_t y = 0; y < 4; ++y )
+	{
+		for( size_t x = 0; x < 4; ++x )
+		{
+			const int64_t sample1 = block1[y * lineSize + x * step];
+			const int64_t sample2 = block2[y * lineSize + x * step];
+			sums._sum1 += sample1;
+			sums._sum2 += sample2;
+			sums._squareSum += sample1 * sample1 + sample2 * sample2;
+			sums._productSum += sample1 * sample2;
+		}
+	}
+}
+
+/**
+ * @brief Returns the sum of the squared differences of the samples of two lines.
+ */
+template< typename Sample >
+uint64_t squaredError( const Sample* line1, const Sample* line2, const size_t width )
+{
+	return scalarSquaredError( line1, line2, width );
+}
+
+/**
+ * @brief Compute the sums of two adjacent blocks of 4x4 samples.
+ * @param lineSize: in samples
+ */
+template< typename Sample >
+void blockSums4x4x2( const Sample* block1, const Sample* block2, const size_t lineSize, BlockSums sums[2] )
+{
+	scalarBlockSums( block1, block2, lineSize, sums[0] );
+	scalarBlockSums( block1 + 4, block2 + 4, lineSize, sums[1] );
+}
+
+#ifdef AVTRANSCODER_QUALITY_METER_SSE2
+template<>
+uint64_t squaredError<uint8_t>( const uint8_t* line1, const uint8_t* line2, const size_t width )
+{
+	const __m128i zero = _mm_setzero_si128();
+	const size_t vectorWidth = width - width % 16;
+	uint64_t error = 0;
+	size_t x = 0;
+	while( x < vectorWidth )
+	{
+		// each 32 bits lane adds at most 4 * 255^2 per iteration: add the lanes to the error before they overflow
+		const size_t end = std::min( vectorWidth, x + 16 * 2048 );
+		__m128i sum = zero;
+		for( ; x < end; x += 16 )
+		{
+			const __m128i samples1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( line1 + x ) );
+			const __m128i samples2 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( line2 + x ) );
+			const __m128i lowDifference = _mm_sub_epi16( _mm_unpacklo_epi8( samples1, zero ), _mm_unpacklo_epi8( samples2, zero ) );
+			const __m128i highDifference = _mm_sub_epi16( _mm_unpackhi_epi8( samples1, zero ), _mm_unpackhi_epi8( samples2, zero ) );
+			sum = _mm_add_epi32( sum, _mm_madd_epi16( lowDifference, lowDifference ) );
+			sum = _mm_add_epi32( sum, _mm_madd_epi16( highDifference, highDifference ) );
+		}
+		uint32_t lanes[4];
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), sum );
+		error += static_cast<uint64_t>( lanes[0] ) + lanes[1] + lanes[2] + lanes[3];
+	}
+	return error + scalarSquaredError( line1 + vectorWidth, line2 + vectorWidth, width - vectorWidth );
+}
+
+template<>
+void blockSums4x4x2<uint8_t>( const uint8_t* block1, const uint8_t* block2, const size_t lineSize, BlockSums sums[2] )
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i ones = _mm_set1_epi16( 1 );
+	__m128i sum1 = zero;
+	__m128i sum2 = zero;
+	__m128i squareSum = zero;
+	__m128i productSum = zero;
+	for( size_t y = 0; y < 4; ++y )
+	{
+		// 8 samples of each plane: the lanes 0 and 1 of the sums are the first block, the lanes 2 and 3 the second block
+		const __m128i samples1 = _mm_unpacklo_epi8( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( block1 + y * lineSize ) ), zero );
+		const __m128i samples2 = _mm_unpacklo_epi8( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( block2 + y * lineSize ) ), zero );
+		sum1 = _mm_add_epi32( sum1, _mm_madd_epi16( samples1, ones ) );
+		sum2 = _mm_add_epi32( sum2, _mm_madd_epi16( samples2, ones ) );
+		squareSum = _mm_add_epi32( squareSum, _mm_add_epi32( _mm_madd_epi16( samples1, samples1 ), _mm_madd_epi16( samples2, samples2 ) ) );
+		productSum = _mm_add_epi32( productSum, _mm_madd_epi16( samples1, samples2 ) );
+	}
+
+	int32_t lanes[4];
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), sum1 );
+	sums[0]._sum1 = lanes[0] + lanes[1];
+	sums[1]._sum1 = lanes[2] + lanes[3];
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), sum2 );
+	sums[0]._sum2 = lanes[0] + lanes[1];
+	sums[1]._sum2 = lanes[2] + lanes[3];
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), squareSum );
+	sums[0]._squareSum = lanes[0] + lanes[1];
+	sums[1]._squareSum = lanes[2] + lanes[3];
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), productSum );
+	sums[0]._productSum = lanes[0] + lanes[1];
+	sums[1]._productSum = lanes[2] + lanes[3];
+}
+#endif
+
+/**
+ * @brief Returns the sum of the squared differences of the samples of two planes.
+ * @param lineSize: in bytes
+ * @param step: number of samples from a sample to the next one in the lines (the interleaved components are not vectorized)
+ */
+template< typename Sample >
+uint64_t planeSquaredError( const unsigned char* plane1, const unsigned char* plane2, const size_t width, const size_t height, const size_t lineSize, const size_t step )
+{
+	uint64_t error = 0;
+	for( size_t y = 0; y < height; ++y )
+	{
+		const Sample* line1 = reinterpret_cast<const Sample*>( plane1 + y * lineSize );
+		const Sample* line2 = reinterpret_cast<const Sample*>( plane2 + y * lineSize );
+		error += step == 1 ? squaredError( line1, line2, width ) : scalarSquaredError( line1, line2, width, step );
+	}
+	return error;
+}
+
+/**
+ * @brief Returns the SSIM of a window of 8x8 samples, from the sums of its 2x2 blocks.
+ */
+double windowSsim( const BlockSums* topBlocks, const BlockSums* bottomBlocks, const double c1, const double c2 )
+{
+	const double sum1 = topBlocks[0]._sum1 + topBlocks[1]._sum1 + bottomBlocks[0]._sum1 + bottomBlocks[1]._sum1;
+	const double sum2 = topBlocks[0]._sum2 + topBlocks[1]._sum2 + bottomBlocks[0]._sum2 + bottomBlocks[1]._sum2;
+	const double squareSum = topBlocks[0]._squareSum + topBlocks[1]._squareSum + bottomBlocks[0]._squareSum + bottomBlocks[1]._squareSum;
+	const double productSum = topBlocks[0]._productSum + topBlocks[1]._productSum + bottomBlocks[0]._productSum + bottomBlocks[1]._productSum;
+
+	// sums of 64 samples: the means, variances and covariance are scaled by 64 and 64^2
+	const double variances = squareSum * 64 - sum1 * sum1 - sum2 * sum2;
+	const double covariance = productSum * 64 - sum1 * sum2;
+	return ( 2 * sum1 * sum2 + c1 ) * ( 2 * covariance + c2 ) / ( ( sum1 * sum1 + sum2 * sum2 + c1 ) * ( variances + c2 ) );
+}
+
+/**
+ * @brief Returns the SSIM of two planes: the average SSIM of the windows of 8x8 samples, overlapping every 4 samples.
+ * @param lineSize: in bytes
+ * @param step: number of samples from a sample to the next one in the lines (the interleaved components are not vectorized)
+ * @note The planes smaller than 8x8 samples have a SSIM of 1.
+ */
+template< typename Sample >
+double planeSsim( const unsigned char* plane1, const unsigned char* plane2, const size_t width, const size_t height, const size_t lineSize, const size_t step, const int maxValue )
+{
+	const size_t nbBlocksX = width / 4;
+	const size_t nbBlocksY = height / 4;
+	if( nbBlocksX < 2 || nbBlocksY < 2 )
+		return 1.0;
+
+	const double c1 = ( 0.01 * maxValue * 64 ) * ( 0.01 * maxValue * 64 );
+	const double c2 = ( 0.03 * maxValue * 64 ) * ( 0.03 * maxValue * 64 );
+	const size_t sampleLineSize = lineSize / sizeof( Sample );
+
+	std::vector< BlockSums > previousRow( nbBlocksX );
+	std::vector< BlockSums > row( nbBlocksX );
+	double ssim = 0;
+	for( size_t blockY = 0; blockY < nbBlocksY; ++blockY )
+	{
+		const Sample* line1 = reinterpret_cast<const Sample*>( plane1 + 4 * blockY * lineSize );
+		const Sample* line2 = reinterpret_cast<const Sample*>( plane2 + 4 * blockY * lineSize );
+		size_t blockX = 0;
+		if( step == 1 )
+		{
+			for( ; blockX + 1 < nbBlocksX; blockX += 2 )
+				blockSums4x4x2( line1 + 4 * blockX, line2 + 4 * blockX, sampleLineSize, &row[blockX] );
+		}
+		for( ; blockX < nbBlocksX; ++blockX )
+			scalarBlockSums( line1 + 4 * blockX * step, line2 + 4 * blockX * step, sampleLineSize, row[blockX], step );
+
+		if( blockY )
+		{
+			for( blockX = 0; blockX + 1 < nbBlocksX; ++blockX )
+				ssim += windowSsim( &previousRow[blockX], &row[blockX], c1, c2 );
+		}
+		previousRow.swap( row );
+	}
+	return ssim / ( ( nbBlocksX - 1 ) * ( nbBlocksY - 1 ) );
+}
+
+bool isNativeBigEndian()
+{
+	const unsigned short one = 1;
+	return *reinterpret_cast<const unsigned char*>( &one ) == 0;
+}
+
+}
+
+QualityMeter::QualityMeter( const VideoCodec& encoderCodec, const VideoFrameDesc& frameDesc, const size_t maxNbQueuedPackets, const size_t maxNbBufferedPackets )
+	: _frameDesc( frameDesc )
+	, _decoderCodec( eCodecTypeDecoder, encoderCodec.getCodecId() )
+	, _decodedAVFrame( NULL )
+	, _decodedFrame( frameDesc )
+	, _planes()
+	, _maxNbQueuedPackets( maxNbQueuedPackets )
+	, _maxNbBufferedPackets( std::max( maxNbBufferedPackets, maxNbQueuedPackets ) )
+	, _thread()
+	, _packets()
+	, _sourceFrames()
+	, _unusedFrames()
+	, _isDecoding( false )
+	, _isStopping( false )
+	, _nbMeasuredFrames( 0 )
+	, _nbSkippedFrames( 0 )
+	, _measureTime( 0 )
+	, _copyTime( 0 )
+	, _error()
+{
+	setupPlanes();
+	if( _planes.empty() )
+	{
+		LOG_WARN( "Unable to measure the quality of the frames in " << _frameDesc.getPixelFormatName() )
+		return;
+	}
+
+#if LIBAVCODEC_VERSION_MAJOR > 54
+	_decodedAVFrame = av_frame_alloc();
+#else
+	_decodedAVFrame = avcodec_alloc_frame();
+#endif
+	if( ! _decodedAVFrame )
+		throw std::runtime_error( "Unable to allocate the frame to measure the quality of the encoded frames" );
+
+	// decode the packets as they are wrapped
+	const AVCodecContext& encoderContext = encoderCodec.getAVCodecContext();
+	AVCodecContext& decoderContext = _decoderCodec.getAVCodecContext();
+	decoderContext.width = encoderContext.width;
+	decoderContext.height = encoderContext.height;
+	decoderContext.pix_fmt = encoderContext.pix_fmt;
+	if( encoderContext.extradata_size )
+	{
+		decoderContext.extradata = static_cast<uint8_t*>( av_mallocz( encoderContext.extradata_size + FF_INPUT_BUFFER_PADDING_SIZE ) );
+		memcpy( decoderContext.extradata, encoderContext.extradata, encoderContext.extradata_size );
+		decoderContext.extradata_size = encoderContext.extradata_size;
+	}
+	_decoderCodec.openCodec();
+
+	LOG_INFO( "Measure the quality of the frames encoded by " << encoderCodec.getCodecName() << " (" << _planes.size() << " planes)" )
+	_thread.start( &QualityMeter::run, this );
+}
+
+QualityMeter::~QualityMeter()
+{
+	{
+		ScopedLock lock( _mutex );
+		_isStopping = true;
+	}
+	_packetQueued.notifyAll();
+	_thread.join();
+
+	for( std::deque< CodedData* >::iterator it = _packets.begin(); it != _packets.end(); ++it )
+		delete (*it);
+	for( std::deque< VideoFrame* >::iterator it = _sourceFrames.begin(); it != _sourceFrames.end(); ++it )
+		delete (*it);
+	for( std::vector< VideoFrame* >::iterator it = _unusedFrames.begin(); it != _unusedFrames.end(); ++it )
+		delete (*it);
+
+	av_freep( &_decoderCodec.getAVCodecContext().extradata );
+	if( _decodedAVFrame )
+	{
+#if LIBAVCODEC_VERSION_MAJOR > 54
+		av_frame_free( &_decodedAVFrame );
+#else
+ #if LIBAVCODEC_VERSION_MAJOR > 53
+		avcodec_free_frame( &_decodedAVFrame );
+ #else
+		av_free( _decodedAVFrame );
+ #endif
+#endif
+	}
+}
+
+void QualityMeter::addSourceFrame( const VideoFrame& frame )
+{
+	if( ! _thread.isRunning() )
+		return;
+
+	const int64_t startTime = av_gettime();
+	bool isCompared = false;
+	VideoFrame* sourceFrame = NULL;
+	{
+		ScopedLock lock( _mutex );
+		isCompared = _packets.size() < _maxNbQueuedPackets && _error.empty();
+		if( ! isCompared )
+			++_nbSkippedFrames;
+		else if( ! _unusedFrames.empty() )
+		{
+			sourceFrame = _unusedFrames.back();
+			_unusedFrames.pop_back();
+		}
+	}
+
+	if( isCompared )
+	{
+		if( ! sourceFrame )
+			sourceFrame = new VideoFrame( _frameDesc );
+		sourceFrame->copyData( const_cast<unsigned char*>( frame.getData() ), frame.getSize() );
+	}
+	{
+		ScopedLock lock( _mutex );
+		_sourceFrames.push_back( sourceFrame );
+		_copyTime += av_gettime() - startTime;
+	}
+}
+
+void QualityMeter::addEncodedData( const CodedData& data )
+{
+	if( ! _thread.isRunning() || ! data.getSize() )
+		return;
+
+	const int64_t startTime = av_gettime();
+	CodedData* queuedData = new CodedData( data );
+	{
+		ScopedLock lock( _mutex );
+		// bound the memory of the queued packets (the side thread still pops the packets after an error)
+		while( _packets.size() >= _maxNbBufferedPackets )
+			_packetDecoded.wait( _mutex );
+		_packets.push_back( queuedData );
+		_copyTime += av_gettime() - startTime;
+	}
+	_packetQueued.notifyOne();
+}
+
+void QualityMeter::flush()
+{
+	if( ! _thread.isRunning() )
+		return;
+
+	ScopedLock lock( _mutex );
+	_packets.push_back( NULL );
+	_packetQueued.notifyOne();
+	while( ! _packets.empty() || _isDecoding )
+		_packetDecoded.wait( _mutex );
+
+	if( ! _error.empty() )
+		LOG_ERROR( "Unable to measure the quality of all the encoded frames: " << _error )
+	LOG_INFO( "Quality of " << _nbMeasuredFrames << " frames measured in " << _measureTime / 1000000.0 << "s on a side thread (" <<
+		_copyTime / 1000000.0 << "s to copy the data, " << _nbSkippedFrames << " frames skipped)" )
+}
+
+double QualityMeter::getPsnr( const size_t plane ) const
+{
+	ScopedLock lock( _mutex );
+	const Plane& measuredPlane = _planes.at( plane );
+	if( ! _nbMeasuredFrames )
+		return 0;
+	const double meanSquaredError = measuredPlane._squaredError / ( static_cast<double>( _nbMeasuredFrames ) * measuredPlane._width * measuredPlane._height );
+	return VideoStat::psnr( meanSquaredError / ( static_cast<double>( measuredPlane._maxValue ) * measuredPlane._maxValue ) );
+}
+
+double QualityMeter::getSsim( const size_t plane ) const
+{
+	ScopedLock lock( _mutex );
+	const Plane& measuredPlane = _planes.at( plane );
+	if( ! _nbMeasuredFrames )
+		return 0;
+	return measuredPlane._ssim / _nbMeasuredFrames;
+}
+
+size_t QualityMeter::getNbMeasuredFrames() const
+{
+	ScopedLock lock( _mutex );
+	return _nbMeasuredFrames;
+}
+
+size_t QualityMeter::getNbSkippedFrames() const
+{
+	ScopedLock lock( _mutex );
+	return _nbSkippedFrames;
+}
+
+double QualityMeter::getMeasureTime() const
+{
+	ScopedLock lock( _mutex );
+	return _measureTime / 1000000.0;
+}
+
+double QualityMeter::getCopyTime() const
+{
+	ScopedLock lock( _mutex );
+	return _copyTime / 1000000.0;
+}
+
+void QualityMeter::run( void* qualityMeter )
+{
+	static_cast<QualityMeter*>( qualityMeter )->processPackets();
+}
+
+void QualityMeter::processPackets()
+{
+	while( true )
+	{
+		CodedData* data = NULL;
+		{
+			ScopedLock lock( _mutex );
+			while( _packets.empty() && ! _isStopping )
+				_packetQueued.wait( _mutex );
+			if( _packets.empty() )
+				break;
+
+			data = _packets.front();
+			_packets.pop_front();
+			_isDecoding = true;
+		}
+
+		// the error is only set by this thread
+		const int64_t startTime = av_gettime();
+		std::string error;
+		if( _error.empty() )
+		{
+			try
+			{
+				if( data )
+					decode( data );
+				else
+					while( decode( NULL ) ) {}
+			}
+			catch( const std::exception& e )
+			{
+				error = e.what();
+			}
+		}
+		delete data;
+
+		{
+			ScopedLock lock( _mutex );
+			_isDecoding = false;
+			_measureTime += av_gettime() - startTime;
+			if( _error.empty() )
+				_error = error;
+		}
+		_packetDecoded.notifyAll();
+	}
+}
+
+bool QualityMeter::decode( CodedData* data )
+{
+	CodedData emptyData;
+	AVPacket& packet = data ? data->getAVPacket() : emptyData.getAVPacket();
+
+	int gotFrame = 0;
+	const int ret = avcodec_decode_video2( &_decoderCodec.getAVCodecContext(), _decodedAVFrame, &gotFrame, &packet );
+	if( ret < 0 )
+		throw std::runtime_error( "Unable to decode an encoded packet - " + getDescriptionFromErrorCode( ret ) );
+	if( ! gotFrame )
+		return false;
+
+	// the decoded frames are in the same order as the source frames
+	VideoFrame* sourceFrame = NULL;
+	{
+		ScopedLock lock( _mutex );
+		if( _sourceFrames.empty() )
+			throw std::runtime_error( "More frames decoded than encoded" );
+		sourceFrame = _sourceFrames.front();
+		_sourceFrames.pop_front();
+	}
+	if( ! sourceFrame )
+		return true;
+
+	if( _decodedAVFrame->format != _frameDesc.getPixelFormat() || sourceFrame->getSize() != _decodedFrame.getSize() ||
+		_decodedAVFrame->width != (int)_frameDesc.getWidth() || _decodedAVFrame->height != (int)_frameDesc.getHeight() )
+	{
+		releaseSourceFrame( sourceFrame );
+		throw std::runtime_error( "The decoded frames do not have the description of the encoded frames" );
+	}
+
+	avpicture_layout( reinterpret_cast<AVPicture*>( _decodedAVFrame ), _frameDesc.getPixelFormat(), _frameDesc.getWidth(), _frameDesc.getHeight(),
+		_decodedFrame.getData(), _decodedFrame.getSize() );
+	compare( *sourceFrame, _decodedFrame );
+	releaseSourceFrame( sourceFrame );
+	return true;
+}
+
+void QualityMeter::releaseSourceFrame( VideoFrame* frame )
+{
+	ScopedLock lock( _mutex );
+	_unusedFrames.push_back( frame );
+}
+
+void QualityMeter::compare( const VideoFrame& source, const VideoFrame& decoded )
+{
+	for( std::vector< Plane >::iterator plane = _planes.begin(); plane != _planes.end(); ++plane )
+	{
+		const unsigned char* sourcePlane = source.getData() + plane->_offset;
+		const unsigned char* decodedPlane = decoded.getData() + plane->_offset;
+		if( plane->_sampleSize == 1 )
+		{
+			plane->_squaredError += planeSquaredError<uint8_t>( sourcePlane, decodedPlane, plane->_width, plane->_height, plane->_lineSize, plane->_step );
+			plane->_ssim += planeSsim<uint8_t>( sourcePlane, decodedPlane, plane->_width, plane->_height, plane->_lineSize, plane->_step, plane->_maxValue );
+		}
+		else
+		{
+			plane->_squaredError += planeSquaredError<uint16_t>( sourcePlane, decodedPlane, plane->_width, plane->_height, plane->_lineSize, plane->_step );
+			plane->_ssim += planeSsim<uint16_t>( sourcePlane, decodedPlane, plane->_width, plane->_height, plane->_lineSize, plane->_step, plane->_maxValue );
+		}
+	}
+
+	ScopedLock lock( _mutex );
+	++_nbMeasuredFrames;
+}
+
+void QualityMeter::setupPlanes()
+{
+	const AVPixelFormat pixelFormat = _frameDesc.getPixelFormat();
+	const AVPixFmtDescriptor* pixFmtDesc = av_pix_fmt_desc_get( pixelFormat );
+	if( ! pixFmtDesc || ! pixFmtDesc->nb_components ||
+		( pixFmtDesc->flags & ( AV_PIX_FMT_FLAG_PAL | AV_PIX_FMT_FLAG_BITSTREAM | AV_PIX_FMT_FLAG_HWACCEL ) ) )
+		return;
+
+	// samples of 8 to 16 bits, in native byte order, which are not bit fields
+	const size_t depth = pixFmtDesc->comp[0].depth_minus1 + 1;
+	for( size_t component = 0; component < pixFmtDesc->nb_components; ++component )
+	{
+		if( pixFmtDesc->comp[component].depth_minus1 + 1u != depth || pixFmtDesc->comp[component].shift )
+			return;
+	}
+	if( depth < 8 || depth > 16 || ( depth > 8 && ( ( pixFmtDesc->flags & AV_PIX_FMT_FLAG_BE ) != 0 ) != isNativeBigEndian() ) )
+		return;
+	const size_t sampleSize = depth > 8 ? 2 : 1;
+
+	// planes of the contiguous data of the frames, as given by avpicture_layout
+	int lineSizes[4] = { 0, 0, 0, 0 };
+	if( av_image_fill_linesizes( lineSizes, pixelFormat, _frameDesc.getWidth() ) < 0 )
+		return;
+
+	size_t planeOffsets[4] = { 0, 0, 0, 0 };
+	size_t offset = 0;
+	for( size_t planeIndex = 0; planeIndex < 4 && lineSizes[planeIndex] > 0; ++planeIndex )
+	{
+		const size_t chromaShift = ( planeIndex == 1 || planeIndex == 2 ) ? pixFmtDesc->log2_chroma_h : 0;
+		planeOffsets[planeIndex] = offset;
+		offset += lineSizes[planeIndex] * ( ( _frameDesc.getHeight() + ( 1 << chromaShift ) - 1 ) >> chromaShift );
+	}
+	if( offset != _frameDesc.getDataSize() )
+		return;
+
+	// a measured plane per component: the components interleaved in a plane are measured separately
+	std::vector< Plane > planes;
+	for( size_t component = 0; component < pixFmtDesc->nb_components; ++component )
+	{
+		const AVComponentDescriptor& componentDesc = pixFmtDesc->comp[component];
+		const bool isChroma = ( component == 1 || component == 2 ) && ! ( pixFmtDesc->flags & AV_PIX_FMT_FLAG_RGB );
+		const size_t chromaShiftW = isChroma ? pixFmtDesc->log2_chroma_w : 0;
+		const size_t chromaShiftH = isChroma ? pixFmtDesc->log2_chroma_h : 0;
+		const size_t step = componentDesc.step_minus1 + 1;
+		const size_t componentOffset = componentDesc.offset_plus1 - 1;
+		if( step % sampleSize || componentOffset % sampleSize )
+			return;
+
+		Plane plane;
+		plane._offset = planeOffsets[componentDesc.plane] + componentOffset;
+		plane._width = ( _frameDesc.getWidth() + ( 1 << chromaShiftW ) - 1 ) >> chromaShiftW;
+		plane._height = ( _frameDesc.getHeight() + ( 1 << chromaShiftH ) - 1 ) >> chromaShiftH;
+		plane._lineSize = lineSizes[componentDesc.plane];
+		plane._step = step / sampleSize;
+		plane._sampleSize = sampleSize;
+		plane._maxValue = ( 1 << depth ) - 1;
+		plane._squaredError = 0;
+		plane._ssim = 0;
+		if( componentOffset + ( ( plane._width - 1 ) * plane._step + 1 ) * sampleSize > plane._lineSize )
+			return;
+		planes.push_back( plane );
+	}
+
+	_planes = planes;
+}
+
+}
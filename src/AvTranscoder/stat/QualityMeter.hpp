@@ -0,0 +1,155 @@
+#ifndef _AV_TRANSCODER_STAT_QUALITY_METER_HPP_
+#define _AV_TRANSCODER_STAT_QUALITY_METER_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/codec/VideoCodec.hpp>
+#include <AvTranscoder/frame/VideoFrame.hpp>
+#include <AvTranscoder/thread.hpp>
+
+#include <vector>
+#include <deque>
+#include <string>
+
+struct AVFrame;
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Measure the quality of an encoded video stream, by decoding the encoded packets on a side thread.
+ * Each decoded frame is compared to the frame given to the encoder: the PSNR and the SSIM of each plane are averaged over the stream.
+ * The components of the packed formats (rgb24, yuyv422, nv12...) are measured separately, as if each of them was in its own plane.
+ * @note The encoded packets have to be given in decoding order, and the frames given to the encoder in presentation order.
+ * @note To bound the overhead of the process, the frames encoded while the side thread is late are not compared (the packets are still decoded).
+ * @note To bound the memory, the process waits for the side thread when too many packets are waiting to be decoded.
+ * @note Only the pixel formats with samples of 8 to 16 bits in native byte order are measured (yuv420p, yuv422p10le, rgb24...).
+ */
+class AvExport QualityMeter
+{
+private:
+	QualityMeter( const QualityMeter& qualityMeter );
+	QualityMeter& operator=( const QualityMeter& qualityMeter );
+
+public:
+	/**
+	 * @param encoderCodec: codec of the encoder, already opened (its extradata is given to the decoder)
+	 * @param frameDesc: description of the frames given to the encoder
+	 * @param maxNbQueuedPackets: number of packets waiting to be decoded above which the frames are not compared
+	 * @param maxNbBufferedPackets: number of packets waiting to be decoded above which addEncodedData waits for the side thread
+	 * @exception throw std::runtime_error if the encoded packets can't be decoded
+	 */
+	QualityMeter( const VideoCodec& encoderCodec, const VideoFrameDesc& frameDesc, const size_t maxNbQueuedPackets = 8, const size_t maxNbBufferedPackets = 64 );
+
+	/**
+	 * @note Wait for the end of the measure.
+	 */
+	~QualityMeter();
+
+	/**
+	 * @brief Copy the frame given to the encoder, to compare it to the decoded frame.
+	 */
+	void addSourceFrame( const VideoFrame& frame );
+
+	/**
+	 * @brief Copy the packet given by the encoder, to decode it.
+	 * @note Wait for the side thread if maxNbBufferedPackets are already waiting to be decoded.
+	 */
+	void addEncodedData( const CodedData& data );
+
+	/**
+	 * @brief Decode the last frames delayed by the decoder, and wait for the end of the measure.
+	 */
+	void flush();
+
+	//@{
+	// @brief Results of the measure.
+	// @note Call them after flush.
+	size_t getNbPlanes() const { return _planes.size(); }
+	double getPsnr( const size_t plane ) const;  ///< PSNR of the average squared error of the plane, in dB (the PSNR of identical planes is infinite)
+	double getSsim( const size_t plane ) const;  ///< Average SSIM of the plane, between 0 and 1
+	size_t getNbMeasuredFrames() const;
+	size_t getNbSkippedFrames() const;  ///< Number of frames not compared to bound the overhead
+	double getMeasureTime() const;  ///< Time in seconds spent to decode and compare the frames, on the side thread
+	double getCopyTime() const;  ///< Time in seconds spent to copy the frames and packets (and to wait for the side thread), on the thread of the process
+	//@}
+
+	/**
+	 * @brief Returns the PSNR of the given mean squared error of samples of the given maximum value.
+	 */
+	static double psnr( const double meanSquaredError, const double maxValue );
+
+private:
+	/**
+	 * @brief Geometry of a measured plane in the frames (a component of a packed format), and its measure.
+	 */
+	struct Plane
+	{
+		size_t _offset;  ///< Offset of the first sample of the plane in the data of a frame, in bytes
+		size_t _width;  ///< Width in samples
+		size_t _height;  ///< Height in samples
+		size_t _lineSize;  ///< Size of a line in bytes
+		size_t _step;  ///< Number of samples from a sample to the next one in a line (1 in planar formats)
+		size_t _sampleSize;  ///< Size of a sample in bytes (1 or 2)
+		int _maxValue;  ///< Maximum value of a sample
+
+		double _squaredError;  ///< Sum of the squared errors of all the compared frames
+		double _ssim;  ///< Sum of the SSIM of all the compared frames
+	};
+
+	static void run( void* qualityMeter );
+
+	/**
+	 * @brief Decode the queued packets, and compare the decoded frames, until the meter stops.
+	 */
+	void processPackets();
+
+	/**
+	 * @brief Decode the given packet (NULL to get the frames delayed by the decoder), and compare the decoded frames.
+	 * @return if a frame is decoded.
+	 */
+	bool decode( CodedData* data );
+
+	/**
+	 * @brief Compare each plane of the decoded frame to the source frame.
+	 */
+	void compare( const VideoFrame& source, const VideoFrame& decoded );
+
+	/**
+	 * @brief Give back a copy of a source frame, to reuse it for a next source frame.
+	 */
+	void releaseSourceFrame( VideoFrame* frame );
+
+	/**
+	 * @brief Set the geometry of the planes from the pixel format of the frames.
+	 */
+	void setupPlanes();
+
+private:
+	const VideoFrameDesc _frameDesc;
+	VideoCodec _decoderCodec;
+	AVFrame* _decodedAVFrame;  ///< Has ownership
+	VideoFrame _decodedFrame;  ///< Decoded frame in the layout of the source frames
+	std::vector< Plane > _planes;  ///< Empty if the pixel format can't be measured
+	const size_t _maxNbQueuedPackets;
+	const size_t _maxNbBufferedPackets;
+	Thread _thread;
+
+	mutable Mutex _mutex;  ///< Protect the members below
+	Condition _packetQueued;  ///< Notified when a packet is queued, or when the meter stops
+	Condition _packetDecoded;  ///< Notified when a packet is decoded
+
+	std::deque< CodedData* > _packets;  ///< Packets to decode (has ownership, NULL to flush the decoder)
+	std::deque< VideoFrame* > _sourceFrames;  ///< Frames given to the encoder, not decoded yet (has ownership, NULL if not compared)
+	std::vector< VideoFrame* > _unusedFrames;  ///< Copies of the source frames already compared, reused for the next source frames (has ownership)
+	bool _isDecoding;  ///< If the side thread is decoding a packet
+	bool _isStopping;  ///< Set to stop the side thread
+	size_t _nbMeasuredFrames;
+	size_t _nbSkippedFrames;
+	int64_t _measureTime;  ///< In microseconds
+	int64_t _copyTime;  ///< In microseconds
+	std::string _error;  ///< First error of the side thread (empty if no error)
+};
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "StageStat.hpp"
+
+#include <AvTranscoder/stat/Tracer.hpp>
+#include <AvTranscoder/thread.hpp>
+
+extern "C" {
+#include <libavutil/time.h>
+}
+
+#if defined( __WINDOWS__ )
+ #include <windows.h>
+#else
+ #include <time.h>
+#endif
+
+#include <algorithm>
+
+namespace avtranscoder
+{
+
+namespace
+{
+
+/// If the CPU time is measured by the StageTimers (0 or 1)
+AtomicInt cpuTimeMeasurement( 0 );
+
+}
+
+void setCpuTimeMeasurement( const bool measure )
+{
+#if ! defined( __WINDOWS__ ) && ! defined( CLOCK_THREAD_CPUTIME_ID )
+	if( measure )
+	{
+		LOG_WARN( "The CPU time of the threads is not available on this system: it is not measured." )
+		return;
+	}
+#endif
+	cpuTimeMeasurement.store( measure ? 1 : 0 );
+}
+
+bool isCpuTimeMeasured()
+{
+	return cpuTimeMeasurement.load() != 0;
+}
+
+StageTimer::StageTimer( StageStat& stageStat, const char* name, const size_t streamIndex, const StageStat* nestedStageStat )
+	: _stageStat( stageStat )
+	, _name( name )
+	, _streamIndex( streamIndex )
+	, _nestedStageStat( nestedStageStat )
+	, _isCpuTimeMeasured( isCpuTimeMeasured() )
+	, _startWallTime( getWallTime() )
+	, _startCpuTime( _isCpuTimeMeasured ? getCpuTime() : 0 )
+	, _startNestedWallTime( nestedStageStat ? nestedStageStat->_wallTime : 0 )
+	, _startNestedCpuTime( nestedStageStat ? nestedStageStat->_cpuTime : 0 )
+{
+}
+
+double StageTimer::stop( const size_t inputSize, const size_t outputSize )
+{
+	const int64_t stopWallTime = getWallTime();
+	// the span of the stage includes the nested stages
+	if( Tracer::isEnabled() )
+		Tracer::addSpan( _name, _startWallTime, stopWallTime - _startWallTime, _streamIndex, _stageStat._nbFrames );
+
+	double wallTime = ( stopWallTime - _startWallTime ) / 1000000.;
+	double cpuTime = _isCpuTimeMeasured ? ( getCpuTime() - _startCpuTime ) / 1000000. : 0;
+	if( _nestedStageStat )
+	{
+		wallTime -= _nestedStageStat->_wallTime - _startNestedWallTime;
+		cpuTime -= _nestedStageStat->_cpuTime - _startNestedCpuTime;
+	}
+
+	_stageStat._wallTime += wallTime;
+	_stageStat._cpuTime += std::max( cpuTime, 0. );
+	_stageStat._inputSize += inputSize;
+	_stageStat._outputSize += outputSize;
+	if( inputSize || outputSize )
+		++_stageStat._nbFrames;
+	_stageStat._maxFrameTime = std::max( _stageStat._maxFrameTime, wallTime );
+	return wallTime;
+}
+
+int64_t StageTimer::getWallTime()
+{
+	return av_gettime();
+}
+
+int64_t StageTimer::getCpuTime()
+{
+#if defined( __WINDOWS__ )
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if( ! GetThreadTimes( GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime ) )
+		return 0;
+	// in units of 100 nanoseconds
+	const int64_t kernel = ( static_cast<int64_t>( kernelTime.dwHighDateTime ) << 32 ) | kernelTime.dwLowDateTime;
+	const int64_t user = ( static_cast<int64_t>( userTime.dwHighDateTime ) << 32 ) | userTime.dwLowDateTime;
+	return ( kernel + user ) / 10;
+#elif defined( CLOCK_THREAD_CPUTIME_ID )
+	struct timespec time;
+	if( clock_gettime( CLOCK_THREAD_CPUTIME_ID, &time ) )
+		return 0;
+	return static_cast<int64_t>( time.tv_sec ) * 1000000 + time.tv_nsec / 1000;
+#else
+	// no clock of the threads (macOS before 10.12): the CPU time can't be measured
+	return 0;
+#endif
+}
+
+}
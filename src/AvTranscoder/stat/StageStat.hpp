@@ -0,0 +1,98 @@
+#ifndef _AV_TRANSCODER_STAT_STAGE_STAT_HPP_
+#define _AV_TRANSCODER_STAT_STAGE_STAT_HPP_
+
+#include <AvTranscoder/common.hpp>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Statistics of a stage of the process of a stream (demux, decode, convert, encode or mux).
+ * @see StageTimer
+ */
+class AvExport StageStat
+{
+public:
+	StageStat()
+	: _wallTime( 0 )
+	, _cpuTime( 0 )
+	, _nbFrames( 0 )
+	, _inputSize( 0 )
+	, _outputSize( 0 )
+	, _maxFrameTime( 0 )
+	{}
+
+	/// Number of frames processed per second of wall time (0 if unknown)
+	double getFps() const { return _wallTime > 0 ? _nbFrames / _wallTime : 0; }
+
+	/// Number of bytes processed per second of wall time (0 if unknown)
+	double getInputRate() const { return _wallTime > 0 ? _inputSize / _wallTime : 0; }
+
+public:
+	double _wallTime;  ///< Time in seconds spent in the stage
+	double _cpuTime;  ///< CPU time in seconds of the thread of the process spent in the stage (0 if not measured, see setCpuTimeMeasurement)
+	size_t _nbFrames;  ///< Number of frames or packets processed by the stage
+	size_t _inputSize;  ///< Number of bytes given to the stage
+	size_t _outputSize;  ///< Number of bytes given by the stage
+	double _maxFrameTime;  ///< Worst time in seconds spent to process a frame (latency of the stage)
+};
+
+/**
+ * @brief Measure the CPU time spent in the stages, in addition to their wall time.
+ * @note It costs two system calls per frame and per stage: by default the CPU time is not measured.
+ * @note The setting is shared by all the processes.
+ * @note The CPU time is not available on the systems without a CPU time clock of the threads (macOS before 10.12):
+ * it stays not measured there (see isCpuTimeMeasured).
+ */
+void AvExport setCpuTimeMeasurement( const bool measure = true );
+bool AvExport isCpuTimeMeasured();
+
+#ifndef SWIG
+/**
+ * @brief Measure the wall time and the CPU time (if measured, see setCpuTimeMeasurement) spent to process a frame in a stage, from its construction.
+ * @note The call of the stage is also recorded as a span by the Tracer, if it is enabled.
+ */
+class AvExport StageTimer
+{
+private:
+	StageTimer( const StageTimer& stageTimer );
+	StageTimer& operator=( const StageTimer& stageTimer );
+
+public:
+	/**
+	 * @param stageStat: statistics of the stage, updated when the timer stops
+	 * @param name: name of the stage in the trace (has to be a static string)
+	 * @param streamIndex: index of the processed stream in the trace
+	 * @param nestedStageStat: statistics of a stage called during this one (its time is not counted twice)
+	 */
+	StageTimer( StageStat& stageStat, const char* name, const size_t streamIndex, const StageStat* nestedStageStat = NULL );
+
+	/**
+	 * @brief Add the time spent since the construction to the statistics of the stage.
+	 * @note A frame is counted if some data is given to the stage or given by the stage.
+	 * @return the time in seconds spent in the stage
+	 */
+	double stop( const size_t inputSize, const size_t outputSize );
+
+	/// Returns the current wall time, in microseconds
+	static int64_t getWallTime();
+
+	/// Returns the CPU time of the thread, in microseconds
+	static int64_t getCpuTime();
+
+private:
+	StageStat& _stageStat;
+	const char* _name;
+	const size_t _streamIndex;
+	const StageStat* _nestedStageStat;  ///< Has link (no ownership, NULL if no nested stage)
+	const bool _isCpuTimeMeasured;
+	const int64_t _startWallTime;  ///< In microseconds
+	const int64_t _startCpuTime;  ///< In microseconds (0 if not measured)
+	const double _startNestedWallTime;  ///< Wall time of the nested stage at the construction, in seconds
+	const double _startNestedCpuTime;  ///< CPU time of the nested stage at the construction, in seconds
+};
+#endif
+
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "Tracer.hpp"
+
+#include <AvTranscoder/thread.hpp>
+
+#include <vector>
+#include <fstream>
+
+namespace avtranscoder
+{
+
+namespace
+{
+
+#if defined( __WINDOWS__ )
+typedef DWORD ThreadId;
+ThreadId getCurrentThreadId() { return GetCurrentThreadId(); }
+bool isSameThread( const ThreadId& thread1, const ThreadId& thread2 ) { return thread1 == thread2; }
+#else
+typedef pthread_t ThreadId;
+ThreadId getCurrentThreadId() { return pthread_self(); }
+bool isSameThread( const ThreadId& thread1, const ThreadId& thread2 ) { return pthread_equal( thread1, thread2 ) != 0; }
+#endif
+
+/**
+ * @brief A call of a stage of the process.
+ */
+struct Span
+{
+	const char* _name;
+	int64_t _startTime;  ///< In microseconds
+	int64_t _duration;  ///< In microseconds
+	size_t _streamIndex;
+	size_t _frame;
+	size_t _thread;  ///< Number of the thread, from 1 in the order of their first span
+};
+
+AtomicInt tracerState( 0 );  ///< 1 if the spans are recorded, 0 otherwise
+Mutex tracerMutex;  ///< Protect the spans and the threads
+std::vector< Span > spans;
+std::vector< ThreadId > threads;
+
+/**
+ * @brief Write the recorded spans in the given file, as Chrome trace events.
+ * @note Call it with the tracerMutex locked.
+ */
+bool writeSpans( const std::string& filename )
+{
+	LOG_INFO( "Write " << spans.size() << " spans of the process in '" << filename << "'" )
+
+	// the timestamps start at the first span
+	int64_t firstTime = 0;
+	for( std::vector< Span >::const_iterator it = spans.begin(); it != spans.end(); ++it )
+	{
+		if( it == spans.begin() || it->_startTime < firstTime )
+			firstTime = it->_startTime;
+	}
+
+	std::ofstream file( filename.c_str(), std::ios::out | std::ios::trunc );
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for( size_t thread = 1; thread <= threads.size(); ++thread )
+	{
+		file << ( thread > 1 ? "," : "" ) << std::endl;
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":\"thread " << thread << "\"}}";
+	}
+	for( std::vector< Span >::const_iterator it = spans.begin(); it != spans.end(); ++it )
+	{
+		file << "," << std::endl;
+		file << "{\"name\":\"" << it->_name << "\",\"cat\":\"avtranscoder\",\"ph\":\"X\",\"pid\":1,\"tid\":" << it->_thread
+			<< ",\"ts\":" << it->_startTime - firstTime << ",\"dur\":" << it->_duration
+			<< ",\"args\":{\"stream\":" << it->_streamIndex << ",\"frame\":" << it->_frame << "}}";
+	}
+	file << std::endl << "]}" << std::endl;
+	file.close();
+
+	if( file.fail() )
+	{
+		LOG_ERROR( "Unable to write the spans of the process in '" << filename << "'" )
+		return false;
+	}
+	return true;
+}
+
+}
+
+bool Tracer::start()
+{
+	ScopedLock lock( tracerMutex );
+	if( ! tracerState.compareAndSwap( 0, 1 ) )
+		return false;
+	spans.clear();
+	threads.clear();
+	return true;
+}
+
+void Tracer::stop()
+{
+	tracerState.store( 0 );
+}
+
+bool Tracer::stop( const std::string& filename )
+{
+	// the spans can't be removed by another trace before they are written
+	ScopedLock lock( tracerMutex );
+	tracerState.store( 0 );
+	return writeSpans( filename );
+}
+
+bool Tracer::isEnabled()
+{
+	return tracerState.load() != 0;
+}
+
+void Tracer::addSpan( const char* name, const int64_t startTime, const int64_t duration, const size_t streamIndex, const size_t frame )
+{
+	if( ! isEnabled() )
+		return;
+
+	const ThreadId currentThread = getCurrentThreadId();
+
+	ScopedLock lock( tracerMutex );
+	size_t thread = 0;
+	while( thread < threads.size() && ! isSameThread( threads.at( thread ), currentThread ) )
+		++thread;
+	if( thread == threads.size() )
+		threads.push_back( currentThread );
+
+	Span span;
+	span._name = name;
+	span._startTime = startTime;
+	span._duration = duration;
+	span._streamIndex = streamIndex;
+	span._frame = frame;
+	span._thread = thread + 1;
+	spans.push_back( span );
+}
+
+size_t Tracer::getNbSpans()
+{
+	ScopedLock lock( tracerMutex );
+	return spans.size();
+}
+
+bool Tracer::write( const std::string& filename )
+{
+	ScopedLock lock( tracerMutex );
+	return writeSpans( filename );
+}
+
+}
@@ -0,0 +1,66 @@
+#ifndef _AV_TRANSCODER_STAT_TRACER_HPP_
+#define _AV_TRANSCODER_STAT_TRACER_HPP_
+
+#include <AvTranscoder/common.hpp>
+
+#include <string>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Record a span for each call of the stages of the process (demux, decode, convert, encode, wrap),
+ * tagged with its stream index, its frame number and its thread, to view the process on a timeline.
+ * The spans are written as Chrome trace events (JSON), which can be opened in chrome://tracing or in Perfetto.
+ * @note Disabled by default: then each call of a stage only checks an atomic integer.
+ * @note A single trace is recorded at a time: the spans of all the threads are recorded in it.
+ * @see StageTimer
+ * @see Transcoder::setTrace
+ */
+class AvExport Tracer
+{
+public:
+	/**
+	 * @brief Remove the recorded spans, and record the next ones.
+	 * @return false if the tracer is already enabled (the spans recorded by the current trace are kept).
+	 */
+	static bool start();
+
+	/**
+	 * @brief Stop to record the spans (the recorded spans are kept).
+	 */
+	static void stop();
+
+	/**
+	 * @brief Stop to record the spans, and write them in the given file before another trace can start.
+	 * @return if the file is written.
+	 */
+	static bool stop( const std::string& filename );
+
+	static bool isEnabled();
+
+#ifndef SWIG
+	/**
+	 * @brief Record a span, if the tracer is enabled.
+	 * @param name: name of the stage (has to be a static string)
+	 * @param startTime: wall time of the beginning of the span, in microseconds
+	 * @param duration: in microseconds
+	 * @param streamIndex: index of the processed stream
+	 * @param frame: number of the processed frame in the stage, from 0
+	 * @note Thread safe.
+	 */
+	static void addSpan( const char* name, const int64_t startTime, const int64_t duration, const size_t streamIndex, const size_t frame );
+#endif
+
+	static size_t getNbSpans();
+
+	/**
+	 * @brief Write the recorded spans in the given file, as Chrome trace events.
+	 * @return if the file is written.
+	 */
+	static bool write( const std::string& filename );
+};
+
+}
+
+#endif
@@ -2,6 +2,11 @@
 #define  _AV_TRANSCODER_VIDEOSTAT_HPP
 
 #include <AvTranscoder/common.hpp>
+#include <AvTranscoder/stat/DetectedSegment.hpp>
+#include <AvTranscoder/stat/StageStat.hpp>
+
+#include <string>
+#include <vector>
 
 namespace avtranscoder
 {
@@ -17,6 +22,21 @@ public:
 	, _nbFrames( nbFrames )
 	, _quality( 0 )
 	, _psnr( 0 )
+	, _decodedDigest()
+	, _encodedDigest()
+	, _planePsnr()
+	, _planeSsim()
+	, _nbMeasuredFrames( 0 )
+	, _nbSkippedFrames( 0 )
+	, _measureTime( 0 )
+	, _measureCopyTime( 0 )
+	, _blackSegments()
+	, _freezeSegments()
+	, _demuxStat()
+	, _decodeStat()
+	, _convertStat()
+	, _encodeStat()
+	, _muxStat()
 	{}
 
 public:
@@ -27,6 +47,33 @@ public:
 	size_t _nbFrames;
 	size_t _quality;  ///< Between 1 (good) and FF_LAMBDA_MAX (bad). 0 if unknown.
 	double _psnr;  ///< 0 if unknown.
+	std::string _decodedDigest;  ///< Digest of the frames decoded from the input. Empty if not digested.
+	std::string _encodedDigest;  ///< Digest of the packets given to the output. Empty if not digested.
+
+	//@{
+	// @brief Quality of the encoded frames, measured by decoding them (see Transcoder::setQualityMeasurement).
+	std::vector< double > _planePsnr;  ///< PSNR of each plane, in dB. Empty if not measured.
+	std::vector< double > _planeSsim;  ///< SSIM of each plane, between 0 and 1. Empty if not measured.
+	size_t _nbMeasuredFrames;  ///< Number of frames compared to the decoded frames
+	size_t _nbSkippedFrames;  ///< Number of frames not compared to bound the overhead of the measure
+	double _measureTime;  ///< Time in seconds spent to decode and compare the frames, on a side thread
+	double _measureCopyTime;  ///< Time in seconds spent by the process to copy the data to measure
+	//@}
+
+	//@{
+	// @brief Content detected in the decoded frames (see Transcoder::setContentDetection). Empty if not detected.
+	std::vector< DetectedSegment > _blackSegments;
+	std::vector< DetectedSegment > _freezeSegments;
+	//@}
+
+	//@{
+	// @brief Time spent and data processed in each stage of the process of the stream.
+	StageStat _demuxStat;  ///< Packets read from the input stream (empty for a generated stream)
+	StageStat _decodeStat;  ///< Frames decoded or generated (without the time spent to demux the packets)
+	StageStat _convertStat;  ///< Frames converted to the format of the encoder
+	StageStat _encodeStat;  ///< Frames encoded (empty when rewrapping)
+	StageStat _muxStat;  ///< Packets wrapped in the output file
+	//@}
 };
 
 }
@@ -1,9 +1,30 @@
 %{
+#include <AvTranscoder/stat/FrameMetrics.hpp>
+#include <AvTranscoder/stat/IMetricsObserver.hpp>
 #include <AvTranscoder/stat/ProcessStat.hpp>
 #include <AvTranscoder/stat/VideoStat.hpp>
 #include <AvTranscoder/stat/AudioStat.hpp>
+#include <AvTranscoder/stat/QualityMeter.hpp>
+#include <AvTranscoder/stat/ContentDetector.hpp>
+#include <AvTranscoder/stat/Tracer.hpp>
 %}
 
+namespace std {
+%template(DoubleVector) vector< double >;
+%template(FrameMetricsVector) vector< avtranscoder::FrameMetrics >;
+}
+
+/* turn on director wrapping for IMetricsObserver */
+%feature("director") IMetricsObserver;
+
+%thread avtranscoder::QualityMeter::flush;
+%thread avtranscoder::QualityMeter::~QualityMeter;
+
+%include <AvTranscoder/stat/FrameMetrics.hpp>
+%include <AvTranscoder/stat/IMetricsObserver.hpp>
 %include <AvTranscoder/stat/ProcessStat.hpp>
 %include <AvTranscoder/stat/VideoStat.hpp>
 %include <AvTranscoder/stat/AudioStat.hpp>
+%include <AvTranscoder/stat/QualityMeter.hpp>
+%include <AvTranscoder/stat/ContentDetector.hpp>
+%include <AvTranscoder/stat/Tracer.hpp>
@@ -9,6 +9,8 @@
 
 #include <AvTranscoder/frame/Frame.hpp>
 
+#include <AvTranscoder/stat/StageStat.hpp>
+
 namespace avtranscoder
 {
 
@@ -56,6 +58,16 @@ public:
 	virtual bool isActivated() const = 0;
 	virtual void clearBuffering() = 0;
 	//@}
+
+	/**
+	 * @return the statistics of the packets read from the stream (from the input file or from the cache)
+	 */
+	virtual const StageStat& getDemuxStat() const = 0;
+
+	/**
+	 * @return the number of packets of the stream read by the input file, and waiting to be read from the stream
+	 */
+	virtual size_t getNbCachedPackets() const = 0;
 };
 
 }
@@ -4,6 +4,7 @@
 #include <AvTranscoder/codec/AudioCodec.hpp>
 #include <AvTranscoder/codec/VideoCodec.hpp>
 #include <AvTranscoder/frame/Frame.hpp>
+#include <AvTranscoder/stat/StageStat.hpp>
 
 namespace avtranscoder
 {
@@ -42,6 +43,11 @@ public:
 	 * @see EWrappingStatus
 	**/
 	virtual EWrappingStatus wrap( const CodedData& data ) = 0;
+
+	/**
+	 * @return the statistics of the packets of the stream written in the output file
+	 */
+	virtual const StageStat& getWrapStat() const = 0;
 };
 
 }
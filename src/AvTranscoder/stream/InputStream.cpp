@@ -13,13 +13,29 @@ extern "C" {
 namespace avtranscoder
 {
 
+namespace
+{
+
+/// Copy the properties of the packet used by the decoders (its data is copied separately)
+void copyPacketProperties( const AVPacket& source, AVPacket& destination )
+{
+	destination.pts = source.pts;
+	destination.dts = source.dts;
+	destination.duration = source.duration;
+	destination.flags = source.flags;
+}
+
+}
+
 InputStream::InputStream( InputFile& inputFile, const size_t streamIndex )
 	: IInputStream( )
 	, _inputFile( &inputFile )
 	, _codec( NULL )
 	, _streamCache()
+	, _spilledStreamCache()
 	, _streamIndex( streamIndex )
 	, _isActivated( false )
+	, _demuxStat()
 {
 	AVCodecContext* context = _inputFile->getFormatContext().getAVStream( _streamIndex ).codec;
 
@@ -55,21 +71,37 @@ bool InputStream::readNextPacket( CodedData& data )
 	if( ! _isActivated )
 		throw std::runtime_error( "Can't read packet on non-activated input stream." );
 
+	StageTimer timer( _demuxStat, "demux", _streamIndex );
+	bool isRead = true;
+
 	// if packet is already cached
 	if( ! _streamCache.empty() )
 	{
 		LOG_DEBUG( "Get packet data of stream " << _streamIndex << " from the cache" )
 		data.copyData( _streamCache.front().getData(), _streamCache.front().getSize() );
+		copyPacketProperties( _streamCache.front().getAVPacket(), data.getAVPacket() );
+		_inputFile->releaseCacheSize( _streamCache.front().getSize() );
 		_streamCache.pop();
 	}
+	// if packet is cached in the temporary file
+	else if( ! _spilledStreamCache.empty() )
+	{
+		LOG_DEBUG( "Get packet data of stream " << _streamIndex << " from the temporary file" )
+		const SpilledPacket& packet = _spilledStreamCache.front();
+		_inputFile->readSpilledData( packet._position, packet._size, data );
+		copyPacketProperties( packet._properties, data.getAVPacket() );
+		_spilledStreamCache.pop();
+	}
 	// else read next packet
 	else
 	{
 		LOG_DEBUG( "Read next packet" )
-		return _inputFile->readNextPacket( data, _streamIndex ) && _streamCache.empty();
+		isRead = _inputFile->readNextPacket( data, _streamIndex ) && _streamCache.empty() && _spilledStreamCache.empty();
 	}
 
-	return true;
+	const size_t readSize = isRead ? data.getSize() : 0;
+	timer.stop( readSize, readSize );
+	return isRead;
 }
 
 VideoCodec& InputStream::getVideoCodec()
@@ -113,6 +145,13 @@ const StreamProperties& InputStream::getProperties() const
 	return _inputFile->getProperties().getStreamPropertiesWithIndex( _streamIndex );
 }
 
+void InputStream::activate( const bool activate )
+{
+	_isActivated = activate;
+	if( _isActivated )
+		_inputFile->getFormatContext().getAVStream( _streamIndex ).discard = AVDISCARD_DEFAULT;
+}
+
 void InputStream::addPacket( const AVPacket& packet )
 {
 	// Do not cache data if the stream is declared as unused in process
@@ -122,14 +161,38 @@ void InputStream::addPacket( const AVPacket& packet )
 		return;
 	}
 
-	LOG_DEBUG( "Add a packet data for the stream " << _streamIndex << " to the cache" )
-	_streamCache.push( CodedData() );
-	_streamCache.back().copyData( packet.data, packet.size );
+	// Keep the order of the packets: once in the temporary file, cache there until it is read
+	if( _spilledStreamCache.empty() && _inputFile->reserveCacheSize( packet.size ) )
+	{
+		LOG_DEBUG( "Add a packet data for the stream " << _streamIndex << " to the cache" )
+		_streamCache.push( CodedData() );
+		_streamCache.back().copyData( packet.data, packet.size );
+		copyPacketProperties( packet, _streamCache.back().getAVPacket() );
+	}
+	else
+	{
+		LOG_DEBUG( "Add a packet data for the stream " << _streamIndex << " to the temporary file" )
+		SpilledPacket spilledPacket;
+		spilledPacket._position = _inputFile->spillData( packet.data, packet.size );
+		spilledPacket._size = packet.size;
+		av_init_packet( &spilledPacket._properties );
+		copyPacketProperties( packet, spilledPacket._properties );
+		_spilledStreamCache.push( spilledPacket );
+	}
 }
 
 void InputStream::clearBuffering()
 {
-	_streamCache = std::queue<CodedData>();
+	while( ! _streamCache.empty() )
+	{
+		_inputFile->releaseCacheSize( _streamCache.front().getSize() );
+		_streamCache.pop();
+	}
+	while( ! _spilledStreamCache.empty() )
+	{
+		_inputFile->releaseSpilledData( _spilledStreamCache.front()._size );
+		_spilledStreamCache.pop();
+	}
 }
 
 }
@@ -31,19 +31,40 @@ public:
 	AudioCodec& getAudioCodec();
 	DataCodec& getDataCodec();
 
-	void activate( const bool activate = true ){ _isActivated = activate; };
+	/**
+	 * @note An activated stream is always read by the demuxer.
+	 * @see InputFile::activateStream
+	 */
+	void activate( const bool activate = true );
 	bool isActivated() const { return _isActivated; };
 	void addPacket( const AVPacket& packet );
 	void clearBuffering();
 
+	const StageStat& getDemuxStat() const { return _demuxStat; }
+	size_t getNbCachedPackets() const { return _streamCache.size() + _spilledStreamCache.size(); }
+
+private:
+	/**
+	 * @brief A packet cached in the temporary file of the input file.
+	 */
+	struct SpilledPacket
+	{
+		int64_t _position;  ///< Position of the data in the temporary file
+		size_t _size;  ///< Size of the data
+		AVPacket _properties;  ///< Timestamps and flags of the packet (without data)
+	};
+
 private:
 	InputFile* _inputFile;  ///< Has link (no ownership)
 	ICodec* _codec;  ///< Has ownership
 
 	std::queue<CodedData> _streamCache;  ///< Cache of packet data already read and corresponding to this stream
+	std::queue<SpilledPacket> _spilledStreamCache;  ///< Packets cached in the temporary file of the input file (more recent than the ones in memory)
 
 	size_t _streamIndex;  ///<  Index of the stream in the input file
 	bool _isActivated;  ///< If the stream is activated, data read from it will be buffered
+
+	StageStat _demuxStat;
 };
 
 }
@@ -49,6 +49,11 @@ size_t OutputStream::getNbFrames() const
 	return _outputAVStream.nb_frames;
 }
 
+const StageStat& OutputStream::getWrapStat() const
+{
+	return _outputFile.getMuxStat( _streamIndex );
+}
+
 IOutputStream::EWrappingStatus OutputStream::wrap( const CodedData& data )
 {
 	// wrap packet
@@ -21,6 +21,8 @@ public:
 
 	IOutputStream::EWrappingStatus wrap( const CodedData& data );
 
+	const StageStat& getWrapStat() const;
+
 private:
 	OutputFile& _outputFile;  ///< Has link (no ownership)
 	const AVStream& _outputAVStream;  ///< Has link (no ownership)
@@ -1,4 +1,6 @@
 %{
+#include <AvTranscoder/stat/StageStat.hpp>
+
 #include <AvTranscoder/stream/IOutputStream.hpp>
 #include <AvTranscoder/stream/OutputStream.hpp>
 
@@ -6,6 +8,8 @@
 #include <AvTranscoder/stream/InputStream.hpp>
 %}
 
+%include <AvTranscoder/stat/StageStat.hpp>
+
 %include <AvTranscoder/stream/IOutputStream.hpp>
 %include <AvTranscoder/stream/OutputStream.hpp>
 
@@ -0,0 +1,236 @@
+#include "thread.hpp"
+
+#include <stdexcept>
+
+#if ! defined( __WINDOWS__ )
+ #include <unistd.h>
+#endif
+
+namespace avtranscoder
+{
+
+#if defined( __WINDOWS__ )
+
+Mutex::Mutex()
+{
+	InitializeCriticalSection( &_mutex );
+}
+
+Mutex::~Mutex()
+{
+	DeleteCriticalSection( &_mutex );
+}
+
+void Mutex::lock()
+{
+	EnterCriticalSection( &_mutex );
+}
+
+void Mutex::unlock()
+{
+	LeaveCriticalSection( &_mutex );
+}
+
+Condition::Condition()
+{
+	InitializeConditionVariable( &_condition );
+}
+
+Condition::~Condition()
+{
+}
+
+void Condition::wait( Mutex& mutex )
+{
+	SleepConditionVariableCS( &_condition, &mutex._mutex, INFINITE );
+}
+
+void Condition::notifyOne()
+{
+	WakeConditionVariable( &_condition );
+}
+
+void Condition::notifyAll()
+{
+	WakeAllConditionVariable( &_condition );
+}
+
+long AtomicInt::load() const
+{
+	return InterlockedCompareExchange( const_cast<volatile long*>( &_value ), 0, 0 );
+}
+
+void AtomicInt::store( const long value )
+{
+	InterlockedExchange( &_value, value );
+}
+
+long AtomicInt::fetchAdd( const long value )
+{
+	return InterlockedExchangeAdd( &_value, value );
+}
+
+bool AtomicInt::compareAndSwap( const long expected, const long desired )
+{
+	return InterlockedCompareExchange( &_value, desired, expected ) == expected;
+}
+
+void Thread::start( Function function, void* argument )
+{
+	join();
+	_function = function;
+	_argument = argument;
+	_thread = CreateThread( NULL, 0, &Thread::run, this, 0, NULL );
+	if( _thread == NULL )
+		throw std::runtime_error( "unable to create a thread" );
+	_isRunning = true;
+}
+
+void Thread::join()
+{
+	if( ! _isRunning )
+		return;
+	WaitForSingleObject( _thread, INFINITE );
+	CloseHandle( _thread );
+	_isRunning = false;
+}
+
+void Thread::sleep( const size_t milliseconds )
+{
+	Sleep( milliseconds );
+}
+
+size_t Thread::getNbProcessors()
+{
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo( &systemInfo );
+	return systemInfo.dwNumberOfProcessors > 0 ? systemInfo.dwNumberOfProcessors : 1;
+}
+
+DWORD WINAPI Thread::run( LPVOID thread )
+{
+	Thread* self = static_cast<Thread*>( thread );
+	self->_function( self->_argument );
+	return 0;
+}
+
+#else
+
+Mutex::Mutex()
+{
+	pthread_mutex_init( &_mutex, NULL );
+}
+
+Mutex::~Mutex()
+{
+	pthread_mutex_destroy( &_mutex );
+}
+
+void Mutex::lock()
+{
+	pthread_mutex_lock( &_mutex );
+}
+
+void Mutex::unlock()
+{
+	pthread_mutex_unlock( &_mutex );
+}
+
+Condition::Condition()
+{
+	pthread_cond_init( &_condition, NULL );
+}
+
+Condition::~Condition()
+{
+	pthread_cond_destroy( &_condition );
+}
+
+void Condition::wait( Mutex& mutex )
+{
+	pthread_cond_wait( &_condition, &mutex._mutex );
+}
+
+void Condition::notifyOne()
+{
+	pthread_cond_signal( &_condition );
+}
+
+void Condition::notifyAll()
+{
+	pthread_cond_broadcast( &_condition );
+}
+
+long AtomicInt::load() const
+{
+	return __sync_fetch_and_add( const_cast<volatile long*>( &_value ), 0 );
+}
+
+void AtomicInt::store( const long value )
+{
+	__sync_synchronize();
+	_value = value;
+	__sync_synchronize();
+}
+
+long AtomicInt::fetchAdd( const long value )
+{
+	return __sync_fetch_and_add( &_value, value );
+}
+
+bool AtomicInt::compareAndSwap( const long expected, const long desired )
+{
+	return __sync_bool_compare_and_swap( &_value, expected, desired );
+}
+
+void Thread::start( Function function, void* argument )
+{
+	join();
+	_function = function;
+	_argument = argument;
+	if( pthread_create( &_thread, NULL, &Thread::run, this ) != 0 )
+		throw std::runtime_error( "unable to create a thread" );
+	_isRunning = true;
+}
+
+void Thread::join()
+{
+	if( ! _isRunning )
+		return;
+	pthread_join( _thread, NULL );
+	_isRunning = false;
+}
+
+void Thread::sleep( const size_t milliseconds )
+{
+	usleep( milliseconds * 1000 );
+}
+
+size_t Thread::getNbProcessors()
+{
+	const long nbProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+	return nbProcessors > 0 ? nbProcessors : 1;
+}
+
+void* Thread::run( void* thread )
+{
+	Thread* self = static_cast<Thread*>( thread );
+	self->_function( self->_argument );
+	return NULL;
+}
+
+#endif
+
+Thread::Thread()
+	: _function( NULL )
+	, _argument( NULL )
+	, _isRunning( false )
+{
+}
+
+Thread::~Thread()
+{
+	join();
+}
+
+}
@@ -0,0 +1,178 @@
+#ifndef _AV_TRANSCODER_THREAD_HPP_
+#define _AV_TRANSCODER_THREAD_HPP_
+
+#include <AvTranscoder/common.hpp>
+
+#if defined( __WINDOWS__ )
+ #include <windows.h>
+#else
+ #include <pthread.h>
+#endif
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Portable non recursive mutex.
+ */
+class AvExport Mutex
+{
+private:
+	Mutex( const Mutex& mutex );
+	Mutex& operator=( const Mutex& mutex );
+
+public:
+	Mutex();
+	~Mutex();
+
+	void lock();
+	void unlock();
+
+private:
+	friend class Condition;
+
+#if defined( __WINDOWS__ )
+	CRITICAL_SECTION _mutex;
+#else
+	pthread_mutex_t _mutex;
+#endif
+};
+
+/**
+ * @brief Portable condition variable, to wait for a change of a state protected by a Mutex.
+ */
+class AvExport Condition
+{
+private:
+	Condition( const Condition& condition );
+	Condition& operator=( const Condition& condition );
+
+public:
+	Condition();
+	~Condition();
+
+	/**
+	 * @brief Release the locked mutex, wait for a notification, and lock the mutex again.
+	 * @note The wait can end without notification: check the state in a loop.
+	 */
+	void wait( Mutex& mutex );
+
+	void notifyOne();  ///< Wake up one of the waiting threads
+	void notifyAll();  ///< Wake up all the waiting threads
+
+private:
+#if defined( __WINDOWS__ )
+	CONDITION_VARIABLE _condition;
+#else
+	pthread_cond_t _condition;
+#endif
+};
+
+/**
+ * @brief Lock the given mutex for the lifetime of the object.
+ */
+class AvExport ScopedLock
+{
+private:
+	ScopedLock( const ScopedLock& scopedLock );
+	ScopedLock& operator=( const ScopedLock& scopedLock );
+
+public:
+	ScopedLock( Mutex& mutex )
+		: _mutex( mutex )
+	{
+		_mutex.lock();
+	}
+
+	~ScopedLock()
+	{
+		_mutex.unlock();
+	}
+
+private:
+	Mutex& _mutex;  ///< Has link (no ownership)
+};
+
+/**
+ * @brief Integer shared between threads, with atomic operations.
+ * @note Each operation is a full memory barrier.
+ */
+class AvExport AtomicInt
+{
+private:
+	AtomicInt( const AtomicInt& atomicInt );
+	AtomicInt& operator=( const AtomicInt& atomicInt );
+
+public:
+	AtomicInt( const long value = 0 )
+		: _value( value )
+	{}
+
+	long load() const;
+	void store( const long value );
+
+	/**
+	 * @return The value before the addition.
+	 */
+	long fetchAdd( const long value );
+
+	/**
+	 * @brief Set the desired value only if the current value is the expected one.
+	 * @return If the value has been set.
+	 */
+	bool compareAndSwap( const long expected, const long desired );
+
+private:
+	volatile long _value;
+};
+
+/**
+ * @brief Portable thread, which executes a function with an argument.
+ */
+class AvExport Thread
+{
+private:
+	Thread( const Thread& thread );
+	Thread& operator=( const Thread& thread );
+
+public:
+	typedef void (*Function)( void* );
+
+	Thread();
+	~Thread();  ///< Wait for the end of the thread if it is running
+
+	/**
+	 * @exception throw std::runtime_error if the thread can't be created
+	 */
+	void start( Function function, void* argument );
+
+	/**
+	 * @brief Wait for the end of the thread (do nothing if the thread is not running).
+	 */
+	void join();
+
+	bool isRunning() const { return _isRunning; }
+
+	static void sleep( const size_t milliseconds );
+
+	/**
+	 * @brief Returns the number of processors available (at least 1).
+	 */
+	static size_t getNbProcessors();
+
+private:
+#if defined( __WINDOWS__ )
+	static DWORD WINAPI run( LPVOID thread );
+	HANDLE _thread;
+#else
+	static void* run( void* thread );
+	pthread_t _thread;
+#endif
+	Function _function;
+	void* _argument;
+	bool _isRunning;
+};
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "Checkpoint.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <cstdio>
+#include <stdexcept>
+
+namespace avtranscoder
+{
+
+namespace
+{
+
+template< typename T >
+T getValue( const std::map< std::string, std::string >& values, const std::string& key, const std::string& filename )
+{
+	std::map< std::string, std::string >::const_iterator it = values.find( key );
+	T value = T();
+	if( it == values.end() || ! ( std::istringstream( it->second ) >> value ) )
+		throw std::runtime_error( "Invalid checkpoint '" + filename + "': missing value of '" + key + "'" );
+	return value;
+}
+
+std::string getStreamKey( const size_t streamIndex, const std::string& key )
+{
+	std::ostringstream os;
+	os << "stream" << streamIndex << "." << key;
+	return os.str();
+}
+
+}
+
+Checkpoint::Checkpoint()
+	: _outputSize( 0 )
+	, _streams()
+{
+}
+
+bool Checkpoint::load( const std::string& filename )
+{
+	std::ifstream file( filename.c_str() );
+	if( ! file.is_open() )
+		return false;
+
+	std::map< std::string, std::string > values;
+	std::string line;
+	while( std::getline( file, line ) )
+	{
+		const size_t separator = line.find( '=' );
+		if( separator == std::string::npos )
+			continue;
+		values[ line.substr( 0, separator ) ] = line.substr( separator + 1 );
+	}
+
+	_outputSize = getValue<int64_t>( values, "outputSize", filename );
+	const size_t nbStreams = getValue<size_t>( values, "nbStreams", filename );
+
+	_streams.clear();
+	for( size_t streamIndex = 0; streamIndex < nbStreams; ++streamIndex )
+	{
+		StreamState streamState;
+		streamState._pts = getValue<int64_t>( values, getStreamKey( streamIndex, "pts" ), filename );
+		streamState._nbFrames = getValue<size_t>( values, getStreamKey( streamIndex, "nbFrames" ), filename );
+		streamState._duration = getValue<double>( values, getStreamKey( streamIndex, "duration" ), filename );
+		_streams.push_back( streamState );
+	}
+
+	LOG_DEBUG( "Load checkpoint '" << filename << "' (" << _outputSize << " bytes written)" )
+	return true;
+}
+
+void Checkpoint::save( const std::string& filename ) const
+{
+	const std::string temporaryFilename = filename + ".tmp";
+	{
+		std::ofstream file( temporaryFilename.c_str(), std::ios::out | std::ios::trunc );
+		file << std::setprecision( 17 );
+		file << "outputSize=" << _outputSize << std::endl;
+		file << "nbStreams=" << _streams.size() << std::endl;
+		for( size_t streamIndex = 0; streamIndex < _streams.size(); ++streamIndex )
+		{
+			file << getStreamKey( streamIndex, "pts" ) << "=" << _streams.at( streamIndex )._pts << std::endl;
+			file << getStreamKey( streamIndex, "nbFrames" ) << "=" << _streams.at( streamIndex )._nbFrames << std::endl;
+			file << getStreamKey( streamIndex, "duration" ) << "=" << _streams.at( streamIndex )._duration << std::endl;
+		}
+		file.close();
+		if( file.fail() )
+			throw std::runtime_error( "Unable to write the checkpoint '" + temporaryFilename + "'" );
+	}
+
+#if defined( __WINDOWS__ )
+	// rename does not replace an existing file on Windows
+	std::remove( filename.c_str() );
+#endif
+	if( std::rename( temporaryFilename.c_str(), filename.c_str() ) != 0 )
+		throw std::runtime_error( "Unable to write the checkpoint '" + filename + "'" );
+
+	LOG_DEBUG( "Save checkpoint '" << filename << "' (" << _outputSize << " bytes written)" )
+}
+
+}
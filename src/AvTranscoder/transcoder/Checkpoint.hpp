@@ -0,0 +1,61 @@
+#ifndef _AV_TRANSCODER_CHECKPOINT_HPP_
+#define _AV_TRANSCODER_CHECKPOINT_HPP_
+
+#include <AvTranscoder/common.hpp>
+
+#include <string>
+#include <vector>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief State of a process, saved in a file to resume the process after a failure.
+ * The file contains a "key=value" per line.
+ * @see Transcoder::setCheckpoint
+ */
+class AvExport Checkpoint
+{
+public:
+	/**
+	 * @brief State of an output stream.
+	 */
+	struct StreamState
+	{
+		int64_t _pts;  ///< Timestamp of the next packet, in the time base of the output stream
+		size_t _nbFrames;  ///< Number of wrapped frames
+		double _duration;  ///< Duration of the output stream, in seconds
+	};
+
+public:
+	Checkpoint();
+
+	/**
+	 * @brief Load the state saved in the given file.
+	 * @return false if the file does not exist.
+	 * @exception throw std::runtime_error if the file is not a valid checkpoint
+	 */
+	bool load( const std::string& filename );
+
+	/**
+	 * @brief Save the state in the given file.
+	 * @note The state is written in a temporary file, then renamed: a failure during the save keeps the previous state.
+	 * @exception throw std::runtime_error if the file can't be written
+	 */
+	void save( const std::string& filename ) const;
+
+	int64_t getOutputSize() const { return _outputSize; }
+	void setOutputSize( const int64_t outputSize ) { _outputSize = outputSize; }
+
+	size_t getNbStreams() const { return _streams.size(); }
+	const StreamState& getStream( const size_t streamIndex ) const { return _streams.at( streamIndex ); }
+	void addStream( const StreamState& streamState ) { _streams.push_back( streamState ); }
+
+private:
+	int64_t _outputSize;  ///< Size of the data written in the output file, in bytes
+	std::vector< StreamState > _streams;  ///< State of each output stream
+};
+
+}
+
+#endif
@@ -0,0 +1,167 @@
+#include "Remuxer.hpp"
+
+#include <AvTranscoder/progress/NoDisplayProgress.hpp>
+
+#include <stdexcept>
+#include <sstream>
+
+namespace avtranscoder
+{
+
+Remuxer::Remuxer( InputFile& inputFile, OutputFile& outputFile )
+	: _inputFile( inputFile )
+	, _outputFile( outputFile )
+	, _inputStreamIndexes()
+	, _outputStreamIndexes( inputFile.getFormatContext().getNbStreams(), -1 )
+{
+}
+
+void Remuxer::addStream( const size_t streamIndex )
+{
+	LOG_INFO( "Add stream " << streamIndex << " of file '" << _inputFile.getFilename() << "' to remux" )
+
+	InputStream& inputStream = _inputFile.getStream( streamIndex );
+	if( _outputStreamIndexes.at( streamIndex ) >= 0 )
+	{
+		LOG_WARN( "The stream " << streamIndex << " is already remuxed" )
+		return;
+	}
+
+	const AVMediaType mediaType = inputStream.getProperties().getStreamType();
+	switch( mediaType )
+	{
+		case AVMEDIA_TYPE_VIDEO:
+			_outputFile.addVideoStream( inputStream.getVideoCodec() );
+			break;
+		case AVMEDIA_TYPE_AUDIO:
+			_outputFile.addAudioStream( inputStream.getAudioCodec() );
+			break;
+		case AVMEDIA_TYPE_DATA:
+			_outputFile.addDataStream( inputStream.getDataCodec() );
+			break;
+		default:
+		{
+			std::stringstream msg;
+			msg << "Unable to remux the stream " << streamIndex << " (AVMediaType = " << mediaType << ")";
+			throw std::runtime_error( msg.str() );
+		}
+	}
+
+	_outputStreamIndexes.at( streamIndex ) = _outputFile.getFormatContext().getNbStreams() - 1;
+	_inputStreamIndexes.push_back( streamIndex );
+
+	// the demuxer skips the streams which are not remuxed
+	_inputFile.activateStream( streamIndex );
+}
+
+void Remuxer::addAllStreams()
+{
+	for( size_t streamIndex = 0; streamIndex < _outputStreamIndexes.size(); ++streamIndex )
+	{
+		const AVMediaType mediaType = _inputFile.getStream( streamIndex ).getProperties().getStreamType();
+		if( mediaType != AVMEDIA_TYPE_VIDEO && mediaType != AVMEDIA_TYPE_AUDIO && mediaType != AVMEDIA_TYPE_DATA )
+		{
+			LOG_WARN( "Skip the stream " << streamIndex << " (AVMediaType = " << mediaType << ")" )
+			continue;
+		}
+		addStream( streamIndex );
+	}
+}
+
+ProcessStat Remuxer::process()
+{
+	NoDisplayProgress progress;
+	return process( progress );
+}
+
+ProcessStat Remuxer::process( IProgress& progress )
+{
+	if( _inputStreamIndexes.empty() )
+		throw std::runtime_error( "Missing input streams in remuxer" );
+
+	LOG_INFO( "Start remux" )
+
+	_outputFile.beginWrap();
+
+	FormatContext& inputFormatContext = _inputFile.getFormatContext();
+	FormatContext& outputFormatContext = _outputFile.getFormatContext();
+
+	const AVFormatContext& inputAVFormatContext = inputFormatContext.getAVFormatContext();
+	const double duration = ( inputAVFormatContext.duration != (int64_t)AV_NOPTS_VALUE ) ? (double)inputAVFormatContext.duration / AV_TIME_BASE : 0.;
+	const double startTime = ( inputAVFormatContext.start_time != (int64_t)AV_NOPTS_VALUE ) ? (double)inputAVFormatContext.start_time / AV_TIME_BASE : 0.;
+
+	AVPacket packet;
+	av_init_packet( &packet );
+	packet.data = NULL;
+	packet.size = 0;
+
+	while( inputFormatContext.readFrame( packet ) )
+	{
+		// streams can be discovered during the reading
+		const int outputStreamIndex = ( (size_t)packet.stream_index < _outputStreamIndexes.size() ) ? _outputStreamIndexes.at( packet.stream_index ) : -1;
+		if( outputStreamIndex < 0 )
+		{
+			av_free_packet( &packet );
+			continue;
+		}
+
+		// rescale the timestamps to the time base of the output stream (set by the muxer when writing the header)
+		const AVRational inputTimeBase = inputFormatContext.getAVStream( packet.stream_index ).time_base;
+		const AVRational outputTimeBase = outputFormatContext.getAVStream( outputStreamIndex ).time_base;
+		if( packet.pts != (int64_t)AV_NOPTS_VALUE )
+			packet.pts = av_rescale_q( packet.pts, inputTimeBase, outputTimeBase );
+		if( packet.dts != (int64_t)AV_NOPTS_VALUE )
+			packet.dts = av_rescale_q( packet.dts, inputTimeBase, outputTimeBase );
+		if( packet.duration > 0 )
+			packet.duration = av_rescale_q( packet.duration, inputTimeBase, outputTimeBase );
+		packet.pos = -1;
+
+		const int64_t timestamp = ( packet.dts != (int64_t)AV_NOPTS_VALUE ) ? packet.dts : packet.pts;
+		packet.stream_index = outputStreamIndex;
+
+		_outputFile.wrapPacket( packet );
+		av_free_packet( &packet );
+
+		// check if JobStatusCancel
+		if( timestamp != (int64_t)AV_NOPTS_VALUE )
+		{
+			double processedDuration = av_q2d( outputTimeBase ) * timestamp - startTime;
+			if( processedDuration > duration )
+				processedDuration = duration;
+			if( progress.progress( processedDuration, duration ) == eJobStatusCancel )
+				break;
+		}
+	}
+
+	_outputFile.endWrap();
+
+	LOG_INFO( "End of remux" )
+
+	ProcessStat processStat;
+	fillProcessStat( processStat );
+	return processStat;
+}
+
+void Remuxer::fillProcessStat( ProcessStat& processStat )
+{
+	for( std::vector< size_t >::const_iterator it = _inputStreamIndexes.begin(); it != _inputStreamIndexes.end(); ++it )
+	{
+		const size_t streamIndex = _outputStreamIndexes.at( *it );
+		IOutputStream& stream = _outputFile.getStream( streamIndex );
+		const AVMediaType mediaType = _inputFile.getStream( *it ).getProperties().getStreamType();
+		switch( mediaType )
+		{
+			case AVMEDIA_TYPE_VIDEO:
+				processStat.addVideoStat( streamIndex, VideoStat( stream.getStreamDuration(), stream.getNbFrames() ) );
+				break;
+			case AVMEDIA_TYPE_AUDIO:
+				processStat.addAudioStat( streamIndex, AudioStat( stream.getStreamDuration(), stream.getNbFrames() ) );
+				break;
+			default:
+				LOG_WARN( "No process statistics for stream at index: " << streamIndex << " (AVMediaType = " << mediaType << ")" )
+				break;
+		}
+	}
+}
+
+}
@@ -0,0 +1,68 @@
+#ifndef _AV_TRANSCODER_REMUXER_HPP_
+#define _AV_TRANSCODER_REMUXER_HPP_
+
+#include <AvTranscoder/common.hpp>
+#include <AvTranscoder/file/InputFile.hpp>
+#include <AvTranscoder/file/OutputFile.hpp>
+#include <AvTranscoder/progress/IProgress.hpp>
+#include <AvTranscoder/stat/ProcessStat.hpp>
+
+#include <vector>
+
+namespace avtranscoder
+{
+
+/**
+ * @brief Rewrap streams of an input file to an output file, in a single pass.
+ * The input file is read once, in the order of its packets, and each packet of a selected stream
+ * is written as it is in the output file (only its timestamps are rescaled to the output stream).
+ * @note Prefer this class to the Transcoder to rewrap several streams of the same file: no packet is copied or cached.
+ * @see Transcoder to transcode streams, or to mix streams from several files
+ */
+class AvExport Remuxer
+{
+private:
+	Remuxer( const Remuxer& remuxer );
+	Remuxer& operator=( const Remuxer& remuxer );
+
+public:
+	Remuxer( InputFile& inputFile, OutputFile& outputFile );
+
+	/**
+	 * @brief Add a stream of the input file to rewrap.
+	 * @note The output streams are created in the order of the calls, after the streams already in the output file.
+	 * @exception throw std::runtime_error if the stream does not exist, or can't be rewrapped (subtitle, attachement...)
+	 */
+	void addStream( const size_t streamIndex );
+
+	/**
+	 * @brief Add all the video, audio and data streams of the input file.
+	 */
+	void addAllStreams();
+
+	/**
+	 * @brief Rewrap all the added streams until the end of the input file.
+	 * @note The function manages all process: beginWrap(), the rewrap of the packets, and endWrap().
+	 * @param progress: choose a progress, or create your own in C++ or in bindings by inherit IProgress class.
+	 * @return ProcessStat: object with statistics of the process for each output stream (key: output stream index).
+	 */
+	ProcessStat process( IProgress& progress );
+	ProcessStat process();  ///< Call process with no display of progression
+
+private:
+	/**
+	 * @brief Fill the given ProcessStat to summarize the process.
+	 */
+	void fillProcessStat( ProcessStat& processStat );
+
+private:
+	InputFile& _inputFile;  ///< Has link (no ownership)
+	OutputFile& _outputFile;  ///< Has link (no ownership)
+
+	std::vector< size_t > _inputStreamIndexes;  ///< Indexes of the input streams to rewrap, in the order they were added
+	std::vector< int > _outputStreamIndexes;  ///< Index of the output stream of each input stream (-1 if not rewrapped)
+};
+
+}
+
+#endif
@@ -13,9 +13,18 @@
 #include <AvTranscoder/transform/AudioTransform.hpp>
 #include <AvTranscoder/transform/VideoTransform.hpp>
 
+#include <AvTranscoder/stat/QualityMeter.hpp>
+#include <AvTranscoder/stat/ContentDetector.hpp>
+#include <AvTranscoder/mediaProperty/VideoProperties.hpp>
+
+extern "C" {
+#include <libavutil/avutil.h>
+}
+
 #include <cassert>
 #include <limits>
 #include <sstream>
+#include <algorithm>
 
 namespace avtranscoder
 {
@@ -37,6 +46,34 @@ StreamTranscoder::StreamTranscoder(
 	, _subStreamIndex( -1 )
 	, _offset( offset )
 	, _needToSwitchToGenerator( false )
+	, _replicateGeneratedFrames( true )
+	, _generatedData( NULL )
+	, _inPoint( 0 )
+	, _outPoint( 0 )
+	, _isOutPointReached( false )
+	, _resumedDuration( 0 )
+	, _firstWrappedData( NULL )
+	, _firstWrappedTime( -1 )
+	, _digestedData( 0 )
+	, _frameDigest( NULL )
+	, _decodedStreamDigest( NULL )
+	, _encodedStreamDigest( NULL )
+	, _digestReport( NULL )
+	, _reportedStreamIndex( 0 )
+	, _nbDecodedFramesDigested( 0 )
+	, _nbEncodedPacketsDigested( 0 )
+	, _qualityMeter( NULL )
+	, _videoContentDetector( NULL )
+	, _audioContentDetector( NULL )
+	, _decodeStat()
+	, _convertStat()
+	, _encodeStat()
+	, _metricsObserver( NULL )
+	, _metricsSamplingInterval( 1 )
+	, _metricsBatchSize( 1 )
+	, _metricsBatch()
+	, _nbWrappedPackets( 0 )
+	, _nbEncoderFrames( 0 )
 {
 	// create a re-wrapping case
 	switch( _inputStream->getProperties().getStreamType() )
@@ -139,6 +176,34 @@ StreamTranscoder::StreamTranscoder(
 	, _subStreamIndex( subStreamIndex )
 	, _offset( offset )
 	, _needToSwitchToGenerator( false )
+	, _replicateGeneratedFrames( true )
+	, _generatedData( NULL )
+	, _inPoint( 0 )
+	, _outPoint( 0 )
+	, _isOutPointReached( false )
+	, _resumedDuration( 0 )
+	, _firstWrappedData( NULL )
+	, _firstWrappedTime( -1 )
+	, _digestedData( 0 )
+	, _frameDigest( NULL )
+	, _decodedStreamDigest( NULL )
+	, _encodedStreamDigest( NULL )
+	, _digestReport( NULL )
+	, _reportedStreamIndex( 0 )
+	, _nbDecodedFramesDigested( 0 )
+	, _nbEncodedPacketsDigested( 0 )
+	, _qualityMeter( NULL )
+	, _videoContentDetector( NULL )
+	, _audioContentDetector( NULL )
+	, _decodeStat()
+	, _convertStat()
+	, _encodeStat()
+	, _metricsObserver( NULL )
+	, _metricsSamplingInterval( 1 )
+	, _metricsBatchSize( 1 )
+	, _metricsBatch()
+	, _nbWrappedPackets( 0 )
+	, _nbEncoderFrames( 0 )
 {
 	// create a transcode case
 	switch( _inputStream->getProperties().getStreamType() )
@@ -244,6 +309,34 @@ StreamTranscoder::StreamTranscoder(
 	, _subStreamIndex( -1 )
 	, _offset( 0 )
 	, _needToSwitchToGenerator( false )
+	, _replicateGeneratedFrames( true )
+	, _generatedData( NULL )
+	, _inPoint( 0 )
+	, _outPoint( 0 )
+	, _isOutPointReached( false )
+	, _resumedDuration( 0 )
+	, _firstWrappedData( NULL )
+	, _firstWrappedTime( -1 )
+	, _digestedData( 0 )
+	, _frameDigest( NULL )
+	, _decodedStreamDigest( NULL )
+	, _encodedStreamDigest( NULL )
+	, _digestReport( NULL )
+	, _reportedStreamIndex( 0 )
+	, _nbDecodedFramesDigested( 0 )
+	, _nbEncodedPacketsDigested( 0 )
+	, _qualityMeter( NULL )
+	, _videoContentDetector( NULL )
+	, _audioContentDetector( NULL )
+	, _decodeStat()
+	, _convertStat()
+	, _encodeStat()
+	, _metricsObserver( NULL )
+	, _metricsSamplingInterval( 1 )
+	, _metricsBatchSize( 1 )
+	, _metricsBatch()
+	, _nbWrappedPackets( 0 )
+	, _nbEncoderFrames( 0 )
 {
 	if( profile.find( constants::avProfileType )->second == constants::avProfileTypeVideo )
 	{
@@ -313,6 +406,14 @@ StreamTranscoder::~StreamTranscoder()
 	delete _outputEncoder;
 	delete _transform;
 	delete _inputDecoder;
+	delete _generatedData;
+	delete _firstWrappedData;
+	delete _frameDigest;
+	delete _decodedStreamDigest;
+	delete _encodedStreamDigest;
+	delete _qualityMeter;
+	delete _videoContentDetector;
+	delete _audioContentDetector;
 }
 
 void StreamTranscoder::preProcessCodecLatency()
@@ -414,7 +515,29 @@ bool StreamTranscoder::processRewrap()
 	}
 
 	CodedData data;
-	if( ! _inputStream->readNextPacket( data ) )
+	bool readingStatus = false;
+	if( _firstWrappedData )
+	{
+		// packet read when the time range was set
+		data = *_firstWrappedData;
+		delete _firstWrappedData;
+		_firstWrappedData = NULL;
+		readingStatus = ! _isOutPointReached;
+	}
+	else
+		readingStatus = ! _isOutPointReached && _inputStream->readNextPacket( data );
+	if( readingStatus && _outPoint > 0 )
+	{
+		const AVPacket& packet = data.getAVPacket();
+		const int64_t timestamp = ( packet.pts != (int64_t)AV_NOPTS_VALUE ) ? packet.pts : packet.dts;
+		if( timestamp != (int64_t)AV_NOPTS_VALUE && getTime( timestamp ) >= _outPoint )
+		{
+			endAtOutPoint();
+			readingStatus = false;
+		}
+	}
+
+	if( ! readingStatus )
 	{
 		if( _needToSwitchToGenerator )
 		{
@@ -424,14 +547,17 @@ bool StreamTranscoder::processRewrap()
 		return false;
 	}
 
-	const IOutputStream::EWrappingStatus wrappingStatus = _outputStream->wrap( data );
+	digestFrame( data, eDigestedDataEncoded );
+	double wrapTime = 0;
+	const IOutputStream::EWrappingStatus wrappingStatus = wrap( data, wrapTime );
+	observePacket( data, false, 0, 0, 0, wrapTime );
 	switch( wrappingStatus )
 	{
 		case IOutputStream::eWrappingSuccess:
 			return true;
 		case IOutputStream::eWrappingWaitingForData:
-			// the wrapper needs more data to write the current packet
-			return processFrame();
+			// the wrapper needs more data of this stream: the Transcoder will process it again
+			return true;
 		case IOutputStream::eWrappingError:
 			return false;
 	}
@@ -450,26 +576,52 @@ bool StreamTranscoder::processTranscode( const int subStreamIndex )
 
 	LOG_DEBUG( "StreamTranscoder::processTranscode" )
 
-	LOG_DEBUG( "Decode next frame" )
-	bool decodingStatus = false;
-	if( subStreamIndex < 0 )
-		decodingStatus = _currentDecoder->decodeNextFrame( *_sourceBuffer );
-	else
-		decodingStatus = _currentDecoder->decodeNextFrame( *_sourceBuffer, subStreamIndex );
+	if( _currentDecoder == _generator && _replicateGeneratedFrames && getProcessCase() != eProcessCaseGenerator && isIntraOnlyEncoding() )
+		return processGeneratedFrameReplication();
 
+	LOG_DEBUG( "Decode next frame" )
+	// the packets read from the input stream are demuxed during the decoding
+	const StageStat* demuxStat = _currentDecoder == _inputDecoder ? &_inputStream->getDemuxStat() : NULL;
+	const size_t demuxedSize = demuxStat ? demuxStat->_outputSize : 0;
+	StageTimer decodeTimer( _decodeStat, "decode", _outputStream->getStreamIndex(), demuxStat );
+	const bool decodingStatus = decodeNextFrame( subStreamIndex );
+	const double decodeTime = decodeTimer.stop( demuxStat ? demuxStat->_outputSize - demuxedSize : 0, decodingStatus ? _sourceBuffer->getSize() : 0 );
+
+	double convertTime = 0;
+	double encodeTime = 0;
 	CodedData data;
 	if( decodingStatus )
 	{
+		if( _currentDecoder == _inputDecoder )
+		{
+			digestFrame( *_sourceBuffer, eDigestedDataDecoded );
+			if( _videoContentDetector )
+				_videoContentDetector->process( *_sourceBuffer );
+			if( _audioContentDetector )
+				_audioContentDetector->process( *_sourceBuffer );
+		}
+
 		LOG_DEBUG( "Convert (" << _sourceBuffer->getSize() << " bytes)" )
+		StageTimer convertTimer( _convertStat, "convert", _outputStream->getStreamIndex() );
 		_transform->convert( *_sourceBuffer, *_frameBuffer );
+		convertTime = convertTimer.stop( _sourceBuffer->getSize(), _frameBuffer->getSize() );
+
+		if( _qualityMeter )
+			_qualityMeter->addSourceFrame( static_cast<VideoFrame&>( *_frameBuffer ) );
 
 		LOG_DEBUG( "Encode (" << _frameBuffer->getSize() << " bytes)" )
+		StageTimer encodeTimer( _encodeStat, "encode", _outputStream->getStreamIndex() );
 		_outputEncoder->encodeFrame( *_frameBuffer, data );
+		encodeTime = encodeTimer.stop( _frameBuffer->getSize(), data.getSize() );
+		++_nbEncoderFrames;
 	}
 	else
 	{
 		LOG_DEBUG( "Encode last frame(s)" )
-		if( ! _outputEncoder->encodeFrame( data ) )
+		StageTimer encodeTimer( _encodeStat, "encode", _outputStream->getStreamIndex() );
+		const bool isEncoded = _outputEncoder->encodeFrame( data );
+		encodeTime = encodeTimer.stop( 0, data.getSize() );
+		if( ! isEncoded )
 		{
 			if( _needToSwitchToGenerator )
 			{
@@ -480,15 +632,137 @@ bool StreamTranscoder::processTranscode( const int subStreamIndex )
 		}
 	}
 
+	if( data.getSize() )
+	{
+		digestFrame( data, eDigestedDataEncoded );
+		if( _qualityMeter )
+			_qualityMeter->addEncodedData( data );
+	}
+
 	LOG_DEBUG( "wrap (" << data.getSize() << " bytes)" )
-	const IOutputStream::EWrappingStatus wrappingStatus = _outputStream->wrap( data );
+	double wrapTime = 0;
+	const IOutputStream::EWrappingStatus wrappingStatus = wrap( data, wrapTime );
+	if( data.getSize() )
+		observePacket( data, true, decodeTime, convertTime, encodeTime, wrapTime );
+	switch( wrappingStatus )
+	{
+		case IOutputStream::eWrappingSuccess:
+			return true;
+		case IOutputStream::eWrappingWaitingForData:
+			// the wrapper needs more data of this stream: the Transcoder will process it again
+			return true;
+		case IOutputStream::eWrappingError:
+			return false;
+	}
+
+	return true;
+}
+
+bool StreamTranscoder::decodeNextFrame( const int subStreamIndex )
+{
+	if( _currentDecoder == _inputDecoder && _isOutPointReached )
+		return false;
+
+	while( true )
+	{
+		bool decodingStatus = false;
+		if( subStreamIndex < 0 )
+			decodingStatus = _currentDecoder->decodeNextFrame( *_sourceBuffer );
+		else
+			decodingStatus = _currentDecoder->decodeNextFrame( *_sourceBuffer, subStreamIndex );
+
+		if( ! decodingStatus || _currentDecoder != _inputDecoder || ( _inPoint <= 0 && _outPoint <= 0 && _resumedDuration <= 0 ) )
+			return decodingStatus;
+
+		// frames without timestamp are considered in the range
+		const int64_t timestamp = _inputDecoder->getLastDecodedTimestamp();
+		if( timestamp == (int64_t)AV_NOPTS_VALUE )
+			return true;
+
+		const double time = getTime( timestamp );
+		if( _outPoint > 0 && time >= _outPoint )
+		{
+			endAtOutPoint();
+			return false;
+		}
+
+		// tolerance for the rounding of the timestamps
+		if( time + 1e-6 >= _inPoint + _resumedDuration )
+			return true;
+
+		LOG_DEBUG( "Skip the frame at " << time << "s, decoded before the first frame to process" )
+	}
+}
+
+double StreamTranscoder::getTime( const int64_t timestamp ) const
+{
+	const StreamProperties& streamProperties = _inputStream->getProperties();
+	const AVStream& avStream = *streamProperties.getAVFormatContext().streams[ streamProperties.getStreamIndex() ];
+	return timestamp * av_q2d( avStream.time_base ) - streamProperties.getStartTime();
+}
+
+void StreamTranscoder::readFirstWrappedPacket()
+{
+	CodedData* data = new CodedData();
+	if( ! _inputStream->readNextPacket( *data ) )
+	{
+		delete data;
+		return;
+	}
+	_firstWrappedData = data;
+
+	const AVPacket& packet = data->getAVPacket();
+	const int64_t timestamp = ( packet.pts != (int64_t)AV_NOPTS_VALUE ) ? packet.pts : packet.dts;
+	if( timestamp != (int64_t)AV_NOPTS_VALUE )
+		_firstWrappedTime = getTime( timestamp );
+	LOG_INFO( "Rewrap stream " << _inputStream->getStreamIndex() << " from the keyframe at " << _firstWrappedTime << "s, before the in point (" << _inPoint << "s)" )
+}
+
+void StreamTranscoder::endAtOutPoint()
+{
+	LOG_INFO( "End of stream " << _inputStream->getStreamIndex() << " at the out point (" << _outPoint << "s)" )
+	_isOutPointReached = true;
+
+	// the packets after the out point are not processed
+	_inputStream->clearBuffering();
+}
+
+bool StreamTranscoder::processGeneratedFrameReplication()
+{
+	// encode the generated frame once
+	if( ! _generatedData )
+	{
+		LOG_DEBUG( "Encode the generated frame to replicate" )
+		_currentDecoder->decodeNextFrame( *_sourceBuffer );
+		_transform->convert( *_sourceBuffer, *_frameBuffer );
+
+		CodedData data;
+		_outputEncoder->encodeFrame( *_frameBuffer, data );
+		if( ! data.getSize() )
+		{
+			LOG_WARN( "The encoder did not output the generated frame: encode each generated frame" )
+			_replicateGeneratedFrames = false;
+			// the generated frame of this call is delayed by the encoder, as in processTranscode
+			++_nbEncoderFrames;
+			double wrapTime = 0;
+			return wrap( data, wrapTime ) != IOutputStream::eWrappingError;
+		}
+		_generatedData = new CodedData( data );
+	}
+
+	// wrap the same coded data (timestamps are set by the wrapper)
+	digestFrame( *_generatedData, eDigestedDataEncoded );
+	LOG_DEBUG( "wrap replicated generated frame (" << _generatedData->getSize() << " bytes)" )
+	double wrapTime = 0;
+	const IOutputStream::EWrappingStatus wrappingStatus = wrap( *_generatedData, wrapTime );
+	observePacket( *_generatedData, false, 0, 0, 0, wrapTime );
 	switch( wrappingStatus )
 	{
 		case IOutputStream::eWrappingSuccess:
 			return true;
 		case IOutputStream::eWrappingWaitingForData:
-			// the wrapper needs more data to write the current packet
-			return processFrame();
+			// the wrapper needs more data of this stream: the Transcoder will process it again
+			return true;
 		case IOutputStream::eWrappingError:
 			return false;
 	}
@@ -496,6 +770,227 @@ bool StreamTranscoder::processTranscode( const int subStreamIndex )
 	return true;
 }
 
+void StreamTranscoder::setFrameDigest( const EDigestAlgorithm algorithm, const int digestedData )
+{
+	delete _frameDigest;
+	delete _decodedStreamDigest;
+	delete _encodedStreamDigest;
+	_frameDigest = NULL;
+	_decodedStreamDigest = NULL;
+	_encodedStreamDigest = NULL;
+	_nbDecodedFramesDigested = 0;
+	_nbEncodedPacketsDigested = 0;
+
+	_digestedData = digestedData;
+	if( ! _digestedData )
+		return;
+
+	// no decoded frame when rewrap
+	if( getProcessCase() == eProcessCaseRewrap )
+		_digestedData &= ~eDigestedDataDecoded;
+
+	LOG_INFO( "Digest the " << ( ( _digestedData & eDigestedDataDecoded ) ? "decoded frames " : "" ) << ( ( _digestedData & eDigestedDataEncoded ) ? "encoded packets " : "" )
+		<< "of stream " << ( _inputStream ? _inputStream->getStreamIndex() : -1 ) << " with " << getDigestAlgorithmName( algorithm ) )
+	_frameDigest = new Digest( algorithm );
+	if( _digestedData & eDigestedDataDecoded )
+		_decodedStreamDigest = new Digest( algorithm );
+	if( _digestedData & eDigestedDataEncoded )
+		_encodedStreamDigest = new Digest( algorithm );
+}
+
+void StreamTranscoder::setQualityMeasurement( const bool measure )
+{
+	delete _qualityMeter;
+	_qualityMeter = NULL;
+	if( ! measure )
+		return;
+
+	VideoEncoder* videoEncoder = dynamic_cast<VideoEncoder*>( _outputEncoder );
+	if( ! videoEncoder || getProcessCase() == eProcessCaseRewrap )
+	{
+		LOG_WARN( "Unable to measure the quality of stream " << _inputStream->getStreamIndex() << ": it is not an encoded video stream" )
+		return;
+	}
+	_qualityMeter = new QualityMeter( videoEncoder->getVideoCodec(), static_cast<VideoFrame*>( _frameBuffer )->desc() );
+}
+
+void StreamTranscoder::setContentDetection( const bool detect )
+{
+	delete _videoContentDetector;
+	_videoContentDetector = NULL;
+	delete _audioContentDetector;
+	_audioContentDetector = NULL;
+	if( ! detect )
+		return;
+
+	if( ! _inputDecoder || getProcessCase() == eProcessCaseRewrap )
+	{
+		LOG_WARN( "Unable to detect the content of stream " << ( _inputStream ? _inputStream->getStreamIndex() : -1 ) << ": it is not a decoded stream" )
+		return;
+	}
+
+	if( _inputStream->getProperties().getStreamType() == AVMEDIA_TYPE_VIDEO )
+	{
+		// the frame rate of the stream, more reliable than the time base of the codec
+		const VideoFrameDesc& frameDesc = static_cast<VideoFrame*>( _sourceBuffer )->desc();
+		const VideoProperties* videoProperties = dynamic_cast<const VideoProperties*>( &_inputStream->getProperties() );
+		const double fps = videoProperties && videoProperties->getFps() > 0 ? videoProperties->getFps() : frameDesc.getFps();
+		_videoContentDetector = new VideoContentDetector( frameDesc, fps );
+	}
+	else
+	{
+		_audioContentDetector = new AudioContentDetector( static_cast<AudioFrame*>( _sourceBuffer )->desc() );
+	}
+	setContentDetectionStartTime();
+}
+
+void StreamTranscoder::setContentDetectionStartTime()
+{
+	// the segments are in the time of the input stream, as the in point
+	const double startTime = _inPoint + _resumedDuration;
+	if( _videoContentDetector )
+		_videoContentDetector->setStartTime( startTime );
+	if( _audioContentDetector )
+		_audioContentDetector->setStartTime( startTime );
+}
+
+void StreamTranscoder::setMetricsObserver( IMetricsObserver* observer, const size_t samplingInterval, const size_t batchSize )
+{
+	flushMetrics();
+	_metricsObserver = observer;
+	_metricsSamplingInterval = std::max( samplingInterval, (size_t)1 );
+	_metricsBatchSize = std::max( batchSize, (size_t)1 );
+	_metricsBatch.reserve( _metricsBatchSize );
+}
+
+void StreamTranscoder::flushMetrics()
+{
+	if( ! _metricsObserver || _metricsBatch.empty() )
+		return;
+
+	// the metrics are not given twice if the observer throws
+	try
+	{
+		_metricsObserver->onFrameMetrics( _metricsBatch );
+	}
+	catch( ... )
+	{
+		_metricsBatch.clear();
+		throw;
+	}
+	_metricsBatch.clear();
+}
+
+IOutputStream::EWrappingStatus StreamTranscoder::wrap( const CodedData& data, double& wrapTime )
+{
+	// the time spent by the output file to write the packets of this stream (the packets are buffered when interleaved)
+	const double previousWrapTime = _outputStream->getWrapStat()._wallTime;
+	const IOutputStream::EWrappingStatus wrappingStatus = _outputStream->wrap( data );
+	wrapTime = _outputStream->getWrapStat()._wallTime - previousWrapTime;
+	return wrappingStatus;
+}
+
+void StreamTranscoder::observePacket( const CodedData& data, const bool isEncoded, const double decodeTime, const double convertTime, const double encodeTime, const double wrapTime )
+{
+	// the encoder outputs a packet for one of the frames it has been given
+	if( isEncoded && _nbEncoderFrames )
+		--_nbEncoderFrames;
+
+	const size_t packetIndex = _nbWrappedPackets++;
+	if( ! _metricsObserver || packetIndex % _metricsSamplingInterval )
+		return;
+
+	FrameMetrics metrics;
+	metrics._streamIndex = _outputStream->getStreamIndex();
+	metrics._frame = packetIndex;
+	metrics._time = _outputStream->getStreamDuration();
+	metrics._size = data.getSize();
+	metrics._isKeyFrame = ( data.getAVPacket().flags & AV_PKT_FLAG_KEY ) != 0;
+	if( isEncoded )
+	{
+		// the encoder describes the picture of its last output packet
+		const AVFrame* codedFrame = _outputEncoder->getCodec().getAVCodecContext().coded_frame;
+		if( codedFrame )
+		{
+			metrics._quality = codedFrame->quality;
+			metrics._qp = codedFrame->quality / (double)FF_QP2LAMBDA;
+			if( getStreamType() == AVMEDIA_TYPE_VIDEO )
+				metrics._pictureType = av_get_picture_type_char( codedFrame->pict_type );
+		}
+	}
+	metrics._decodeTime = decodeTime;
+	metrics._convertTime = convertTime;
+	metrics._encodeTime = encodeTime;
+	metrics._wrapTime = wrapTime;
+	metrics._nbCachedPackets = _inputStream ? _inputStream->getNbCachedPackets() : 0;
+	metrics._nbEncoderFrames = _nbEncoderFrames;
+
+	_metricsBatch.push_back( metrics );
+	if( _metricsBatch.size() >= _metricsBatchSize )
+		flushMetrics();
+}
+
+std::string StreamTranscoder::getDecodedStreamDigest() const
+{
+	return _decodedStreamDigest ? _decodedStreamDigest->getHexDigest() : "";
+}
+
+void StreamTranscoder::setDigestReport( std::ostream* report, const size_t reportedStreamIndex )
+{
+	_digestReport = report;
+	_reportedStreamIndex = reportedStreamIndex;
+}
+
+std::string StreamTranscoder::getEncodedStreamDigest() const
+{
+	return _encodedStreamDigest ? _encodedStreamDigest->getHexDigest() : "";
+}
+
+void StreamTranscoder::digestFrame( const Frame& frame, const EDigestedData digestedData )
+{
+	if( ! ( _digestedData & digestedData ) )
+		return;
+
+	// the data is still in cache
+	_frameDigest->reset();
+	_frameDigest->update( frame.getData(), frame.getSize() );
+	if( digestedData == eDigestedDataDecoded )
+	{
+		_decodedStreamDigest->update( frame.getData(), frame.getSize() );
+		if( _digestReport )
+			*_digestReport << _reportedStreamIndex << ",decoded," << _nbDecodedFramesDigested << "," << _frameDigest->getHexDigest() << "\n";
+		++_nbDecodedFramesDigested;
+	}
+	else
+	{
+		_encodedStreamDigest->update( frame.getData(), frame.getSize() );
+		if( _digestReport )
+			*_digestReport << _reportedStreamIndex << ",encoded," << _nbEncodedPacketsDigested << "," << _frameDigest->getHexDigest() << "\n";
+		++_nbEncodedPacketsDigested;
+	}
+}
+
+bool StreamTranscoder::isIntraOnlyEncoding() const
+{
+	if( ! _outputEncoder )
+		return false;
+
+	const AVCodecContext& avCodecContext = _outputEncoder->getCodec().getAVCodecContext();
+
+	// the first coded data could be a delayed frame
+	if( avCodecContext.codec && ( avCodecContext.codec->capabilities & CODEC_CAP_DELAY ) )
+		return false;
+	if( avCodecContext.active_thread_type & FF_THREAD_FRAME )
+		return false;
+
+	// PCM
+	if( avCodecContext.codec_id >= AV_CODEC_ID_PCM_S16LE && avCodecContext.codec_id < AV_CODEC_ID_ADPCM_IMA_QT )
+		return true;
+
+	const AVCodecDescriptor* avCodecDescriptor = avcodec_descriptor_get( avCodecContext.codec_id );
+	return avCodecDescriptor && ( avCodecDescriptor->props & AV_CODEC_PROP_INTRA_ONLY );
+}
+
 void StreamTranscoder::switchToGeneratorDecoder()
 {
 	LOG_INFO( "Switch to generator decoder" )
@@ -517,7 +1012,15 @@ float StreamTranscoder::getDuration() const
 	if( _inputStream )
 	{
 		const StreamProperties& streamProperties = _inputStream->getProperties();
-		const float totalDuration = streamProperties.getDuration() + _offset;
+		float streamDuration = streamProperties.getDuration();
+		if( _outPoint > 0 && _outPoint < streamDuration )
+			streamDuration = _outPoint;
+		// a rewrap starts at the keyframe before the in point
+		if( _firstWrappedTime >= 0 && _firstWrappedTime < _inPoint )
+			streamDuration -= _firstWrappedTime;
+		else
+			streamDuration -= _inPoint;
+		const float totalDuration = streamDuration + _offset;
 		if( totalDuration < 0 )
 		{
 			LOG_WARN( "Offset of " << _offset << "s applied to a stream with a duration of " << streamProperties.getDuration() << "s. Set its duration to 0s." )
@@ -555,6 +1058,56 @@ void StreamTranscoder::setOffset( const float offset )
 		needToSwitchToGenerator();
 }
 
+void StreamTranscoder::setTimeRange( const double inPoint, const double outPoint )
+{
+	if( ! _inputStream )
+		throw std::runtime_error( "Can't set a time range to a generated stream" );
+
+	if( inPoint < 0 || ( outPoint > 0 && outPoint <= inPoint ) )
+	{
+		std::stringstream os;
+		os << "Invalid time range [" << inPoint << "s, " << outPoint << "s] for the stream " << _inputStream->getStreamIndex();
+		throw std::runtime_error( os.str() );
+	}
+	_inPoint = inPoint;
+	_outPoint = outPoint;
+	setContentDetectionStartTime();
+
+	// the duration of a rewrap depends on the time of its first packet
+	if( getProcessCase() == eProcessCaseRewrap && _inPoint > 0 && ! _firstWrappedData )
+		readFirstWrappedPacket();
+}
+
+bool StreamTranscoder::canResume() const
+{
+	if( getProcessCase() == eProcessCaseRewrap || _offset != 0 )
+		return false;
+	return isIntraOnlyEncoding();
+}
+
+double StreamTranscoder::resume( const double processedDuration )
+{
+	if( ! _inputStream )
+		return -1;
+
+	LOG_INFO( "Resume the process of stream " << _inputStream->getStreamIndex() << " after " << processedDuration << "s" )
+	_resumedDuration = processedDuration;
+	setContentDetectionStartTime();
+	return _inPoint + _resumedDuration;
+}
+
+StageStat StreamTranscoder::getDemuxStat() const
+{
+	return _inputStream ? _inputStream->getDemuxStat() : StageStat();
+}
+
+AVMediaType StreamTranscoder::getStreamType() const
+{
+	if( _inputStream )
+		return _inputStream->getProperties().getStreamType();
+	return _outputEncoder->getCodec().getAVCodecContext().codec_type;
+}
+
 StreamTranscoder::EProcessCase StreamTranscoder::getProcessCase() const
 {
 	if( _inputStream && _inputDecoder )
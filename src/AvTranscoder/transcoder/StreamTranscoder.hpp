@@ -13,10 +13,31 @@
 
 #include <AvTranscoder/profile/ProfileLoader.hpp>
 
+#include <AvTranscoder/Digest.hpp>
+#include <AvTranscoder/stat/StageStat.hpp>
+#include <AvTranscoder/stat/IMetricsObserver.hpp>
+
+#include <vector>
+#include <string>
+#include <ostream>
+
 namespace avtranscoder
 {
 
 class ITransform;
+class QualityMeter;
+class VideoContentDetector;
+class AudioContentDetector;
+
+/**
+ * @brief Data digested by a StreamTranscoder.
+ */
+enum EDigestedData
+{
+	eDigestedDataDecoded = 1,  ///< Frames decoded from the input stream
+	eDigestedDataEncoded = 2,  ///< Packets given to the output stream (encoded or rewrapped)
+	eDigestedDataAll = eDigestedDataDecoded | eDigestedDataEncoded
+};
 
 class AvExport StreamTranscoder
 {
@@ -67,6 +88,7 @@ public:
 	 * @brief Get the total duration (in seconds), ie. duration of the stream and the offset applies
 	 * @note if it's a generated stream, return limit of double.
 	 * @note if offset > duration of the stream, return 0
+	 * @note if a time range is set, the duration of the stream is the duration of the range
 	 */
 	float getDuration() const;
 
@@ -83,6 +105,12 @@ public:
 	/// Returns a reference to the stream which wraps data
 	IOutputStream& getOutputStream() const { return *_outputStream; }
 
+	/**
+	 * @brief Returns the type of the processed stream (video, audio...).
+	 * @note The generated streams have no input stream: their type is given by their encoder.
+	 */
+	AVMediaType getStreamType() const;
+
 	/**
 	 * @brief Returns if the stream has the ability to switch to a generator.
 	 */
@@ -101,9 +129,171 @@ public:
 	 */
 	void setOffset( const float offset );
 
+	/**
+	 * @brief Set if the frames generated to pad the stream (offset, end of stream) are encoded only once.
+	 * The coded data of the first generated frame is wrapped again for the next ones.
+	 * @note Only applied if the output codec is intra-only and has no delay (DNxHD, ProRes, MJPEG, DV, PCM...).
+	 * @note By default true.
+	 */
+	void setReplicateGeneratedFrames( const bool replicate = true ) { _replicateGeneratedFrames = replicate; }
+
+	/**
+	 * @brief Process only the given range of the input stream.
+	 * @param inPoint: time in seconds, from the beginning of the stream, of the first frame to process
+	 * @param outPoint: time in seconds, from the beginning of the stream, at which the process of the stream ends (0 to process until the end)
+	 * @note The input stream should be positioned before the in point (seek to the previous keyframe): the frames decoded before the in point are not encoded.
+	 * @note When rewrap, the process starts at the position of the input stream and ends at the first packet after the out point.
+	 * The first packet is read to get the duration of the stream from its time, which is the time of the keyframe before the in point.
+	 * @exception throw std::runtime_error if the range is empty
+	 */
+	void setTimeRange( const double inPoint, const double outPoint = 0 );
+
+	/**
+	 * @brief Returns if the process of the stream can be resumed at any frame.
+	 * The stream has to be transcoded with an intra-only encoder without delay, with no offset.
+	 * @see Transcoder::setCheckpoint
+	 */
+	bool canResume() const;
+
+	/**
+	 * @brief Resume the process of the stream after the given duration of the output stream.
+	 * @return the time in seconds, from the beginning of the input stream, of the first frame to process (-1 for a generated stream)
+	 * @note The caller has to position the input file before this time.
+	 */
+	double resume( const double processedDuration );
+
+	/**
+	 * @brief Compute the digest of each frame while it is processed, to check the output without decoding it again.
+	 * @param digestedData: frames decoded from the input stream and/or packets given to the output stream (see EDigestedData)
+	 * @note The generated frames (offset, end of stream) are digested only in the packets given to the output stream.
+	 * @note By default no digest.
+	 */
+	void setFrameDigest( const EDigestAlgorithm algorithm, const int digestedData = eDigestedDataAll );
+
+#ifndef SWIG
+	/**
+	 * @brief Write a line "stream,data,frame,digest" in the given report for each digested frame, as soon as it is computed.
+	 * @param report: has link, no ownership (NULL to stop writing)
+	 * @param reportedStreamIndex: index of the stream written in the report
+	 */
+	void setDigestReport( std::ostream* report, const size_t reportedStreamIndex );
+#endif
+
+	//@{
+	/** Returns the digest of all the data decoded / encoded since the beginning of the process (empty if not digested) */
+	std::string getDecodedStreamDigest() const;
+	std::string getEncodedStreamDigest() const;
+	//@}
+
+	/**
+	 * @brief Measure the PSNR and the SSIM of the encoded frames, by decoding them on a side thread.
+	 * @note Only when a video stream is encoded. By default no measure.
+	 * @exception throw std::runtime_error if the encoded frames can't be decoded
+	 * @see QualityMeter
+	 */
+	void setQualityMeasurement( const bool measure = true );
+
+	/// Returns the measure of the quality of the encoded frames (NULL if not measured)
+	QualityMeter* getQualityMeter() const { return _qualityMeter; }
+
+	/**
+	 * @brief Detect the black and frozen frames of a video stream, or the silence of an audio stream, in the decoded frames.
+	 * @note Only the frames decoded from the input stream are analysed. By default no detection.
+	 * @note The segments are in the time of the input stream, from the in point (and the resumed duration).
+	 * @see VideoContentDetector
+	 * @see AudioContentDetector
+	 */
+	void setContentDetection( const bool detect = true );
+
+	//@{
+	/** Returns the detection of the content of the decoded frames (NULL if not detected) */
+	VideoContentDetector* getVideoContentDetector() const { return _videoContentDetector; }
+	AudioContentDetector* getAudioContentDetector() const { return _audioContentDetector; }
+	//@}
+
+	//@{
+	/**
+	 * @brief Returns the statistics of each stage of the process of the stream, since its beginning.
+	 * @note The demux statistics are the ones of the input stream (empty for a generated stream).
+	 * @note The decode statistics do not include the time spent to demux the packets, and include the generated frames.
+	 * @see OutputFile::getMuxStat
+	 */
+	StageStat getDemuxStat() const;
+	const StageStat& getDecodeStat() const { return _decodeStat; }
+	const StageStat& getConvertStat() const { return _convertStat; }
+	const StageStat& getEncodeStat() const { return _encodeStat; }
+	//@}
+
+	/**
+	 * @brief Give the metrics of the packets given to the output stream to the observer, during the process.
+	 * @param observer: NULL to remove the observer (has link, no ownership)
+	 * @param samplingInterval: the metrics of one packet out of this number are given to the observer (at least 1)
+	 * @param batchSize: number of metrics given to each call of the observer (at least 1)
+	 * @note The last metrics, which do not fill a batch, are given by flushMetrics.
+	 * @see IMetricsObserver
+	 */
+	void setMetricsObserver( IMetricsObserver* observer, const size_t samplingInterval = 1, const size_t batchSize = 25 );
+
+	/**
+	 * @brief Give the metrics which are not given yet to the observer, if any.
+	 */
+	void flushMetrics();
+
 private:
 	bool processRewrap();
 	bool processTranscode( const int subStreamIndex = -1 );  ///< By default transcode all channels
+	bool processGeneratedFrameReplication();
+
+	/**
+	 * @brief Wrap the data in the output stream.
+	 * @param wrapTime: set to the time spent to write the packets of the stream in the output file, in seconds (measured by the output file)
+	 */
+	IOutputStream::EWrappingStatus wrap( const CodedData& data, double& wrapTime );
+
+	/**
+	 * @brief Decode the next frame of the current decoder, in the time range of the stream.
+	 * @return false at the end of the stream, or after the out point.
+	 */
+	bool decodeNextFrame( const int subStreamIndex );
+
+	/**
+	 * @brief Returns the time in seconds, from the beginning of the input stream, of the given timestamp.
+	 * @see StreamProperties::getStartTime
+	 */
+	double getTime( const int64_t timestamp ) const;
+
+	/**
+	 * @brief Read the first packet to rewrap, to know the time at which the rewrap starts.
+	 */
+	void readFirstWrappedPacket();
+
+	/**
+	 * @brief Give the time of the first decoded frame in the input stream to the content detectors.
+	 */
+	void setContentDetectionStartTime();
+
+	/**
+	 * @brief End the process of the input stream at the out point.
+	 */
+	void endAtOutPoint();
+
+	/**
+	 * @brief Add the digest of the given data to the digests of the stream, and write it in the report, if it is digested.
+	 */
+	void digestFrame( const Frame& frame, const EDigestedData digestedData );
+
+	/**
+	 * @brief Returns if each frame is encoded independently, without delay (intra-only video codecs, PCM).
+	 * @note Each generated frame is encoded to the same coded data, and each encoded frame is a GOP boundary.
+	 */
+	bool isIntraOnlyEncoding() const;
+
+	/**
+	 * @brief Count the given packet, given to the output stream, and add its metrics to the batch if it is sampled.
+	 * @param isEncoded: if the packet is encoded by the stream (not rewrapped or replicated)
+	 * @param decodeTime, convertTime, encodeTime, wrapTime: time spent in each stage for this packet, in seconds
+	 */
+	void observePacket( const CodedData& data, const bool isEncoded, const double decodeTime, const double convertTime, const double encodeTime, const double wrapTime );
 
 	//@{
 	// Get the current process case.
@@ -134,6 +324,41 @@ private:
 	float _offset;  ///< Offset, in seconds, at the beginning of the StreamTranscoder.
 
 	bool _needToSwitchToGenerator;  ///< Set if need to switch to a generator during the process (because, of other streams duration, or an offset)
+
+	bool _replicateGeneratedFrames;  ///< Set if the coded data of the generated frames is replicated instead of encoded
+	CodedData* _generatedData;  ///< Coded data of the generated frame, to replicate (has ownership)
+
+	double _inPoint;  ///< Time, in seconds, of the first frame to process in the input stream
+	double _outPoint;  ///< Time, in seconds, at which the process of the input stream ends (0 if no out point)
+	bool _isOutPointReached;  ///< Set if the input stream is processed until its out point
+	double _resumedDuration;  ///< Duration, in seconds, of the output stream processed before resuming the process
+	CodedData* _firstWrappedData;  ///< First packet to rewrap, read when the time range is set (has ownership, NULL once wrapped)
+	double _firstWrappedTime;  ///< Time, in seconds, of the first packet to rewrap in the input stream (-1 if unknown)
+
+	int _digestedData;  ///< Data digested during the process (see EDigestedData, 0 if no digest)
+	Digest* _frameDigest;  ///< Digest of the current frame (has ownership)
+	Digest* _decodedStreamDigest;  ///< Digest of all the decoded frames (has ownership)
+	Digest* _encodedStreamDigest;  ///< Digest of all the encoded packets (has ownership)
+	std::ostream* _digestReport;  ///< Report in which the digest of each frame is written (has link, no ownership, NULL if no report)
+	size_t _reportedStreamIndex;  ///< Index of the stream in the digest report
+	size_t _nbDecodedFramesDigested;
+	size_t _nbEncodedPacketsDigested;
+
+	QualityMeter* _qualityMeter;  ///< Measure of the quality of the encoded frames (has ownership, NULL if not measured)
+
+	VideoContentDetector* _videoContentDetector;  ///< Detection of the black and frozen decoded frames (has ownership, NULL if not detected)
+	AudioContentDetector* _audioContentDetector;  ///< Detection of the silence in the decoded frames (has ownership, NULL if not detected)
+
+	StageStat _decodeStat;
+	StageStat _convertStat;
+	StageStat _encodeStat;
+
+	IMetricsObserver* _metricsObserver;  ///< Observer of the metrics of the packets (has link, no ownership, NULL if not observed)
+	size_t _metricsSamplingInterval;  ///< The metrics of one packet out of this number are observed
+	size_t _metricsBatchSize;  ///< Number of metrics given to each call of the observer
+	std::vector< FrameMetrics > _metricsBatch;  ///< Metrics not given yet to the observer
+	size_t _nbWrappedPackets;  ///< Number of packets given to the output stream
+	size_t _nbEncoderFrames;  ///< Number of frames given to the encoder and not encoded yet
 };
 
 }
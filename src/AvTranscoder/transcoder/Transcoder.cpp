@@ -1,24 +1,202 @@
 #include "Transcoder.hpp"
 
 #include <AvTranscoder/file/util.hpp>
+#include <AvTranscoder/file/ProbeCache.hpp>
+#include <AvTranscoder/profile/ProfileRegistry.hpp>
 #include <AvTranscoder/progress/NoDisplayProgress.hpp>
 #include <AvTranscoder/stat/VideoStat.hpp>
+#include <AvTranscoder/stat/QualityMeter.hpp>
+#include <AvTranscoder/stat/Tracer.hpp>
+#include <AvTranscoder/transcoder/Checkpoint.hpp>
 
 #include <limits>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 
 namespace avtranscoder
 {
 
+namespace
+{
+
+/// Formats in which the data can be cut between two packets, and appended again
+/// @note Not the raw formats of inter codecs (h264, mpeg2video...): the checkpoints are not at their keyframes
+const char* resumableFormats[] = { "mpegts", "mpeg", "dv", "dnxhd", "mjpeg", "rawvideo",
+	"u8", "s16le", "s16be", "s24le", "s24be", "s32le", "s32be", "f32le", "f32be", "f64le", "f64be", NULL };
+
+/// Move the input file to the keyframe before the given time of the stream (in seconds, from the beginning of the stream)
+void seekBefore( InputFile& inputFile, const StreamProperties& streamProperties, const double time )
+{
+	// the times of the stream start at its first timestamp, as in StreamTranscoder
+	inputFile.seekAtTime( streamProperties.getStartTime() + time, AVSEEK_FLAG_BACKWARD );
+}
+
+/// Set the statistics of each stage of the process of the stream (in a VideoStat or an AudioStat)
+template< typename Stat >
+void setStageStats( Stat& stat, const StreamTranscoder& streamTranscoder, const OutputFile* outputFile )
+{
+	stat._demuxStat = streamTranscoder.getDemuxStat();
+	stat._decodeStat = streamTranscoder.getDecodeStat();
+	stat._convertStat = streamTranscoder.getConvertStat();
+	stat._encodeStat = streamTranscoder.getEncodeStat();
+	if( outputFile )
+		stat._muxStat = outputFile->getMuxStat( streamTranscoder.getOutputStream().getStreamIndex() );
+
+	LOG_INFO( "Time spent to process stream " << streamTranscoder.getOutputStream().getStreamIndex() << " (wall / CPU in seconds): "
+		<< "demux " << stat._demuxStat._wallTime << " / " << stat._demuxStat._cpuTime << ", "
+		<< "decode " << stat._decodeStat._wallTime << " / " << stat._decodeStat._cpuTime << ", "
+		<< "convert " << stat._convertStat._wallTime << " / " << stat._convertStat._cpuTime << ", "
+		<< "encode " << stat._encodeStat._wallTime << " / " << stat._encodeStat._cpuTime << ", "
+		<< "mux " << stat._muxStat._wallTime << " / " << stat._muxStat._cpuTime )
+}
+
+/**
+ * @brief Trace a process in the given file (see Tracer), until it stops or is destroyed: the trace is written even if the process throws.
+ * @note The process is not traced if another one is.
+ */
+class ScopedTrace
+{
+private:
+	ScopedTrace( const ScopedTrace& scopedTrace );
+	ScopedTrace& operator=( const ScopedTrace& scopedTrace );
+
+public:
+	ScopedTrace( const std::string& filename )
+		: _filename( filename )
+		, _isStarted( false )
+	{
+		if( _filename.empty() )
+			return;
+
+		_isStarted = Tracer::start();
+		if( ! _isStarted )
+			LOG_WARN( "Unable to trace the process in '" << _filename << "': another process is traced" )
+	}
+
+	~ScopedTrace()
+	{
+		stop();
+	}
+
+	/**
+	 * @brief Stop the trace, and write it.
+	 */
+	void stop()
+	{
+		if( ! _isStarted )
+			return;
+		_isStarted = false;
+		Tracer::stop( _filename );
+	}
+
+private:
+	const std::string _filename;
+	bool _isStarted;
+};
+
+/**
+ * @brief Give the metrics of the streams of a process to an observer (see IMetricsObserver), until it stops or is destroyed:
+ * the last metrics are given, and the observer is removed from the streams, even if the process throws.
+ */
+class ScopedMetricsObserver
+{
+private:
+	ScopedMetricsObserver( const ScopedMetricsObserver& scopedMetricsObserver );
+	ScopedMetricsObserver& operator=( const ScopedMetricsObserver& scopedMetricsObserver );
+
+public:
+	/**
+	 * @param observer: NULL if the metrics are not observed
+	 */
+	ScopedMetricsObserver( const std::vector< StreamTranscoder* >& streamTranscoders, IMetricsObserver* observer, const size_t samplingInterval, const size_t batchSize )
+		: _streamTranscoders( streamTranscoders )
+		, _isObserved( observer != NULL )
+	{
+		if( ! _isObserved )
+			return;
+
+		for( size_t streamIndex = 0; streamIndex < _streamTranscoders.size(); ++streamIndex )
+			_streamTranscoders.at( streamIndex )->setMetricsObserver( observer, samplingInterval, batchSize );
+	}
+
+	~ScopedMetricsObserver()
+	{
+		try
+		{
+			stop();
+		}
+		catch( const std::exception& e )
+		{
+			LOG_ERROR( e.what() )
+		}
+	}
+
+	/**
+	 * @brief Give the last metrics of each stream to the observer, and remove it from the streams.
+	 * @exception throw std::runtime_error if the observer throws (after it is removed from all the streams)
+	 */
+	void stop()
+	{
+		if( ! _isObserved )
+			return;
+		_isObserved = false;
+
+		std::string error;
+		for( size_t streamIndex = 0; streamIndex < _streamTranscoders.size(); ++streamIndex )
+		{
+			StreamTranscoder& streamTranscoder = *_streamTranscoders.at( streamIndex );
+			try
+			{
+				streamTranscoder.flushMetrics();
+			}
+			catch( const std::exception& e )
+			{
+				if( error.empty() )
+					error = e.what();
+			}
+			catch( ... )
+			{
+				if( error.empty() )
+					error = "unknown error";
+			}
+			streamTranscoder.setMetricsObserver( NULL );
+		}
+		if( ! error.empty() )
+			throw std::runtime_error( "Unable to give the last metrics of the process to the observer: " + error );
+	}
+
+private:
+	const std::vector< StreamTranscoder* >& _streamTranscoders;
+	bool _isObserved;
+};
+
+}
+
 Transcoder::Transcoder( IOutputFile& outputFile )
 	: _outputFile( outputFile )
 	, _inputFiles()
 	, _streamTranscoders()
 	, _streamTranscodersAllocated()
-	, _profileLoader( true )
+	, _streamsToProcess()
+	, _profileLoader()
 	, _eProcessMethod ( eProcessMethodBasedOnStream )
 	, _mainStreamIndex( 0 )
 	, _outputDuration( 0 )
+	, _maxCacheSizePerInputFile( 0 )
+	, _checkpointFilename()
+	, _checkpointInterval( 60 )
+	, _digestReportFilename()
+	, _digestReport()
+	, _digestAlgorithm( eDigestAlgorithmMd5 )
+	, _digestedData( eDigestedDataAll )
+	, _isQualityMeasured( false )
+	, _isContentDetected( false )
+	, _minDetectedDuration( defaultMinDetectedDuration )
+	, _traceFilename()
+	, _metricsObserver( NULL )
+	, _metricsSamplingInterval( 1 )
+	, _metricsBatchSize( 25 )
 {}
 
 Transcoder::~Transcoder()
@@ -47,7 +225,7 @@ void Transcoder::add( const std::string& filename, const size_t streamIndex, con
 	// Transcode
 	else
 	{
-		const ProfileLoader::Profile& transcodeProfile = _profileLoader.getProfile( profileName );
+		const ProfileLoader::Profile transcodeProfile = getProfile( profileName );
 		add( filename, streamIndex, transcodeProfile, offset );
 	}
 }
@@ -66,7 +244,7 @@ void Transcoder::add( const std::string& filename, const size_t streamIndex, con
 	// Transcode
 	else
 	{
-		const ProfileLoader::Profile& transcodeProfile = _profileLoader.getProfile( profileName );
+		const ProfileLoader::Profile transcodeProfile = getProfile( profileName );
 		add( filename, streamIndex, transcodeProfile, codec, offset );
 	}
 }
@@ -119,7 +297,7 @@ void Transcoder::add( const std::string& filename, const size_t streamIndex, con
 	// Transcode
 	else
 	{
-		const ProfileLoader::Profile& transcodeProfile = _profileLoader.getProfile( profileName );
+		const ProfileLoader::Profile transcodeProfile = getProfile( profileName );
 		add( filename, streamIndex, subStreamIndex, transcodeProfile, offset );
 	}
 }
@@ -150,7 +328,7 @@ void Transcoder::add( const std::string& filename, const size_t streamIndex, con
 	// Transcode
 	else
 	{
-		const ProfileLoader::Profile& transcodeProfile = _profileLoader.getProfile( profileName );
+		const ProfileLoader::Profile transcodeProfile = getProfile( profileName );
 		add( filename, streamIndex, subStreamIndex, transcodeProfile, codec, offset );
 	}
 }
@@ -209,17 +387,24 @@ bool Transcoder::processFrame()
 	if( _streamTranscoders.size() == 0 )
 		return false;
 
-	for( size_t streamIndex = 0; streamIndex < _streamTranscoders.size(); ++streamIndex )
+	// (re)initialize the scheduling if streams were added
+	if( _streamsToProcess.size() != _streamTranscoders.size() )
 	{
-		LOG_DEBUG( "Process stream " << streamIndex << "/" << ( _streamTranscoders.size() - 1 ) )
-
-		bool streamProcessStatus = _streamTranscoders.at( streamIndex )->processFrame();
-		if( ! streamProcessStatus )
-		{
-			return false;
-		}
+		_streamsToProcess = std::priority_queue< StreamPosition, std::vector< StreamPosition >, std::greater< StreamPosition > >();
+		for( size_t streamIndex = 0; streamIndex < _streamTranscoders.size(); ++streamIndex )
+			_streamsToProcess.push( std::make_pair( _streamTranscoders.at( streamIndex )->getOutputStream().getStreamDuration(), streamIndex ) );
 	}
-	return true;
+
+	// process the stream with the smallest output timestamp
+	const size_t streamIndex = _streamsToProcess.top().second;
+	_streamsToProcess.pop();
+
+	LOG_DEBUG( "Process stream " << streamIndex << "/" << ( _streamTranscoders.size() - 1 ) )
+
+	StreamTranscoder& streamTranscoder = *_streamTranscoders.at( streamIndex );
+	const bool streamProcessStatus = streamTranscoder.processFrame();
+	_streamsToProcess.push( std::make_pair( streamTranscoder.getOutputStream().getStreamDuration(), streamIndex ) );
+	return streamProcessStatus;
 }
 
 ProcessStat Transcoder::process()
@@ -235,15 +420,48 @@ ProcessStat Transcoder::process( IProgress& progress )
 
 	manageSwitchToGenerator();
 
+	if( ! _digestReportFilename.empty() )
+		openDigestReport();
+
+	if( _isQualityMeasured )
+	{
+		for( size_t streamIndex = 0; streamIndex < _streamTranscoders.size(); ++streamIndex )
+		{
+			if( _streamTranscoders.at( streamIndex )->getStreamType() == AVMEDIA_TYPE_VIDEO )
+				_streamTranscoders.at( streamIndex )->setQualityMeasurement();
+		}
+	}
+
+	if( _isContentDetected )
+	{
+		for( size_t streamIndex = 0; streamIndex < _streamTranscoders.size(); ++streamIndex )
+		{
+			StreamTranscoder& streamTranscoder = *_streamTranscoders.at( streamIndex );
+			streamTranscoder.setContentDetection();
+			if( streamTranscoder.getVideoContentDetector() )
+				streamTranscoder.getVideoContentDetector()->setMinDuration( _minDetectedDuration );
+			if( streamTranscoder.getAudioContentDetector() )
+				streamTranscoder.getAudioContentDetector()->setMinDuration( _minDetectedDuration );
+		}
+	}
+
+	ScopedMetricsObserver metricsObserver( _streamTranscoders, _metricsObserver, _metricsSamplingInterval, _metricsBatchSize );
+
 	LOG_INFO( "Start process" )
 
-	_outputFile.beginWrap();
+	ScopedTrace trace( _traceFilename );
+
+	OutputFile* checkpointedOutputFile = _checkpointFilename.empty() ? NULL : &getResumableOutputFile();
+	if( ! checkpointedOutputFile || ! resumeWrap( *checkpointedOutputFile ) )
+		_outputFile.beginWrap();
 
 	preProcessCodecLatency();
 
 	const double outputDuration = getOutputDuration();
 	LOG_INFO( "Output duration of the process will be " << outputDuration << "s." )
 
+	double nextCheckpointDuration = _outputFile.getStream( 0 ).getStreamDuration() + _checkpointInterval;
+	bool isCanceled = false;
 	size_t frame = 0;
 	bool frameProcessed = true;
 	while( frameProcessed )
@@ -252,12 +470,21 @@ ProcessStat Transcoder::process( IProgress& progress )
 
 		// check if JobStatusCancel
 		if( progress.progress( ( progressDuration > outputDuration ) ? outputDuration : progressDuration, outputDuration ) == eJobStatusCancel )
+		{
+			isCanceled = true;
 			break;
+		}
 
 		// check progressDuration
 		if( progressDuration >= outputDuration )
 			break;
 
+		if( checkpointedOutputFile && progressDuration >= nextCheckpointDuration )
+		{
+			saveCheckpoint( *checkpointedOutputFile );
+			nextCheckpointDuration = progressDuration + _checkpointInterval;
+		}
+
 		LOG_DEBUG( "Process frame " << frame )
 		frameProcessed =  processFrame();
 
@@ -266,6 +493,17 @@ ProcessStat Transcoder::process( IProgress& progress )
 
 	_outputFile.endWrap();
 
+	metricsObserver.stop();
+
+	trace.stop();
+
+	if( ! _digestReportFilename.empty() )
+		closeDigestReport();
+
+	// the process is complete: nothing to resume
+	if( checkpointedOutputFile && ! isCanceled )
+		std::remove( _checkpointFilename.c_str() );
+
 	LOG_INFO( "End of process" )
 
 	LOG_INFO( "Get process statistics" )
@@ -282,6 +520,69 @@ void Transcoder::setProcessMethod( const EProcessMethod eProcessMethod, const si
 	_outputDuration = outputDuration;
 }
 
+void Transcoder::setMaxCacheSizePerInputFile( const size_t maxCacheSize )
+{
+	_maxCacheSizePerInputFile = maxCacheSize;
+	for( std::vector< InputFile* >::iterator it = _inputFiles.begin(); it != _inputFiles.end(); ++it )
+		(*it)->setMaxCacheSize( maxCacheSize );
+}
+
+void Transcoder::setCheckpoint( const std::string& checkpointFilename, const double interval )
+{
+	if( interval <= 0 )
+		throw std::runtime_error( "The interval between two checkpoints should be positive" );
+	_checkpointFilename = checkpointFilename;
+	_checkpointInterval = interval;
+}
+
+void Transcoder::setFrameDigest( const std::string& reportFilename, const EDigestAlgorithm algorithm, const int digestedData )
+{
+	_digestReportFilename = reportFilename;
+	_digestAlgorithm = algorithm;
+	_digestedData = digestedData;
+}
+
+void Transcoder::add( const std::string& filename, const size_t streamIndex, const std::string& profileName, const double inPoint, const double outPoint )
+{
+	// Check filename
+	if( ! filename.length() )
+		throw std::runtime_error( "Can't process a time range of a stream without filename indicated" );
+
+	LOG_INFO( "Add range [" << inPoint << "s, " << outPoint << "s] of stream from file '" << filename << "' / index=" << streamIndex << " / encodingProfile=" << ( profileName.length() ? profileName : "rewrap" ) )
+
+	// A dedicated input file: seeking in it does not move the other streams
+	_inputFiles.push_back( new InputFile( filename ) );
+	InputFile* referenceFile = _inputFiles.back();
+	referenceFile->setMaxCacheSize( _maxCacheSizePerInputFile );
+	referenceFile->activateStream( streamIndex );
+
+	InputStream& inputStream = referenceFile->getStream( streamIndex );
+
+	// Move to the keyframe before the in point
+	if( inPoint > 0 )
+		seekBefore( *referenceFile, inputStream.getProperties(), inPoint );
+
+	// Re-wrap
+	if( profileName.length() == 0 )
+	{
+		_streamTranscodersAllocated.push_back( new StreamTranscoder( inputStream, _outputFile ) );
+	}
+	// Transcode
+	else
+	{
+		const AVMediaType mediaType = inputStream.getProperties().getStreamType();
+		if( mediaType != AVMEDIA_TYPE_VIDEO && mediaType != AVMEDIA_TYPE_AUDIO )
+			throw std::runtime_error( "unsupported media type in transcode setup" );
+
+		const ProfileLoader::Profile transcodeProfile = getProfile( profileName );
+		if( ! _profileLoader.hasProfile( transcodeProfile ) )
+			_profileLoader.loadProfile( transcodeProfile );
+		_streamTranscodersAllocated.push_back( new StreamTranscoder( inputStream, _outputFile, transcodeProfile ) );
+	}
+	_streamTranscoders.push_back( _streamTranscodersAllocated.back() );
+	_streamTranscoders.back()->setTimeRange( inPoint, outPoint );
+}
+
 void Transcoder::addRewrapStream( const std::string& filename, const size_t streamIndex, const float offset )
 {
 	LOG_INFO( "Add rewrap stream from file '" << filename << "' / index=" << streamIndex << " / offset=" << offset << "s"  )
@@ -295,8 +596,19 @@ void Transcoder::addRewrapStream( const std::string& filename, const size_t stre
 void Transcoder::addTranscodeStream( const std::string& filename, const size_t streamIndex, const int subStreamIndex, const float offset )
 {
 	// Get profile from input file
-	InputFile inputFile( filename );
-	ProfileLoader::Profile profile = getProfileFromFile( inputFile, streamIndex );
+	// the properties are kept in the cache until the profile is get
+	const FileProperties& fileProperties = ProbeCache::acquireProperties( filename, eAnalyseLevelHeader );
+	ProfileLoader::Profile profile;
+	try
+	{
+		profile = getProfileFromFile( fileProperties, streamIndex );
+	}
+	catch( ... )
+	{
+		ProbeCache::releaseProperties( fileProperties );
+		throw;
+	}
+	ProbeCache::releaseProperties( fileProperties );
 
 	// override channels parameter to manage demultiplexing
 	ProfileLoader::Profile::iterator it = profile.find( constants::avProfileChannel );
@@ -369,6 +681,7 @@ InputFile* Transcoder::addInputFile( const std::string& filename, const size_t s
 
 		_inputFiles.push_back( new InputFile( filename ) );
 		referenceFile = _inputFiles.back();
+		referenceFile->setMaxCacheSize( _maxCacheSizePerInputFile );
 	}
 
 	referenceFile->activateStream( streamIndex );
@@ -380,12 +693,12 @@ InputFile* Transcoder::addInputFile( const std::string& filename, const size_t s
 	return referenceFile;
 }
 
-ProfileLoader::Profile Transcoder::getProfileFromFile( InputFile& inputFile, const size_t streamIndex )
+ProfileLoader::Profile Transcoder::getProfileFromFile( const FileProperties& fileProperties, const size_t streamIndex )
 {
-	const StreamProperties* streamProperties = &inputFile.getProperties().getStreamPropertiesWithIndex( streamIndex );
+	const StreamProperties* streamProperties = &fileProperties.getStreamPropertiesWithIndex( streamIndex );
 	const VideoProperties* videoProperties = NULL;
 	const AudioProperties* audioProperties = NULL;
-	switch( inputFile.getStream( streamIndex ).getProperties().getStreamType() )
+	switch( streamProperties->getStreamType() )
 	{
 		case AVMEDIA_TYPE_VIDEO:
 		{
@@ -435,6 +748,15 @@ ProfileLoader::Profile Transcoder::getProfileFromFile( InputFile& inputFile, con
 	return profile;
 }
 
+ProfileLoader::Profile Transcoder::getProfile( const std::string& profileName ) const
+{
+	// custom profile added to the transcoder
+	if( _profileLoader.hasProfile( profileName ) )
+		return _profileLoader.getProfile( profileName );
+	// profile from the AVPROFILES directories
+	return ProfileRegistry::getInstance().getProfile( profileName );
+}
+
 float Transcoder::getStreamDuration( size_t indexStream ) const
 {
 	return _streamTranscoders.at( indexStream )->getDuration();
@@ -519,10 +841,11 @@ void Transcoder::manageSwitchToGenerator()
 
 void Transcoder::fillProcessStat( ProcessStat& processStat )
 {
+	const OutputFile* outputFile = dynamic_cast<const OutputFile*>( &_outputFile );
 	for( size_t streamIndex = 0; streamIndex < _streamTranscoders.size(); ++streamIndex )
 	{
 		IOutputStream& stream = _streamTranscoders.at( streamIndex )->getOutputStream();
-		const AVMediaType mediaType = _streamTranscoders.at( streamIndex )->getInputStream().getProperties().getStreamType();
+		const AVMediaType mediaType = _streamTranscoders.at( streamIndex )->getStreamType();
 		switch( mediaType )
 		{
 			case AVMEDIA_TYPE_VIDEO:
@@ -534,12 +857,51 @@ void Transcoder::fillProcessStat( ProcessStat& processStat )
 					videoStat._quality = encoderContext.coded_frame->quality;
 					videoStat._psnr = VideoStat::psnr( encoderContext.coded_frame->error[0] / ( encoderContext.width * encoderContext.height * 255.0 * 255.0 ) );
 				}
+				videoStat._decodedDigest = _streamTranscoders.at( streamIndex )->getDecodedStreamDigest();
+				videoStat._encodedDigest = _streamTranscoders.at( streamIndex )->getEncodedStreamDigest();
+
+				QualityMeter* qualityMeter = _streamTranscoders.at( streamIndex )->getQualityMeter();
+				if( qualityMeter )
+				{
+					qualityMeter->flush();
+					for( size_t plane = 0; plane < qualityMeter->getNbPlanes(); ++plane )
+					{
+						videoStat._planePsnr.push_back( qualityMeter->getPsnr( plane ) );
+						videoStat._planeSsim.push_back( qualityMeter->getSsim( plane ) );
+					}
+					videoStat._nbMeasuredFrames = qualityMeter->getNbMeasuredFrames();
+					videoStat._nbSkippedFrames = qualityMeter->getNbSkippedFrames();
+					videoStat._measureTime = qualityMeter->getMeasureTime();
+					videoStat._measureCopyTime = qualityMeter->getCopyTime();
+					// the PSNR of the first plane if the encoder does not give it
+					if( ! videoStat._psnr && ! videoStat._planePsnr.empty() )
+						videoStat._psnr = videoStat._planePsnr.at( 0 );
+				}
+
+				VideoContentDetector* contentDetector = _streamTranscoders.at( streamIndex )->getVideoContentDetector();
+				if( contentDetector )
+				{
+					contentDetector->flush();
+					videoStat._blackSegments = contentDetector->getBlackSegments();
+					videoStat._freezeSegments = contentDetector->getFreezeSegments();
+				}
+				setStageStats( videoStat, *_streamTranscoders.at( streamIndex ), outputFile );
 				processStat.addVideoStat( streamIndex, videoStat );
 				break;
 			}
 			case AVMEDIA_TYPE_AUDIO:
 			{
 				AudioStat audioStat( stream.getStreamDuration(), stream.getNbFrames() );
+				audioStat._decodedDigest = _streamTranscoders.at( streamIndex )->getDecodedStreamDigest();
+				audioStat._encodedDigest = _streamTranscoders.at( streamIndex )->getEncodedStreamDigest();
+
+				AudioContentDetector* contentDetector = _streamTranscoders.at( streamIndex )->getAudioContentDetector();
+				if( contentDetector )
+				{
+					contentDetector->flush();
+					audioStat._silenceSegments = contentDetector->getSilenceSegments();
+				}
+				setStageStats( audioStat, *_streamTranscoders.at( streamIndex ), outputFile );
 				processStat.addAudioStat( streamIndex, audioStat );
 				break;
 			}
@@ -550,4 +912,132 @@ void Transcoder::fillProcessStat( ProcessStat& processStat )
 	}
 }
 
+void Transcoder::openDigestReport()
+{
+	LOG_INFO( "Write the digests of the frames in '" << _digestReportFilename << "'" )
+	if( _digestReport.is_open() )
+		_digestReport.close();
+	_digestReport.clear();
+	_digestReport.open( _digestReportFilename.c_str(), std::ios::out | std::ios::trunc );
+	if( ! _digestReport.is_open() )
+		throw std::runtime_error( "Unable to open the report of the digests of the frames '" + _digestReportFilename + "'" );
+
+	_digestReport << "stream,data,frame," << getDigestAlgorithmName( _digestAlgorithm ) << std::endl;
+	for( size_t streamIndex = 0; streamIndex < _streamTranscoders.size(); ++streamIndex )
+	{
+		_streamTranscoders.at( streamIndex )->setFrameDigest( _digestAlgorithm, _digestedData );
+		_streamTranscoders.at( streamIndex )->setDigestReport( &_digestReport, streamIndex );
+	}
+}
+
+void Transcoder::closeDigestReport()
+{
+	for( size_t streamIndex = 0; streamIndex < _streamTranscoders.size(); ++streamIndex )
+		_streamTranscoders.at( streamIndex )->setDigestReport( NULL, streamIndex );
+
+	_digestReport.close();
+	if( _digestReport.fail() )
+		LOG_ERROR( "Unable to write the digests of the frames in '" << _digestReportFilename << "'" )
+}
+
+OutputFile& Transcoder::getResumableOutputFile()
+{
+	OutputFile* outputFile = dynamic_cast<OutputFile*>( &_outputFile );
+	if( ! outputFile )
+		throw std::runtime_error( "Unable to checkpoint the process: the output file is not an OutputFile" );
+
+	const std::string formatName = outputFile->getFormatName();
+	bool isResumableFormat = false;
+	for( size_t i = 0; resumableFormats[i] != NULL; ++i )
+	{
+		if( formatName == resumableFormats[i] )
+		{
+			isResumableFormat = true;
+			break;
+		}
+	}
+	if( ! isResumableFormat )
+		throw std::runtime_error( "Unable to checkpoint the process: the format '" + formatName + "' can't be resumed" );
+
+	for( size_t i = 0; i < _streamTranscoders.size(); ++i )
+	{
+		if( ! _streamTranscoders.at( i )->canResume() )
+		{
+			std::stringstream os;
+			os << "Unable to checkpoint the process: the output stream " << i << " can't be resumed (rewrap, offset, or encoder with inter frames)";
+			throw std::runtime_error( os.str() );
+		}
+	}
+	return *outputFile;
+}
+
+bool Transcoder::resumeWrap( OutputFile& outputFile )
+{
+	Checkpoint checkpoint;
+	if( ! checkpoint.load( _checkpointFilename ) )
+		return false;
+
+	if( checkpoint.getNbStreams() != _streamTranscoders.size() )
+		throw std::runtime_error( "Unable to resume the process: the checkpoint '" + _checkpointFilename + "' does not match the streams to process" );
+
+	LOG_INFO( "Resume the process from the checkpoint '" << _checkpointFilename << "'" )
+
+	// time of the first frame to process in each input stream
+	std::vector< double > resumeTimes;
+	for( size_t i = 0; i < _streamTranscoders.size(); ++i )
+		resumeTimes.push_back( _streamTranscoders.at( i )->resume( checkpoint.getStream( i )._duration ) );
+
+	// move each input file before the first frame to process of its streams
+	for( std::vector< InputFile* >::iterator it = _inputFiles.begin(); it != _inputFiles.end(); ++it )
+	{
+		const StreamProperties* seekStreamProperties = NULL;
+		double seekTime = -1;
+		for( size_t i = 0; i < _streamTranscoders.size(); ++i )
+		{
+			if( resumeTimes.at( i ) < 0 )
+				continue;
+			const IInputStream& inputStream = _streamTranscoders.at( i )->getInputStream();
+			if( &(*it)->getStream( inputStream.getStreamIndex() ) != &inputStream )
+				continue;
+			// compare the times of the streams from the beginning of the file
+			const StreamProperties& streamProperties = inputStream.getProperties();
+			if( ! seekStreamProperties || streamProperties.getStartTime() + resumeTimes.at( i ) < seekStreamProperties->getStartTime() + seekTime )
+			{
+				seekStreamProperties = &streamProperties;
+				seekTime = resumeTimes.at( i );
+			}
+		}
+		if( seekTime > 0 )
+			seekBefore( **it, *seekStreamProperties, seekTime );
+	}
+
+	outputFile.resumeWrap( checkpoint.getOutputSize() );
+
+	// continue the timestamps of the output streams
+	for( size_t i = 0; i < checkpoint.getNbStreams(); ++i )
+	{
+		AVStream& avStream = outputFile.getFormatContext().getAVStream( i );
+		avStream.pts.val = checkpoint.getStream( i )._pts;
+		avStream.nb_frames = checkpoint.getStream( i )._nbFrames;
+	}
+	return true;
+}
+
+void Transcoder::saveCheckpoint( OutputFile& outputFile )
+{
+	Checkpoint checkpoint;
+	checkpoint.setOutputSize( outputFile.flush() );
+	for( size_t i = 0; i < _streamTranscoders.size(); ++i )
+	{
+		const AVStream& avStream = outputFile.getFormatContext().getAVStream( i );
+		Checkpoint::StreamState streamState;
+		streamState._pts = avStream.pts.val;
+		streamState._nbFrames = avStream.nb_frames;
+		streamState._duration = outputFile.getStream( i ).getStreamDuration();
+		checkpoint.addStream( streamState );
+	}
+	checkpoint.save( _checkpointFilename );
+	LOG_INFO( "Checkpoint of the process after " << outputFile.getStream( 0 ).getStreamDuration() << "s" )
+}
+
 }
@@ -4,14 +4,19 @@
 #include <AvTranscoder/common.hpp>
 #include <AvTranscoder/file/InputFile.hpp>
 #include <AvTranscoder/file/IOutputFile.hpp>
+#include <AvTranscoder/file/OutputFile.hpp>
 #include <AvTranscoder/stream/IInputStream.hpp>
 #include <AvTranscoder/profile/ProfileLoader.hpp>
 #include <AvTranscoder/stat/ProcessStat.hpp>
+#include <AvTranscoder/stat/ContentDetector.hpp>
 
 #include "StreamTranscoder.hpp"
 
 #include <string>
 #include <vector>
+#include <queue>
+#include <functional>
+#include <fstream>
 
 namespace avtranscoder
 {
@@ -98,6 +103,16 @@ public:
 	 */
 	void add( const std::string& filename, const size_t streamIndex, const int subStreamIndex, const ProfileLoader::Profile& profile, ICodec& codec, const float offset = 0  );
 
+	/**
+	 * @brief Add the range [inPoint, outPoint] of a stream and set a profile
+	 * @note If profileName is empty, rewrap: the stream starts at the keyframe before the in point.
+	 * @note inPoint and outPoint in seconds, from the beginning of the stream (if outPoint is 0, process until the end of the stream).
+	 * The stream is read from a dedicated input file, positioned at the keyframe before the in point:
+	 * the frames before the in point are decoded but not encoded, and the file is no more read after the out point.
+	 * @see StreamTranscoder::setTimeRange
+	 */
+	void add( const std::string& filename, const size_t streamIndex, const std::string& profileName, const double inPoint, const double outPoint );
+
 	/**
 	 * @brief Add the stream
 	 */
@@ -111,7 +126,8 @@ public:
 	void preProcessCodecLatency();
 	
 	/**
-	 * @brief Process the next frame of all streams.
+	 * @brief Process the next frame of the stream which is the most behind in the output file.
+	 * @note The streams are interleaved in the order of their output timestamps, so the muxer buffers few packets.
 	 * @return if a frame was processed or not.
 	 */
 	bool processFrame();
@@ -151,6 +167,81 @@ public:
 	 */
 	void setProcessMethod( const EProcessMethod eProcessMethod, const size_t indexBasedStream = 0, const double outputDuration = 0 );
 
+	/**
+	 * @brief Set the maximum size of the packets cached in memory for each input file, in bytes.
+	 * @note By default 0 (no limit).
+	 * @see InputFile::setMaxCacheSize
+	 */
+	void setMaxCacheSizePerInputFile( const size_t maxCacheSize );
+
+	/**
+	 * @brief Save the state of the process in the given file, after each given duration of output, to resume the process after a failure.
+	 * If the file exists when the process starts, the process resumes from the saved state:
+	 * the output file is cut at the saved size, the input streams are positioned at the saved times, and the new data is appended.
+	 * The file is removed at the end of the process.
+	 * @note Only for an OutputFile of a format which can be cut between two packets (mpegts, dv, raw formats...),
+	 * and streams transcoded with intra-only encoders (DNxHD, ProRes, MJPEG, PCM...) so each frame is a GOP boundary.
+	 * @note By default no checkpoint (empty filename).
+	 * @exception throw std::runtime_error when the process starts if it can't be resumed
+	 */
+	void setCheckpoint( const std::string& checkpointFilename, const double interval = 60 );
+
+	/**
+	 * @brief Compute the digest of each frame of the streams while processing, and write them in the given report as they are computed.
+	 * The report has a line "stream,data,frame,digest" per frame, with data "decoded" (frames decoded from the input) or "encoded" (packets given to the output).
+	 * The digests of the whole streams are given in the ProcessStat.
+	 * @note By default no digest (empty filename).
+	 * @see StreamTranscoder::setFrameDigest
+	 */
+	void setFrameDigest( const std::string& reportFilename, const EDigestAlgorithm algorithm = eDigestAlgorithmMd5, const int digestedData = eDigestedDataAll );
+
+	/**
+	 * @brief Measure the PSNR and the SSIM of each plane of the encoded video streams, by decoding them on side threads while processing.
+	 * The measures are given in the VideoStat of the ProcessStat, with the time spent to measure them.
+	 * @note By default no measure.
+	 * @see StreamTranscoder::setQualityMeasurement
+	 */
+	void setQualityMeasurement( const bool measure = true ) { _isQualityMeasured = measure; }
+
+	/**
+	 * @brief Detect the black and frozen frames of the video streams, and the silence of the audio streams, in the decoded frames.
+	 * The detected segments are given in the VideoStat and AudioStat of the ProcessStat, instead of analysing the file again.
+	 * @param minDuration: minimum duration of the detected segments, in seconds
+	 * @note By default no detection.
+	 * @see StreamTranscoder::setContentDetection
+	 */
+	void setContentDetection( const bool detect = true, const double minDuration = defaultMinDetectedDuration )
+	{
+		_isContentDetected = detect;
+		_minDetectedDuration = minDuration;
+	}
+
+	/**
+	 * @brief Record the calls of each stage of the process (demux, decode, convert, encode, wrap) of all the streams,
+	 * and write them as Chrome trace events in the given file at the end of the process (to open in chrome://tracing or Perfetto).
+	 * @note By default no trace (empty filename).
+	 * @note A single process is traced at a time: the process is not traced if another one is being traced.
+	 * @see Tracer
+	 */
+	void setTrace( const std::string& traceFilename ) { _traceFilename = traceFilename; }
+
+	/**
+	 * @brief Give the metrics of the packets given to each output stream (size, quality, picture type, time spent in each stage, depth of the queues)
+	 * to the observer during the process, by batches.
+	 * @param samplingInterval: the metrics of one packet out of this number are given, for each stream
+	 * @param batchSize: number of metrics given to each call of the observer (the last batch of each stream can be smaller)
+	 * @note The observer is called by the thread of the process: it should return quickly.
+	 * @note The observer is not owned by the Transcoder: it has to outlive the calls of process()
+	 * (in the bindings, keep a reference to the observer until the process is done).
+	 * @see StreamTranscoder::setMetricsObserver
+	 */
+	void setMetricsObserver( IMetricsObserver& observer, const size_t samplingInterval = 1, const size_t batchSize = 25 )
+	{
+		_metricsObserver = &observer;
+		_metricsSamplingInterval = samplingInterval;
+		_metricsBatchSize = batchSize;
+	}
+
 private:
 	void addRewrapStream( const std::string& filename, const size_t streamIndex, const float offset );
 
@@ -161,7 +252,13 @@ private:
 
 	InputFile* addInputFile( const std::string& filename, const size_t streamIndex, const float offset );
 
-	ProfileLoader::Profile getProfileFromFile( InputFile& inputFile, const size_t streamIndex );  ///< The function analyses the inputFile
+	/**
+	 * @brief Get the profile from the custom profiles of the transcoder, or else from the ProfileRegistry.
+	 * @exception throw std::runtime_error if the profile does not exist
+	 */
+	ProfileLoader::Profile getProfile( const std::string& profileName ) const;
+
+	ProfileLoader::Profile getProfileFromFile( const FileProperties& fileProperties, const size_t streamIndex );  ///< Create a profile from the properties of the given stream
 
 	/**
 	 * @brief Get the duration of the stream, in seconds
@@ -195,6 +292,33 @@ private:
 	 */
 	void fillProcessStat( ProcessStat& processStat );
 
+	/**
+	 * @brief Open the digest report, and give it to each StreamTranscoder which writes the digests of its frames in it.
+	 */
+	void openDigestReport();
+
+	/**
+	 * @brief Close the digest report, after the last digest of the process.
+	 */
+	void closeDigestReport();
+
+	/**
+	 * @brief Get the output file, checking that the process can be resumed from a checkpoint.
+	 * @exception throw std::runtime_error if the output file or a stream can't be resumed
+	 */
+	OutputFile& getResumableOutputFile();
+
+	/**
+	 * @brief Begin the wrap of the output file after the state saved in the checkpoint file.
+	 * @return false if there is no checkpoint file to resume from.
+	 */
+	bool resumeWrap( OutputFile& outputFile );
+
+	/**
+	 * @brief Save the current state of the process in the checkpoint file.
+	 */
+	void saveCheckpoint( OutputFile& outputFile );
+
 private:
 	IOutputFile& _outputFile;  ///< The output media file after process (has link)
 	std::vector< InputFile* > _inputFiles;  ///< The list of input files which contain added streams (has ownership)
@@ -202,11 +326,33 @@ private:
 	std::vector< StreamTranscoder* > _streamTranscoders;  ///< All streams of the output media file after process.
 	std::vector< StreamTranscoder* > _streamTranscodersAllocated;  ///< Streams allocated inside the Transcoder (has ownership)
 
-	ProfileLoader _profileLoader;  ///< Objet to get existing profiles, and add new ones for the Transcoder.
+	typedef std::pair< double, size_t > StreamPosition;  ///< Output duration (in seconds) and index of a stream
+	std::priority_queue< StreamPosition, std::vector< StreamPosition >, std::greater< StreamPosition > > _streamsToProcess;  ///< Streams to process, the most behind first
+
+	ProfileLoader _profileLoader;  ///< Objet to add custom profiles for the Transcoder (the existing ones are get from the ProfileRegistry).
 
 	EProcessMethod _eProcessMethod;  ///< Transcoding policy
 	size_t _mainStreamIndex;  ///< Index of stream used to stop the process of transcode in case of eProcessMethodBasedOnStream.
 	float _outputDuration;  ///< Duration of output media used to stop the process of transcode in case of eProcessMethodBasedOnDuration.
+
+	size_t _maxCacheSizePerInputFile;  ///< Maximum size of the packets cached in memory for each input file (0 if no limit)
+
+	std::string _checkpointFilename;  ///< File in which the state of the process is saved (empty if no checkpoint)
+	double _checkpointInterval;  ///< Duration of output, in seconds, between two checkpoints
+
+	std::string _digestReportFilename;  ///< File in which the digests of the frames are written (empty if no digest)
+	std::ofstream _digestReport;  ///< Report of the digests of the frames, open during the process
+	EDigestAlgorithm _digestAlgorithm;
+	int _digestedData;  ///< Data of the streams digested (see EDigestedData)
+	bool _isQualityMeasured;  ///< If the quality of the encoded video streams is measured
+	bool _isContentDetected;  ///< If the black, frozen and silent segments of the decoded streams are detected
+	double _minDetectedDuration;  ///< Minimum duration of the detected segments, in seconds
+
+	std::string _traceFilename;  ///< File of the trace of the process (no trace if empty)
+
+	IMetricsObserver* _metricsObserver;  ///< Observer of the metrics of the packets (has link, no ownership, NULL if not observed)
+	size_t _metricsSamplingInterval;
+	size_t _metricsBatchSize;
 };
 
 }
@@ -1,7 +1,13 @@
 %{
 #include <AvTranscoder/transcoder/StreamTranscoder.hpp>
 #include <AvTranscoder/transcoder/Transcoder.hpp>
+#include <AvTranscoder/transcoder/Remuxer.hpp>
 %}
 
+%thread avtranscoder::Transcoder::process;
+%thread avtranscoder::Transcoder::processFrame;
+%thread avtranscoder::Remuxer::process;
+
 %include <AvTranscoder/transcoder/StreamTranscoder.hpp>
 %include <AvTranscoder/transcoder/Transcoder.hpp>
+%include <AvTranscoder/transcoder/Remuxer.hpp>
@@ -32,7 +32,8 @@ namespace avtranscoder
 
 AudioTransform::AudioTransform()
 	: _audioConvertContext( NULL )
-	, _nbSamplesOfPreviousFrame( 0 )
+	, _inputSampleRate( 0 )
+	, _outputSampleRate( 0 )
 	, _isInit    ( false )
 {
 }
@@ -65,7 +66,9 @@ bool AudioTransform::init( const Frame& srcFrame, const Frame& dstFrame )
 		FreeResampleContext( &_audioConvertContext );
 		throw std::runtime_error( "unable to open audio convert context" );
 	}
-	
+
+	_inputSampleRate = src.desc().getSampleRate();
+	_outputSampleRate = dst.desc().getSampleRate();
 	return true;
 }
 
@@ -82,33 +85,60 @@ void AudioTransform::updateOutputFrame( const size_t nbInputSamples, Frame& dstF
 	dst.setNbSamples( nbInputSamples );
 }
 
-void AudioTransform::convert( const Frame& srcFrame, Frame& dstFrame )
+size_t AudioTransform::getMaxNbOutputSamples( const size_t nbInputSamples ) const
 {
-	if( ! _isInit )
-		_isInit = init( srcFrame, dstFrame );
+	if( _inputSampleRate == _outputSampleRate || ! _inputSampleRate )
+		return nbInputSamples;
 
-	// if number of samples change from previous frame
-	const size_t nbSamplesOfCurrentFrame = static_cast<const AudioFrame&>( srcFrame ).getNbSamples();
-	if( nbSamplesOfCurrentFrame != _nbSamplesOfPreviousFrame )
-	{
-		updateOutputFrame( nbSamplesOfCurrentFrame, dstFrame );
-		_nbSamplesOfPreviousFrame = nbSamplesOfCurrentFrame;
-	}
+#ifdef AVTRANSCODER_LIBAV_DEPENDENCY
+	const int64_t delay = avresample_get_delay( _audioConvertContext ) + avresample_available( _audioConvertContext );
+#else
+	const int64_t delay = swr_get_delay( _audioConvertContext, _inputSampleRate );
+#endif
+	return av_rescale_rnd( delay + nbInputSamples, _outputSampleRate, _inputSampleRate, AV_ROUND_UP );
+}
+
+void AudioTransform::resample( const unsigned char* srcData, const size_t nbInputSamples, Frame& dstFrame )
+{
+	// the buffer of the output frame is reallocated only if it is smaller than the maximum number of samples (see Frame::resize)
+	const size_t nbOutputSamples = getMaxNbOutputSamples( nbInputSamples );
+	updateOutputFrame( nbOutputSamples, dstFrame );
 
-	const unsigned char* srcData = srcFrame.getData();
 	unsigned char* dstData = dstFrame.getData();
 
 	int nbOutputSamplesPerChannel;
 #ifdef AVTRANSCODER_LIBAV_DEPENDENCY
-	nbOutputSamplesPerChannel = avresample_convert( _audioConvertContext, (uint8_t**)&dstData, 0, nbSamplesOfCurrentFrame, (uint8_t**)&srcData, 0, nbSamplesOfCurrentFrame );
+	nbOutputSamplesPerChannel = avresample_convert( _audioConvertContext, (uint8_t**)&dstData, 0, nbOutputSamples, (uint8_t**)( srcData ? &srcData : NULL ), 0, nbInputSamples );
 #else
-	nbOutputSamplesPerChannel = swr_convert( _audioConvertContext, &dstData, nbSamplesOfCurrentFrame, &srcData, nbSamplesOfCurrentFrame );
+	nbOutputSamplesPerChannel = swr_convert( _audioConvertContext, &dstData, nbOutputSamples, srcData ? &srcData : NULL, nbInputSamples );
 #endif
 
 	if( nbOutputSamplesPerChannel < 0 )
 	{
 		throw std::runtime_error( "unable to convert audio samples" );
 	}
+
+	// the resampler keeps some samples in its delay
+	if( (size_t)nbOutputSamplesPerChannel != nbOutputSamples )
+		updateOutputFrame( nbOutputSamplesPerChannel, dstFrame );
+}
+
+void AudioTransform::convert( const Frame& srcFrame, Frame& dstFrame )
+{
+	if( ! _isInit )
+		_isInit = init( srcFrame, dstFrame );
+
+	const size_t nbSamplesOfCurrentFrame = static_cast<const AudioFrame&>( srcFrame ).getNbSamples();
+	resample( srcFrame.getData(), nbSamplesOfCurrentFrame, dstFrame );
+}
+
+bool AudioTransform::flush( Frame& dstFrame )
+{
+	if( ! _isInit || _inputSampleRate == _outputSampleRate )
+		return false;
+
+	resample( NULL, 0, dstFrame );
+	return static_cast<AudioFrame&>( dstFrame ).getNbSamples() > 0;
 }
 
 }
@@ -27,18 +27,35 @@ public:
 	AudioTransform();
 	~AudioTransform();
 
+	/**
+	 * @note If the sample rates are different, the number of samples of the output frame can be different from the input frame
+	 * (the resampler keeps samples in its delay).
+	 */
 	void convert( const Frame& srcFrame, Frame& dstFrame );
 
+	/**
+	 * @brief Get the samples which are still in the delay of the resampler, at the end of the stream.
+	 * @return false if there is no more sample
+	 */
+	bool flush( Frame& dstFrame );
+
 private:
 	bool init( const Frame& srcFrame, const Frame& dstFrame );
 
-	/// Update output buffer if source has a different size from the last process
+	/// Set the number of samples of the output frame, and the size of its data
 	void updateOutputFrame( const size_t nbInputSamples, Frame& dstFrame ) const;
 
+	/// Get the maximum number of samples output by the resampler for the given number of input samples (including its delay)
+	size_t getMaxNbOutputSamples( const size_t nbInputSamples ) const;
+
+	/// Convert the given input samples (or flush the resampler if NULL) in the output frame
+	void resample( const unsigned char* srcData, const size_t nbInputSamples, Frame& dstFrame );
+
 private:
 	ResampleContext* _audioConvertContext;
 
-	size_t _nbSamplesOfPreviousFrame;  ///< To check if the number of samples change between frames
+	size_t _inputSampleRate;
+	size_t _outputSampleRate;
 
 	bool _isInit;
 };
@@ -0,0 +1,23 @@
+"""
+Generated video shared by the tests.
+"""
+from pyAvTranscoder import avtranscoder as av
+
+
+def processDummyVideo( outputFileName, profileName = "dnxhd120", duration = 1, setUpTranscoder = None ):
+    """
+    Encode a generated video of the given duration (in seconds) with the given profile, and return the statistics of the process.
+    If given, setUpTranscoder is called with the Transcoder before the process.
+    """
+    outputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( outputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, duration )
+
+    videoCodec = av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" )
+    imageDesc = av.VideoFrameDesc( 1920, 1080, "yuv422p" )
+    videoCodec.setImageParameters( imageDesc )
+    transcoder.add( "", 0, profileName, videoCodec )
+
+    if setUpTranscoder:
+        setUpTranscoder( transcoder )
+    return transcoder.process()
@@ -0,0 +1,62 @@
+import os
+
+# Check if environment is setup to run the tests
+if os.environ.get('AVTRANSCODER_TEST_AUDIO_WAVE_FILE') is None:
+    from nose.plugins.skip import SkipTest
+    raise SkipTest("Need to define environment variable AVTRANSCODER_TEST_AUDIO_WAVE_FILE")
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testReadSamplesWindows():
+    """
+    Read windows of a fixed number of samples, which do not depend on the size of the decoded frames.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    reader = av.AudioReader( inputFileName, 0 )
+    frame = av.AudioFrame( av.AudioFrameDesc( reader.getSampleRate(), reader.getChannels(), reader.getSampleFormat() ) )
+
+    windowSize = 1000
+    nbSamplesRead = reader.readSamples( frame, windowSize )
+    assert_equals( windowSize, nbSamplesRead )
+    assert_equals( windowSize, frame.getNbSamples() )
+    assert_equals( windowSize * reader.getChannels() * 2, frame.getSize() )
+    assert_equals( windowSize, reader.getSamplePosition() )
+
+    # read until the end of the stream
+    while nbSamplesRead == windowSize:
+        nbSamplesRead = reader.readSamples( frame, windowSize )
+    assert_less( nbSamplesRead, windowSize )
+    assert_equals( 0, reader.readSamples( frame, windowSize ) )
+
+
+def testSeekAtSample():
+    """
+    Seek at a sample, and read from it.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    reader = av.AudioReader( inputFileName, 0 )
+    frame = av.AudioFrame( av.AudioFrameDesc( reader.getSampleRate(), reader.getChannels(), reader.getSampleFormat() ) )
+
+    sample = reader.getSampleRate() + 17
+    assert_true( reader.seekAtSample( sample ) )
+    assert_equals( sample, reader.getSamplePosition() )
+
+    assert_equals( 1024, reader.readSamples( frame, 1024 ) )
+    assert_equals( sample + 1024, reader.getSamplePosition() )
+
+
+def testReadResampledSamples():
+    """
+    Read windows of samples resampled at another sample rate.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    reader = av.AudioReader( inputFileName, 0, 44100, 0, "s16" )
+    frame = av.AudioFrame( av.AudioFrameDesc( 44100, reader.getChannels(), "s16" ) )
+
+    assert_equals( 44100, reader.readSamples( frame, 44100 ) )
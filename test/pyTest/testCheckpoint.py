@@ -0,0 +1,120 @@
+import os
+
+# Check if environment is setup to run the tests
+if os.environ.get('AVTRANSCODER_TEST_AUDIO_WAVE_FILE') is None:
+    from nose.plugins.skip import SkipTest
+    raise SkipTest("Need to define environment variable AVTRANSCODER_TEST_AUDIO_WAVE_FILE")
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+class CancelProgress(av.IProgress):
+    """
+    Cancel the process after the given duration.
+    """
+    def __init__(self, cancelDuration):
+        av.IProgress.__init__(self)
+        self.cancelDuration = cancelDuration
+
+    def progress(self, processedDuration, programDuration):
+        if processedDuration >= self.cancelDuration:
+            return av.eJobStatusCancel
+        return av.eJobStatusContinue
+
+
+def testCheckpointRemovedAtTheEnd():
+    """
+    Transcode one audio stream with checkpoints: the checkpoint file is removed at the end of the process.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    outputFileName = "testCheckpointRemovedAtTheEnd.pcm"
+    checkpointFileName = outputFileName + ".checkpoint"
+
+    ouputFile = av.OutputFile( outputFileName, "s24le" )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setCheckpoint( checkpointFileName, 1 )
+    transcoder.add( inputFileName, 0, "wave24b48kmono" )
+
+    transcoder.process()
+
+    assert_false( os.path.exists( checkpointFileName ) )
+
+
+def testResumeFromCheckpoint():
+    """
+    Cancel a transcode with checkpoints, then resume it: the output has the duration of the input.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    outputFileName = "testResumeFromCheckpoint.pcm"
+    checkpointFileName = outputFileName + ".checkpoint"
+    if os.path.exists( checkpointFileName ):
+        os.remove( checkpointFileName )
+
+    # first process, canceled
+    ouputFile = av.OutputFile( outputFileName, "s24le" )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setCheckpoint( checkpointFileName, 1 )
+    transcoder.add( inputFileName, 0, "wave24b48kmono" )
+
+    progress = CancelProgress( 3 )
+    transcoder.process( progress )
+    assert_true( os.path.exists( checkpointFileName ) )
+
+    # resumed process
+    ouputFile = av.OutputFile( outputFileName, "s24le" )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setCheckpoint( checkpointFileName, 1 )
+    transcoder.add( inputFileName, 0, "wave24b48kmono" )
+
+    processStat = transcoder.process()
+    assert_false( os.path.exists( checkpointFileName ) )
+
+    # get src file
+    src_inputFile = av.InputFile( inputFileName )
+    src_properties = src_inputFile.getProperties()
+    src_audioStream = src_properties.getAudioProperties()[0]
+
+    # check output duration (the input is resumed at a decoded frame)
+    dst_audioStat = processStat.getAudioStat( 0 )
+    assert_almost_equals( src_audioStream.getDuration(), dst_audioStat._duration, delta=0.1 )
+
+
+@raises(RuntimeError)
+def testCheckpointOfNotResumableFormat():
+    """
+    Transcode with checkpoints to a format which can't be resumed.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    outputFileName = "testCheckpointOfNotResumableFormat.wav"
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setCheckpoint( outputFileName + ".checkpoint" )
+    transcoder.add( inputFileName, 0, "wave24b48kmono" )
+
+    transcoder.process()
+
+
+@raises(RuntimeError)
+def testCheckpointOfRawInterFormat():
+    """
+    Transcode with checkpoints to the raw format of an inter codec, which can't be cut at any packet.
+    """
+    outputFileName = "testCheckpointOfRawInterFormat.m2v"
+
+    ouputFile = av.OutputFile( outputFileName, "mpeg2video" )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setCheckpoint( outputFileName + ".checkpoint" )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, 1 )
+
+    videoCodec = av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" )
+    imageDesc = av.VideoFrameDesc( 1920, 1080, "yuv422p" )
+    videoCodec.setImageParameters( imageDesc )
+    transcoder.add( "", 0, "dnxhd120", videoCodec )
+
+    transcoder.process()
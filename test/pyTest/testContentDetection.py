@@ -0,0 +1,159 @@
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def generateDummyVideo( outputFileName, duration ):
+    """
+    Generate a black video encoded in DNxHD.
+    """
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, duration )
+
+    videoCodec = av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" )
+    imageDesc = av.VideoFrameDesc( 1920, 1080, "yuv422p" )
+    videoCodec.setImageParameters( imageDesc )
+    transcoder.add( "", 0, "dnxhd120", videoCodec )
+
+    transcoder.process()
+
+
+def generateDummyAudio( outputFileName, duration ):
+    """
+    Generate a silent audio encoded in PCM.
+    """
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, duration )
+
+    audioCodec = av.AudioCodec( av.eCodecTypeEncoder, "pcm_s16le" )
+    audioDesc = av.AudioFrameDesc( 48000, 1, "s16" )
+    audioCodec.setAudioParameters( audioDesc )
+    transcoder.add( "", 0, "wave24b48kmono", audioCodec )
+
+    transcoder.process()
+
+
+def testDetectContentWhenAnalysing():
+    """
+    Analyse a black video and a silent audio: a segment is detected along each stream.
+    """
+    videoFileName = "testDetectContentWhenAnalysing.mov"
+    generateDummyVideo( videoFileName, 3 )
+    audioFileName = "testDetectContentWhenAnalysing.wav"
+    generateDummyAudio( audioFileName, 3 )
+
+    videoProperties = av.InputFile.analyseFile( videoFileName, av.NoDisplayProgress(), av.eAnalyseLevelFull )
+    blackSegments = videoProperties.getBlackSegments( 0 )
+    assert_equals( 1, len(blackSegments) )
+    assert_equals( 0, blackSegments[0]._startTime )
+    assert_almost_equals( 3, blackSegments[0]._endTime, delta=0.1 )
+    freezeSegments = videoProperties.getFreezeSegments( 0 )
+    assert_equals( 1, len(freezeSegments) )
+    assert_almost_equals( 3, freezeSegments[0].getDuration(), delta=0.1 )
+
+    audioProperties = av.InputFile.analyseFile( audioFileName, av.NoDisplayProgress(), av.eAnalyseLevelFull )
+    silenceSegments = audioProperties.getSilenceSegments( 0 )
+    assert_equals( 1, len(silenceSegments) )
+    assert_almost_equals( 3, silenceSegments[0].getDuration(), delta=0.1 )
+
+
+def testDetectNoContentWhenAnalysingTheHeader():
+    """
+    The frames are not decoded when analysing the header.
+    """
+    videoFileName = "testDetectNoContentWhenAnalysingTheHeader.mov"
+    generateDummyVideo( videoFileName, 1 )
+
+    videoProperties = av.InputFile.analyseFile( videoFileName, av.NoDisplayProgress(), av.eAnalyseLevelHeader )
+    assert_equals( 0, len(videoProperties.getBlackSegments( 0 )) )
+    assert_equals( 0, len(videoProperties.getFreezeSegments( 0 )) )
+
+
+class CancelProgress(av.IProgress):
+    """
+    Cancel the process after the given duration.
+    """
+    def __init__(self, cancelDuration):
+        av.IProgress.__init__(self)
+        self.cancelDuration = cancelDuration
+
+    def progress(self, processedDuration, programDuration):
+        if processedDuration >= self.cancelDuration:
+            return av.eJobStatusCancel
+        return av.eJobStatusContinue
+
+
+def testDetectNoContentWhenAnalysisIsCancelled():
+    """
+    The segments of a part of the file are not given when the analysis is cancelled.
+    """
+    videoFileName = "testDetectNoContentWhenAnalysisIsCancelled.mov"
+    generateDummyVideo( videoFileName, 3 )
+
+    videoProperties = av.InputFile.analyseFile( videoFileName, CancelProgress( 1 ), av.eAnalyseLevelFull )
+    assert_equals( 0, len(videoProperties.getBlackSegments( 0 )) )
+    assert_equals( 0, len(videoProperties.getFreezeSegments( 0 )) )
+
+
+def testDetectContentWhenTranscoding():
+    """
+    Transcode a black video and a silent audio with the detection of their content.
+    The segments shorter than the minimum duration are ignored.
+    """
+    videoFileName = "testDetectContentWhenTranscodingInput.mov"
+    generateDummyVideo( videoFileName, 3 )
+    audioFileName = "testDetectContentWhenTranscodingInput.wav"
+    generateDummyAudio( audioFileName, 3 )
+
+    ouputFile = av.OutputFile( "testDetectContentWhenTranscoding.mov" )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setContentDetection( True, 1 )
+    transcoder.add( videoFileName, 0, "dnxhd120" )
+    transcoder.add( audioFileName, 0, "wave24b48kmono" )
+
+    processStat = transcoder.process()
+
+    videoStat = processStat.getVideoStat( 0 )
+    assert_equals( 1, len(videoStat._blackSegments) )
+    assert_almost_equals( 3, videoStat._blackSegments[0].getDuration(), delta=0.1 )
+    assert_equals( 1, len(videoStat._freezeSegments) )
+
+    audioStat = processStat.getAudioStat( 1 )
+    assert_equals( 1, len(audioStat._silenceSegments) )
+    assert_almost_equals( 3, audioStat._silenceSegments[0].getDuration(), delta=0.1 )
+
+    # the segments are longer than 1 second, but shorter than 5 seconds
+    ouputFile = av.OutputFile( "testDetectContentWhenTranscodingMinDuration.mov" )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setContentDetection( True, 5 )
+    transcoder.add( videoFileName, 0, "dnxhd120" )
+
+    processStat = transcoder.process()
+    videoStat = processStat.getVideoStat( 0 )
+    assert_equals( 0, len(videoStat._blackSegments) )
+    assert_equals( 0, len(videoStat._freezeSegments) )
+
+
+def testDetectContentFromInPoint():
+    """
+    Transcode a black video from an in point: the segments are in the time of the input stream.
+    """
+    videoFileName = "testDetectContentFromInPointInput.mov"
+    generateDummyVideo( videoFileName, 3 )
+
+    ouputFile = av.OutputFile( "testDetectContentFromInPoint.mov" )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setContentDetection( True, 1 )
+    transcoder.add( videoFileName, 0, "dnxhd120", 1., 3. )
+
+    processStat = transcoder.process()
+
+    videoStat = processStat.getVideoStat( 0 )
+    assert_equals( 1, len(videoStat._blackSegments) )
+    assert_almost_equals( 1, videoStat._blackSegments[0]._startTime, delta=0.1 )
+    assert_almost_equals( 3, videoStat._blackSegments[0]._endTime, delta=0.1 )
@@ -0,0 +1,56 @@
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def writeDummyVideoAndAudio( outputFileName ):
+    """
+    Write a generated video and a generated audio of 1 second.
+    """
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, 1 )
+
+    videoCodec = av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" )
+    imageDesc = av.VideoFrameDesc( 1920, 1080, "yuv422p" )
+    videoCodec.setImageParameters( imageDesc )
+    transcoder.add( "", 0, "dnxhd120", videoCodec )
+
+    audioCodec = av.AudioCodec( av.eCodecTypeEncoder, "pcm_s16le" )
+    audioDesc = av.AudioFrameDesc( 48000, 1, "s16" )
+    audioCodec.setAudioParameters( audioDesc )
+    transcoder.add( "", 0, "wave24b48kmono", audioCodec )
+
+    transcoder.process()
+
+
+def rewrapStreams( inputFileName, outputFileName, streamIndexes ):
+    """
+    Rewrap the given streams, and digest their packets.
+    """
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setFrameDigest( outputFileName + ".csv", av.eDigestAlgorithmMd5, av.eDigestedDataEncoded )
+    for streamIndex in streamIndexes:
+        transcoder.add( inputFileName, streamIndex, "" )
+    return transcoder.process()
+
+
+def testDiscardedStreamsDoNotChangeTheOutput():
+    """
+    Rewrap only the audio stream: the video stream is discarded by the demuxer, and the audio packets are the same as when all the streams are read.
+    """
+    inputFileName = "testDiscardedStreamsInput.mov"
+    writeDummyVideoAndAudio( inputFileName )
+
+    allStreamsStat = rewrapStreams( inputFileName, "testDiscardedStreamsAll.mov", [ 0, 1 ] )
+    audioStreamStat = rewrapStreams( inputFileName, "testDiscardedStreamsAudio.mov", [ 1 ] )
+
+    expectedAudioStat = allStreamsStat.getAudioStat( 1 )
+    audioStat = audioStreamStat.getAudioStat( 0 )
+    assert_greater( audioStat._nbFrames, 0 )
+    assert_equals( expectedAudioStat._nbFrames, audioStat._nbFrames )
+    assert_equals( expectedAudioStat._encodedDigest, audioStat._encodedDigest )
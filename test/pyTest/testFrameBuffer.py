@@ -0,0 +1,121 @@
+import os
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testVideoFrameDataView():
+    """
+    Modify the data of a video frame through its view.
+    """
+    frameDesc = av.VideoFrameDesc( 16, 8, "rgb24" )
+    frame = av.VideoFrame( frameDesc )
+    frame.assign( frameDesc.getDataSize(), 16 )
+
+    view = frame.getDataView()
+    assert_equals( frameDesc.getDataSize(), len(view) )
+    assert_equals( 16, bytearray(view)[0] )
+
+    view[0:1] = b"\x20"
+    assert_equals( 32, bytearray(frame.getDataView())[0] )
+
+
+def testVideoFrameArrayInterface():
+    """
+    View a packed video frame as a numpy array of (height, width, components), without copy.
+    """
+    try:
+        import numpy
+    except ImportError:
+        from nose.plugins.skip import SkipTest
+        raise SkipTest("Need numpy")
+
+    frameDesc = av.VideoFrameDesc( 16, 8, "rgb24" )
+    frame = av.VideoFrame( frameDesc )
+    frame.assign( frameDesc.getDataSize(), 16 )
+
+    array = numpy.asarray( frame )
+    assert_equals( (8, 16, 3), array.shape )
+    assert_equals( numpy.uint8, array.dtype )
+
+    # no copy
+    array[0, 0, 0] = 32
+    assert_equals( 32, bytearray(frame.getDataView())[0] )
+
+
+def testAudioFrameArrayInterface():
+    """
+    View an audio frame as a numpy array of (samples, channels), without copy.
+    """
+    try:
+        import numpy
+    except ImportError:
+        from nose.plugins.skip import SkipTest
+        raise SkipTest("Need numpy")
+
+    frameDesc = av.AudioFrameDesc( 48000, 2, "s16" )
+    frame = av.AudioFrame( frameDesc )
+    frame.assign( 1024 * 2 * 2, 0 )
+
+    array = numpy.asarray( frame )
+    assert_equals( (1024, 2), array.shape )
+    assert_equals( numpy.int16, array.dtype )
+
+
+def testPlanarVideoFrameArrayInterface():
+    """
+    View a planar video frame as a numpy array of (planes, height, width), and its subsampled planes one by one.
+    """
+    try:
+        import numpy
+    except ImportError:
+        from nose.plugins.skip import SkipTest
+        raise SkipTest("Need numpy")
+
+    frameDesc = av.VideoFrameDesc( 16, 8, "yuv444p" )
+    frame = av.VideoFrame( frameDesc )
+    frame.assign( frameDesc.getDataSize(), 16 )
+    array = numpy.asarray( frame )
+    assert_equals( (3, 8, 16), array.shape )
+    assert_equals( (16 * 8, 16, 1), array.strides )
+
+    # the chroma planes of 4:2:0 are subsampled: the frame is viewed as bytes, and each plane as an array
+    frameDesc = av.VideoFrameDesc( 16, 8, "yuv420p" )
+    frame = av.VideoFrame( frameDesc )
+    frame.assign( frameDesc.getDataSize(), 16 )
+    assert_equals( (frameDesc.getDataSize(),), numpy.asarray( frame ).shape )
+
+    planes = [ numpy.asarray( plane ) for plane in frame.getPlanes() ]
+    assert_equals( [ (8, 16), (4, 8), (4, 8) ], [ plane.shape for plane in planes ] )
+
+    # no copy
+    planes[1][0, 0] = 128
+    assert_equals( 128, bytearray(frame.getDataView())[16 * 8] )
+
+
+def testReaderFrameKeptAfterNextRead():
+    """
+    A frame returned by a reader, still viewed by numpy, is not overwritten by the next read.
+    """
+    try:
+        import numpy
+    except ImportError:
+        from nose.plugins.skip import SkipTest
+        raise SkipTest("Need numpy")
+    if os.environ.get('AVTRANSCODER_TEST_VIDEO_AVI_FILE') is None:
+        from nose.plugins.skip import SkipTest
+        raise SkipTest("Need to define environment variable AVTRANSCODER_TEST_VIDEO_AVI_FILE")
+
+    reader = av.VideoReader( os.environ['AVTRANSCODER_TEST_VIDEO_AVI_FILE'], 0 )
+    array = numpy.asarray( reader.readNextFrame() )
+    data = numpy.array( array )
+
+    for frame in range( 10 ):
+        reader.readNextFrame()
+
+    # the frame is given to the array, and its data is still the first image
+    assert_true( numpy.array_equal( data, array ) )
@@ -0,0 +1,85 @@
+import os
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+from dummyVideo import processDummyVideo
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testDigestAlgorithms():
+    """
+    Check the digests of known data.
+    """
+    fnv1a = av.Digest( av.eDigestAlgorithmFnv1a )
+    fnv1a.update( "a", 1 )
+    assert_equals( "af63dc4c8601ec8c", fnv1a.getHexDigest() )
+
+    md5 = av.Digest( av.eDigestAlgorithmMd5 )
+    assert_equals( "d41d8cd98f00b204e9800998ecf8427e", md5.getHexDigest() )
+    md5.update( "abc", 3 )
+    assert_equals( "900150983cd24fb0d6963f7d28e17f72", md5.getHexDigest() )
+    md5.reset()
+    assert_equals( "d41d8cd98f00b204e9800998ecf8427e", md5.getHexDigest() )
+
+    sha256 = av.Digest( av.eDigestAlgorithmSha256 )
+    sha256.update( "abc", 3 )
+    assert_equals( "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", sha256.getHexDigest() )
+
+
+def testFrameDigestReport():
+    """
+    Digest the packets of a generated audio stream, and check the report and the process statistics.
+    """
+    outputFileName = "testFrameDigestReport.wav"
+    reportFileName = "testFrameDigestReport.csv"
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, 1 )
+    transcoder.setFrameDigest( reportFileName, av.eDigestAlgorithmMd5 )
+
+    audioCodec = av.AudioCodec( av.eCodecTypeEncoder, "pcm_s16le" )
+    audioDesc = av.AudioFrameDesc( 48000, 1, "s16" )
+    audioCodec.setAudioParameters( audioDesc )
+    transcoder.add( "", 0, "wave24b48kmono", audioCodec )
+
+    processStat = transcoder.process()
+
+    # the generated frames are not decoded from an input
+    audioStat = processStat.getAudioStat( 0 )
+    assert_equals( "", audioStat._decodedDigest )
+    assert_equals( 32, len(audioStat._encodedDigest) )
+
+    with open(reportFileName) as report:
+        lines = report.read().splitlines()
+    assert_equals( "stream,data,frame,md5", lines[0] )
+    assert_greater( len(lines), 1 )
+    for expectedFrame, line in enumerate( lines[1:] ):
+        streamIndex, data, frame, digest = line.split(",")
+        assert_equals( "0", streamIndex )
+        assert_equals( str(expectedFrame), frame )
+        assert_equals( "encoded", data )
+        assert_equals( 32, len(digest) )
+
+
+def testFrameDigestReportAtDefaultLogLevel():
+    """
+    Digest the packets of a generated video stream with the messages of the default log level.
+    """
+    reportFileName = "testFrameDigestReportAtDefaultLogLevel.csv"
+
+    av.Logger.setLogLevel(av.AV_LOG_INFO)
+    try:
+        processStat = processDummyVideo( "testFrameDigestReportAtDefaultLogLevel.mov",
+            setUpTranscoder = lambda transcoder: transcoder.setFrameDigest( reportFileName, av.eDigestAlgorithmMd5 ) )
+    finally:
+        av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+    videoStat = processStat.getVideoStat( 0 )
+    with open(reportFileName) as report:
+        lines = report.read().splitlines()
+    assert_equals( videoStat._nbFrames, len(lines) - 1 )
@@ -0,0 +1,46 @@
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testBlackImageIsShared():
+    """
+    The generators of the same description share the same black image.
+    """
+    frameDesc = av.VideoFrameDesc( 64, 32, "yuv422p" )
+    blackImage = av.GeneratedFrameCache.getBlackImage( frameDesc )
+    assert_equals( int(blackImage.this), int(av.GeneratedFrameCache.getBlackImage( frameDesc ).this) )
+
+    otherDesc = av.VideoFrameDesc( 64, 32, "yuv420p" )
+    assert_not_equals( int(blackImage.this), int(av.GeneratedFrameCache.getBlackImage( otherDesc ).this) )
+
+
+def testBlackImageValues():
+    """
+    Black is 16 for the luma in video range, 128 for the chroma, and 0 in full range.
+    """
+    data = bytearray( av.GeneratedFrameCache.getBlackImage( av.VideoFrameDesc( 64, 32, "yuv422p" ) ).getDataView() )
+    lumaSize = 64 * 32
+    assert_equals( set([ 16 ]), set(data[:lumaSize]) )
+    assert_equals( set([ 128 ]), set(data[lumaSize:]) )
+
+    data = bytearray( av.GeneratedFrameCache.getBlackImage( av.VideoFrameDesc( 64, 32, "rgb24" ) ).getDataView() )
+    assert_equals( set([ 0 ]), set(data) )
+
+
+def testSilenceIsShared():
+    """
+    The generators of the same description share the same silence.
+    """
+    frameDesc = av.AudioFrameDesc( 48000, 2, "s16" )
+    silence = av.GeneratedFrameCache.getSilence( frameDesc, 1920 )
+    assert_equals( int(silence.this), int(av.GeneratedFrameCache.getSilence( frameDesc, 1920 ).this) )
+    assert_not_equals( int(silence.this), int(av.GeneratedFrameCache.getSilence( frameDesc, 1024 ).this) )
+    assert_equals( set([ 0 ]), set(bytearray( silence.getDataView() )) )
+
+    # unsigned samples are centered
+    silence = av.GeneratedFrameCache.getSilence( av.AudioFrameDesc( 48000, 1, "u8" ), 1920 )
+    assert_equals( set([ 0x80 ]), set(bytearray( silence.getDataView() )) )
@@ -0,0 +1,87 @@
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+from dummyVideo import processDummyVideo
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def transcodeWithOffset( inputFileName, outputFileName, profile, offset, replicate = True ):
+    """
+    Transcode the video with an offset: the first frames are generated.
+    """
+    outputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( outputFile )
+    transcoder.add( inputFileName, 0, profile, offset )
+    transcoder.getStreamTranscoder( 0 ).setReplicateGeneratedFrames( replicate )
+    return transcoder.process()
+
+
+def readFile( fileName ):
+    """
+    Get the content of the given file.
+    """
+    with open( fileName, "rb" ) as inputFile:
+        return inputFile.read()
+
+
+def testReplicateGeneratedFrames():
+    """
+    With an intra-only codec, the generated frames are encoded once: the next ones are the same packet, wrapped again.
+    """
+    inputFileName = "testReplicateGeneratedFramesInput.mov"
+    outputFileName = "testReplicateGeneratedFrames.dnxhd"
+    processDummyVideo( inputFileName )
+
+    processStat = transcodeWithOffset( inputFileName, outputFileName, "dnxhd120", 1 )
+    nbFrames = processStat.getVideoStat( 0 )._nbFrames
+
+    # one second of generated frames at 25 fps, then the frames of the input
+    assert_equals( 50, nbFrames )
+
+    # the raw DNxHD file is the sequence of the packets, which have the same size
+    data = readFile( outputFileName )
+    assert_equals( 0, len(data) % nbFrames )
+    packetSize = len(data) // nbFrames
+    generatedPackets = [ data[i * packetSize:(i + 1) * packetSize] for i in range(25) ]
+    assert_equals( 1, len(set(generatedPackets)) )
+
+
+def testEncodeEachGeneratedFrame():
+    """
+    Without replication, each generated frame is encoded, to the same coded data as the replicated frames with an intra-only codec.
+    """
+    inputFileName = "testEncodeEachGeneratedFrameInput.mov"
+    processDummyVideo( inputFileName )
+
+    replicatedStat = transcodeWithOffset( inputFileName, "testEncodeEachGeneratedFrameReplicated.dnxhd", "dnxhd120", 1, True )
+    encodedStat = transcodeWithOffset( inputFileName, "testEncodeEachGeneratedFrame.dnxhd", "dnxhd120", 1, False )
+
+    assert_equals( replicatedStat.getVideoStat( 0 )._nbFrames, encodedStat.getVideoStat( 0 )._nbFrames )
+    assert_equals( readFile( "testEncodeEachGeneratedFrameReplicated.dnxhd" ), readFile( "testEncodeEachGeneratedFrame.dnxhd" ) )
+
+
+def testNoReplicationOfInterFrames():
+    """
+    With a codec which is not intra-only, the generated frames are still encoded one by one: the replication has no effect.
+    """
+    inputFileName = "testNoReplicationOfInterFramesInput.mov"
+    processDummyVideo( inputFileName )
+
+    mpeg2Profile = {
+        av.avProfileIdentificator : "testMpeg2",
+        av.avProfileIdentificatorHuman : "MPEG-2 with a GOP",
+        av.avProfileType : av.avProfileTypeVideo,
+        av.avProfileCodec : "mpeg2video",
+        av.avProfilePixelFormat : "yuv422p",
+        "g" : "12",
+        "bf" : "2",
+    }
+    replicatedStat = transcodeWithOffset( inputFileName, "testNoReplicationOfInterFramesReplicated.m2v", mpeg2Profile, 1, True )
+    encodedStat = transcodeWithOffset( inputFileName, "testNoReplicationOfInterFrames.m2v", mpeg2Profile, 1, False )
+
+    assert_equals( 50, replicatedStat.getVideoStat( 0 )._nbFrames )
+    assert_equals( replicatedStat.getVideoStat( 0 )._nbFrames, encodedStat.getVideoStat( 0 )._nbFrames )
+    assert_equals( readFile( "testNoReplicationOfInterFramesReplicated.m2v" ), readFile( "testNoReplicationOfInterFrames.m2v" ) )
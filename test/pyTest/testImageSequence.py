@@ -0,0 +1,72 @@
+import os
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testWriteAndReadImageSequence():
+    """
+    Write an image sequence on several threads, and read it back in order.
+    """
+    filenamePattern = "testImageSequence.%04d.png"
+    nbImages = 10
+
+    frameDesc = av.VideoFrameDesc( 64, 64, "rgb24" )
+    frame = av.VideoFrame( frameDesc )
+
+    writer = av.ImageSequenceWriter( filenamePattern, "png", frameDesc, {}, 4 )
+    for i in range(nbImages):
+        frame.assign( frameDesc.getDataSize(), i * 10 )
+        writer.writeFrame( frame )
+    writer.flush()
+
+    assert_equals( nbImages, writer.getNbWrittenFrames() )
+    for i in range(nbImages):
+        assert_true( os.path.exists( filenamePattern % i ) )
+    assert_false( os.path.exists( filenamePattern % nbImages ) )
+
+    # the images are returned in order, with their content (png is lossless)
+    reader = av.ImageSequenceReader( filenamePattern, 0, 4 )
+    readFrame = av.Frame()
+    for i in range(nbImages):
+        assert_true( reader.readNextFrame( readFrame ) )
+        assert_equals( frameDesc.getDataSize(), readFrame.getSize() )
+        assert_equals( set([i * 10]), set(bytearray(readFrame.getDataView())) )
+    assert_false( reader.readNextFrame( readFrame ) )
+    assert_equals( nbImages, reader.getNbReadFrames() )
+
+
+def testWriteImageSequenceFromIndex():
+    """
+    Write an image sequence which starts at the given index in the filenames.
+    """
+    filenamePattern = "testImageSequenceFromIndex.%04d.png"
+    firstIndex = 100
+
+    frameDesc = av.VideoFrameDesc( 32, 32, "rgb24" )
+    frame = av.VideoFrame( frameDesc )
+    frame.assign( frameDesc.getDataSize(), 128 )
+
+    writer = av.ImageSequenceWriter( filenamePattern, "png", frameDesc, {}, 2, firstIndex )
+    writer.writeFrame( frame )
+    writer.flush()
+
+    assert_true( os.path.exists( filenamePattern % firstIndex ) )
+
+
+@raises(RuntimeError)
+def testWriteImageSequenceWithWrongPattern():
+    """
+    Write an image sequence with a pattern without the index of the image.
+    """
+    frameDesc = av.VideoFrameDesc( 32, 32, "rgb24" )
+    frame = av.VideoFrame( frameDesc )
+    frame.assign( frameDesc.getDataSize(), 128 )
+
+    writer = av.ImageSequenceWriter( "testImageSequenceWithWrongPattern.png", "png", frameDesc, {}, 1 )
+    writer.writeFrame( frame )
+    writer.flush()
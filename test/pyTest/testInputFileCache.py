@@ -0,0 +1,51 @@
+import os
+
+# Check if environment is setup to run the tests
+if os.environ.get('AVTRANSCODER_TEST_VIDEO_AVI_FILE') is None:
+    from nose.plugins.skip import SkipTest
+    raise SkipTest("Need to define environment variable AVTRANSCODER_TEST_VIDEO_AVI_FILE")
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def readAllPackets(inputStream):
+    nbPackets = 0
+    data = av.Frame()
+    while inputStream.readNextPacket(data):
+        nbPackets += 1
+    return nbPackets
+
+
+def testSpillPacketsInTemporaryFile():
+    """
+    Read all the packets of a stream, then all the packets of another stream, with a very small cache:
+    the packets of the second stream are written in a temporary file.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_VIDEO_AVI_FILE']
+
+    # reference: no limit of cache
+    inputFile = av.InputFile( inputFileName )
+    inputFile.activateStream( 0 )
+    inputFile.activateStream( 1 )
+    readAllPackets( inputFile.getStream( 0 ) )
+    nbPacketsOfStream1 = readAllPackets( inputFile.getStream( 1 ) )
+    assert_equals( 0, inputFile.getNbSpilledPackets() )
+    assert_greater( inputFile.getPeakCacheSize(), 0 )
+
+    # with a cache of 1 byte
+    inputFile = av.InputFile( inputFileName )
+    inputFile.setMaxCacheSize( 1 )
+    inputFile.activateStream( 0 )
+    inputFile.activateStream( 1 )
+    readAllPackets( inputFile.getStream( 0 ) )
+    assert_equals( 0, inputFile.getCacheSize() )
+    assert_greater( inputFile.getNbSpilledPackets(), 0 )
+    assert_greater( inputFile.getSpilledSize(), 0 )
+
+    assert_equals( nbPacketsOfStream1, readAllPackets( inputFile.getStream( 1 ) ) )
+    assert_equals( 0, inputFile.getSpilledSize() )
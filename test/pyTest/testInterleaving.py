@@ -0,0 +1,45 @@
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testInterleaveByOutputTimestamps():
+    """
+    Process a generated video and a generated audio, frame by frame: each frame is taken from the stream which is the most behind.
+    """
+    outputFileName = "testInterleaveByOutputTimestamps.mov"
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+
+    videoCodec = av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" )
+    imageDesc = av.VideoFrameDesc( 1920, 1080, "yuv422p" )
+    videoCodec.setImageParameters( imageDesc )
+    transcoder.add( "", 0, "dnxhd120", videoCodec )
+
+    audioCodec = av.AudioCodec( av.eCodecTypeEncoder, "pcm_s16le" )
+    audioDesc = av.AudioFrameDesc( 48000, 1, "s16" )
+    audioCodec.setAudioParameters( audioDesc )
+    transcoder.add( "", 0, "wave24b48kmono", audioCodec )
+
+    ouputFile.beginWrap()
+    nbProcessedFrames = [ 0, 0 ]
+    for frame in range( 100 ):
+        durations = [ ouputFile.getStream( streamIndex ).getStreamDuration() for streamIndex in range( 2 ) ]
+        assert_true( transcoder.processFrame() )
+        newDurations = [ ouputFile.getStream( streamIndex ).getStreamDuration() for streamIndex in range( 2 ) ]
+
+        # only the stream with the smallest output duration is processed
+        processedStreams = [ streamIndex for streamIndex in range( 2 ) if newDurations[streamIndex] > durations[streamIndex] ]
+        assert_equals( 1, len(processedStreams) )
+        assert_equals( min(durations), durations[processedStreams[0]] )
+        nbProcessedFrames[processedStreams[0]] += 1
+    ouputFile.endWrap()
+
+    # both streams are processed, and the output is interleaved within a video frame
+    assert_greater( nbProcessedFrames[0], 0 )
+    assert_greater( nbProcessedFrames[1], 0 )
+    assert_less_equal( abs( newDurations[0] - newDurations[1] ), 1. / 25 + 1e-6 )
@@ -0,0 +1,90 @@
+import os
+import timeit
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+
+def testAsyncLogInFile():
+    """
+    Log in file from a background thread: all the messages are written when the logging mode changes.
+    """
+    av.Logger.setLogLevel(av.AV_LOG_INFO)
+    av.Logger.logInFile(True)
+
+    nbMessages = 100
+    for i in range(nbMessages):
+        av.Logger.log(av.AV_LOG_INFO, "message " + str(i))
+    # stop the background thread
+    av.Logger.logInFile()
+
+    with open("avtranscoder.log") as logFile:
+        lines = logFile.readlines()
+
+    assert_equals( 0, av.Logger.getNbDroppedLogs() )
+    assert_equals( nbMessages, len(lines) )
+    assert_true( lines[-1].endswith("message " + str(nbMessages - 1) + "\n") )
+
+    # the next messages are appended
+    av.Logger.log(av.AV_LOG_INFO, "synchronous message")
+    with open("avtranscoder.log") as logFile:
+        lines = logFile.readlines()
+    assert_equals( nbMessages + 1, len(lines) )
+
+    av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testAsyncLogFlush():
+    """
+    Wait until the messages are written, without leaving the asynchronous mode.
+    """
+    av.Logger.setLogLevel(av.AV_LOG_INFO)
+    av.Logger.logInFile(True)
+
+    nbMessages = 100
+    for i in range(nbMessages):
+        av.Logger.log(av.AV_LOG_INFO, "message " + str(i))
+    av.Logger.flush()
+
+    with open("avtranscoder.log") as logFile:
+        lines = logFile.readlines()
+    assert_equals( nbMessages, len(lines) )
+
+    av.Logger.logInFile()
+    av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testLogLevelIsEnabled():
+    """
+    Only the messages of the set level, or more important, are enabled.
+    """
+    av.Logger.setLogLevel(av.AV_LOG_WARNING)
+    assert_true( av.Logger.isEnabled(av.AV_LOG_ERROR) )
+    assert_true( av.Logger.isEnabled(av.AV_LOG_WARNING) )
+    assert_false( av.Logger.isEnabled(av.AV_LOG_INFO) )
+    assert_false( av.Logger.isEnabled(av.AV_LOG_DEBUG) )
+
+    av.Logger.setLogLevel(av.AV_LOG_QUIET)
+    assert_false( av.Logger.isEnabled(av.AV_LOG_ERROR) )
+
+
+def testDisabledLogLevel():
+    """
+    The messages of a disabled level are neither formatted nor written, and cost much less than the written ones.
+    """
+    av.Logger.logInFile()
+    av.Logger.setLogLevel(av.AV_LOG_WARNING)
+
+    nbMessages = 1000
+    disabledTime = timeit.timeit( lambda: av.Logger.log(av.AV_LOG_DEBUG, "disabled message"), number=nbMessages )
+    enabledTime = timeit.timeit( lambda: av.Logger.log(av.AV_LOG_WARNING, "enabled message"), number=nbMessages )
+    print( "%d log calls: %.3fms at a disabled level, %.3fms at an enabled level" % ( nbMessages, disabledTime * 1000, enabledTime * 1000 ) )
+
+    with open("avtranscoder.log") as logFile:
+        lines = logFile.readlines()
+    assert_equals( nbMessages, len(lines) )
+    assert_false( any( "disabled message" in line for line in lines ) )
+    assert_less( disabledTime, enabledTime )
+
+    av.Logger.setLogLevel(av.AV_LOG_QUIET)
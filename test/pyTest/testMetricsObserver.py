@@ -0,0 +1,70 @@
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+from dummyVideo import processDummyVideo
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+class MetricsCollector( av.IMetricsObserver ):
+    """
+    Keep the batches of metrics given during the process.
+    """
+    def __init__( self ):
+        av.IMetricsObserver.__init__( self )
+        self.batches = []
+
+    def onFrameMetrics( self, metrics ):
+        self.batches.append( [ frameMetrics for frameMetrics in metrics ] )
+
+
+def processObservedDummyVideo( outputFileName, observer, samplingInterval, batchSize ):
+    """
+    Encode a generated video, observed with the given parameters.
+    """
+    return processDummyVideo( outputFileName, setUpTranscoder = lambda transcoder: transcoder.setMetricsObserver( observer, samplingInterval, batchSize ) )
+
+
+def testMetricsOfEachFrame():
+    """
+    The metrics of each encoded frame are given by batches.
+    """
+    observer = MetricsCollector()
+    processStat = processObservedDummyVideo( "testMetricsOfEachFrame.mov", observer, 1, 10 )
+    nbFrames = processStat.getVideoStat( 0 )._nbFrames
+
+    for batch in observer.batches:
+        assert_greater( len(batch), 0 )
+        assert_less_equal( len(batch), 10 )
+
+    metrics = [ frameMetrics for batch in observer.batches for frameMetrics in batch ]
+    assert_equals( list(range(nbFrames)), [ frameMetrics._frame for frameMetrics in metrics ] )
+    for frameMetrics in metrics:
+        assert_equals( 0, frameMetrics._streamIndex )
+        assert_greater( frameMetrics._size, 0 )
+        assert_greater( frameMetrics._time, 0 )
+        # DNxHD is intra-only
+        assert_equals( 'I', frameMetrics._pictureType )
+        assert_true( frameMetrics._isKeyFrame )
+        assert_greater_equal( frameMetrics._encodeTime, 0 )
+        assert_greater_equal( frameMetrics._wrapTime, 0 )
+        # a generated stream has no input stream
+        assert_equals( 0, frameMetrics._nbCachedPackets )
+
+    # the wrap time of the packets is measured by the output file
+    assert_almost_equals( processStat.getVideoStat( 0 )._muxStat._wallTime, sum([ frameMetrics._wrapTime for frameMetrics in metrics ]), delta=1e-3 )
+
+
+def testSampledMetrics():
+    """
+    Only the metrics of one frame out of the sampling interval are given.
+    """
+    observer = MetricsCollector()
+    processStat = processObservedDummyVideo( "testSampledMetrics.mov", observer, 5, 3 )
+    nbFrames = processStat.getVideoStat( 0 )._nbFrames
+
+    metrics = [ frameMetrics for batch in observer.batches for frameMetrics in batch ]
+    assert_equals( list(range(0, nbFrames, 5)), [ frameMetrics._frame for frameMetrics in metrics ] )
+    assert_equals( [ 3 ] * ( len(observer.batches) - 1 ), [ len(batch) for batch in observer.batches[:-1] ] )
@@ -73,3 +73,41 @@ def testNbSamplesAudioTranscode():
     dst_audioStream = dst_properties.getAudioProperties()[0]
 
     assert_equals( src_audioStream.getNbSamples(), dst_audioStream.getNbSamples() )
+
+def testNbSamplesAudioTranscodeResampled():
+    """
+    Transcode one audio stream at another sample rate, check nb samples (the resampler keeps samples in its delay).
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    outputFileName = "testNbSamplesAudioTranscodeResampled.wav"
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+
+    # create custom profile
+    customProfile = av.ProfileMap()
+    customProfile[av.avProfileIdentificator] = "customProfile"
+    customProfile[av.avProfileIdentificatorHuman] = "custom profile"
+    customProfile[av.avProfileType] = av.avProfileTypeAudio
+    customProfile[av.avProfileCodec] = "pcm_s16le"
+    customProfile[av.avProfileSampleRate] = "44100"
+
+    transcoder.add( inputFileName, 0, customProfile )
+
+    progress = av.ConsoleProgress()
+    transcoder.process( progress )
+
+    # get src file of transcode
+    src_inputFile = av.InputFile( inputFileName )
+    src_properties = src_inputFile.getProperties()
+    src_audioStream = src_properties.getAudioProperties()[0]
+
+    # get dst file of transcode
+    dst_inputFile = av.InputFile( outputFileName )
+    dst_properties = dst_inputFile.getProperties()
+    dst_audioStream = dst_properties.getAudioProperties()[0]
+
+    assert_equals( 44100, dst_audioStream.getSampleRate() )
+    # the samples output are the resampled ones, except the last ones kept in the delay of the resampler
+    expectedNbSamples = src_audioStream.getNbSamples() * 44100 / src_audioStream.getSampleRate()
+    assert_almost_equals( expectedNbSamples, dst_audioStream.getNbSamples(), delta=64 * src_audioStream.getChannels() )
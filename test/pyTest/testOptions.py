@@ -0,0 +1,55 @@
+import timeit
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testCodecOptionsLoadedOnDemand():
+    """
+    The options of a codec are wrapped only when they are accessed.
+    """
+    videoCodec = av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" )
+    assert_equals( 0, videoCodec.getNbLoadedOptions() )
+
+    # only the requested option is wrapped, once
+    videoCodec.getOption( "b" )
+    videoCodec.getOption( "b" )
+    assert_equals( 1, videoCodec.getNbLoadedOptions() )
+
+    # set an option without wrapping it
+    videoCodec.setOption( "g", "12" )
+    assert_equals( 1, videoCodec.getNbLoadedOptions() )
+
+    # all the options are wrapped
+    options = videoCodec.getOptions()
+    assert_greater( len(options), 1 )
+    assert_equals( len(options), videoCodec.getNbLoadedOptions() )
+
+
+def testFormatOptionsLoadedOnDemand():
+    """
+    The options of a format are wrapped only when they are accessed.
+    """
+    outputFile = av.OutputFile( "testFormatOptionsLoadedOnDemand.mov" )
+    formatContext = outputFile.getFormatContext()
+    assert_equals( 0, formatContext.getNbLoadedOptions() )
+
+    formatContext.getOption( "packetsize" )
+    assert_equals( 1, formatContext.getNbLoadedOptions() )
+
+    assert_raises( IndexError, formatContext.getOption, "notAnOption" )
+
+
+def testCodecConstructionWithoutOptions():
+    """
+    Measure the construction of a codec, with and without wrapping all its options.
+    """
+    nbCodecs = 100
+    lazyTime = timeit.timeit( lambda: av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" ), number=nbCodecs )
+    eagerTime = timeit.timeit( lambda: av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" ).getOptions(), number=nbCodecs )
+    print( "Construction of %d codecs: %.3fms without loading the options, %.3fms with all the options" % ( nbCodecs, lazyTime * 1000, eagerTime * 1000 ) )
+    assert_less( lazyTime, eagerTime )
@@ -0,0 +1,62 @@
+import hashlib
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def transcodeDummyAudio( outputFileName, algorithm=None ):
+    """
+    Write one second of generated audio in the given file, and returns its digest computed while it is written.
+    """
+    ouputFile = av.OutputFile( outputFileName )
+    if algorithm is not None:
+        ouputFile.setDigest( algorithm )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, 1 )
+
+    audioCodec = av.AudioCodec( av.eCodecTypeEncoder, "pcm_s16le" )
+    audioDesc = av.AudioFrameDesc( 48000, 1, "s16" )
+    audioCodec.setAudioParameters( audioDesc )
+    transcoder.add( "", 0, "wave24b48kmono", audioCodec )
+
+    transcoder.process()
+    return ouputFile.getDigest()
+
+
+def fileDigest( filename, algorithm ):
+    with open(filename, "rb") as f:
+        return hashlib.new( algorithm, f.read() ).hexdigest()
+
+
+def testOutputFileDigestWithRewrittenHeader():
+    """
+    The sizes in the header of a wave file are rewritten at the end: the file is read again to get its digest.
+    """
+    outputFileName = "testOutputFileDigest.wav"
+
+    digest = transcodeDummyAudio( outputFileName, av.eDigestAlgorithmMd5 )
+    assert_equals( fileDigest( outputFileName, "md5" ), digest )
+
+    digest = transcodeDummyAudio( outputFileName, av.eDigestAlgorithmSha256 )
+    assert_equals( fileDigest( outputFileName, "sha256" ), digest )
+
+
+def testOutputFileDigestOfStreamingFormat():
+    """
+    A mpegts file is written in order: it is digested while it is written.
+    """
+    outputFileName = "testOutputFileDigest.ts"
+
+    digest = transcodeDummyAudio( outputFileName, av.eDigestAlgorithmSha256 )
+    assert_equals( fileDigest( outputFileName, "sha256" ), digest )
+
+
+def testOutputFileNotDigested():
+    """
+    No digest if it is not asked.
+    """
+    assert_equals( "", transcodeDummyAudio( "testOutputFileNotDigested.wav" ) )
@@ -0,0 +1,105 @@
+import os
+
+# Check if environment is setup to run the tests
+if os.environ.get('AVTRANSCODER_TEST_AUDIO_WAVE_FILE') is None:
+    from nose.plugins.skip import SkipTest
+    raise SkipTest("Need to define environment variable AVTRANSCODER_TEST_AUDIO_WAVE_FILE")
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testProbeCacheAnalyseOnce():
+    """
+    Analyse the same file several times: only one entry is created in the cache.
+    """
+    av.ProbeCache.clear()
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+
+    properties = av.ProbeCache.getProperties( inputFileName, av.eAnalyseLevelHeader )
+    propertiesFromAnalyseFile = av.InputFile.analyseFile( inputFileName, av.NoDisplayProgress(), av.eAnalyseLevelHeader )
+
+    assert_equals( 1, av.ProbeCache.getNbEntries() )
+    assert_equals( properties.getFilename(), propertiesFromAnalyseFile.getFilename() )
+    assert_equals( properties.getNbStreams(), propertiesFromAnalyseFile.getNbStreams() )
+
+
+def testProbeCacheWithTranscoder():
+    """
+    Transcode twice the same file: the profile of the input stream is get from the cache.
+    """
+    av.ProbeCache.clear()
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+
+    for outputFileName in ( "testProbeCacheWithTranscoder1.wav", "testProbeCacheWithTranscoder2.wav" ):
+        ouputFile = av.OutputFile( outputFileName )
+        transcoder = av.Transcoder( ouputFile )
+        # transcode the first channel of the stream with the same codec (demultiplexing)
+        transcoder.add( inputFileName, 0, 0 )
+        transcoder.process()
+
+    assert_equals( 1, av.ProbeCache.getNbEntries() )
+
+
+def testProbeCacheMaxNbEntries():
+    """
+    Analyse more files than the maximum number of entries: the least recently used ones are removed.
+    """
+    av.ProbeCache.clear()
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+
+    # write a second file to analyse
+    outputFileName = "testProbeCacheMaxNbEntries.wav"
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.add( inputFileName, 0, "" )
+    transcoder.process()
+
+    maxNbEntries = av.ProbeCache.getMaxNbEntries()
+    av.ProbeCache.setMaxNbEntries( 1 )
+    try:
+        av.ProbeCache.getProperties( inputFileName, av.eAnalyseLevelHeader )
+        properties = av.ProbeCache.getProperties( outputFileName, av.eAnalyseLevelHeader )
+        assert_equals( 1, av.ProbeCache.getNbEntries() )
+        assert_equals( outputFileName, properties.getFilename() )
+    finally:
+        av.ProbeCache.setMaxNbEntries( maxNbEntries )
+
+
+def testProbeCacheAcquiredPropertiesAfterClear():
+    """
+    The properties acquired by a reader are kept valid when the cache is cleared.
+    """
+    av.ProbeCache.clear()
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+
+    reader = av.AudioReader( inputFileName, 0 )
+    av.ProbeCache.clear()
+    assert_equals( 0, av.ProbeCache.getNbEntries() )
+
+    # the properties of the stream are still valid
+    reader.printInfo()
+    frame = reader.readNextFrame()
+    assert_greater( frame.getSize(), 0 )
+
+
+def testProbeCacheAnalysedPropertiesAfterClear():
+    """
+    The properties returned by InputFile.analyseFile are kept valid when the cache is cleared.
+    """
+    av.ProbeCache.clear()
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+
+    properties = av.InputFile.analyseFile( inputFileName, av.NoDisplayProgress(), av.eAnalyseLevelHeader )
+    nbStreams = properties.getNbStreams()
+    av.ProbeCache.clear()
+    assert_equals( 0, av.ProbeCache.getNbEntries() )
+
+    # the properties of the file and of its streams are still valid
+    assert_equals( inputFileName, properties.getFilename() )
+    assert_equals( nbStreams, properties.getNbStreams() )
+    assert_greater( properties.getAudioProperties()[0].getSampleRate(), 0 )
@@ -0,0 +1,126 @@
+import os
+import tempfile
+import time
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+from dummyVideo import processDummyVideo
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def writeProfileFile( directory, name, bitrate ):
+    """
+    Write a video profile of DNxHD in the given directory.
+    """
+    with open( os.path.join( directory, "v_" + name + ".prf" ), "w" ) as profileFile:
+        profileFile.write( "avProfileName=" + name + "\n" )
+        profileFile.write( "avProfileLongName=" + name + "\n" )
+        profileFile.write( "avProfileType=avProfileTypeVideo\n" )
+        profileFile.write( "codec=dnxhd\n" )
+        profileFile.write( "width=1920\n" )
+        profileFile.write( "height=1080\n" )
+        profileFile.write( "pix_fmt=yuv422p\n" )
+        profileFile.write( "b=" + bitrate + "\n" )
+        profileFile.write( "r=25\n" )
+
+
+def testProfileRegistryIsShared():
+    """
+    The Transcoders get the profiles from the same registry.
+    """
+    registry = av.ProfileRegistry.getInstance()
+    assert_equals( len(registry.getProfiles()), len(av.ProfileRegistry.getInstance().getProfiles()) )
+
+    # two Transcoders get the same profile from the registry
+    assert_true( registry.hasProfile( "dnxhd120" ) )
+    for outputFileName in ( "testProfileRegistryIsShared1.mov", "testProfileRegistryIsShared2.mov" ):
+        processStat = processDummyVideo( outputFileName, "dnxhd120" )
+        assert_greater( processStat.getVideoStat( 0 )._nbFrames, 0 )
+
+
+def testProfileRegistryModifiedProfile():
+    """
+    A profile file added or modified in the AVPROFILES directories is parsed again, and seen by the next Transcoders.
+    """
+    registry = av.ProfileRegistry.getInstance()
+    profilesDirectory = tempfile.mkdtemp()
+    avProfiles = os.environ.get( 'AVPROFILES' )
+    os.environ['AVPROFILES'] = profilesDirectory + ( ":" + avProfiles if avProfiles else "" )
+    try:
+        writeProfileFile( profilesDirectory, "testProfileRegistry", "120M" )
+        registry.reload()
+        assert_true( registry.hasProfile( "testProfileRegistry" ) )
+        assert_equals( "120M", registry.getProfile( "testProfileRegistry" )["b"] )
+        processDummyVideo( "testProfileRegistryModifiedProfile.mov", "testProfileRegistry" )
+
+        # the same file with another profile
+        os.remove( os.path.join( profilesDirectory, "v_testProfileRegistry.prf" ) )
+        writeProfileFile( profilesDirectory, "testProfileRegistryModified", "185M" )
+        registry.reload()
+        assert_false( registry.hasProfile( "testProfileRegistry" ) )
+        assert_true( registry.hasProfile( "testProfileRegistryModified" ) )
+    finally:
+        if avProfiles is None:
+            del os.environ['AVPROFILES']
+        else:
+            os.environ['AVPROFILES'] = avProfiles
+        registry.reload()
+
+
+def testProfileRegistryUpdatedProfile():
+    """
+    A profile file modified in the AVPROFILES directories is parsed again without reloading the registry.
+    """
+    registry = av.ProfileRegistry.getInstance()
+    profilesDirectory = tempfile.mkdtemp()
+    avProfiles = os.environ.get( 'AVPROFILES' )
+    os.environ['AVPROFILES'] = profilesDirectory + ( ":" + avProfiles if avProfiles else "" )
+    try:
+        writeProfileFile( profilesDirectory, "testProfileRegistryUpdated", "120M" )
+        registry.reload()
+        assert_equals( "120M", registry.getProfile( "testProfileRegistryUpdated" )["b"] )
+
+        # the directories are checked at most once per second
+        time.sleep( 1.5 )
+        writeProfileFile( profilesDirectory, "testProfileRegistryUpdated", "36M" )
+        assert_equals( "36M", registry.getProfile( "testProfileRegistryUpdated" )["b"] )
+    finally:
+        if avProfiles is None:
+            del os.environ['AVPROFILES']
+        else:
+            os.environ['AVPROFILES'] = avProfiles
+        registry.reload()
+
+
+def testProfileRegistryFirstDirectoryWins():
+    """
+    A profile defined in several AVPROFILES directories is get from the first one, whatever the order of their paths.
+    """
+    registry = av.ProfileRegistry.getInstance()
+    parentDirectory = tempfile.mkdtemp()
+    firstDirectory = os.path.join( parentDirectory, "a" )
+    secondDirectory = os.path.join( parentDirectory, "b" )
+    os.mkdir( firstDirectory )
+    os.mkdir( secondDirectory )
+    avProfiles = os.environ.get( 'AVPROFILES' )
+    os.environ['AVPROFILES'] = firstDirectory + ":" + secondDirectory + ( ":" + avProfiles if avProfiles else "" )
+    try:
+        writeProfileFile( firstDirectory, "testProfileRegistryOverride", "185M" )
+        writeProfileFile( secondDirectory, "testProfileRegistryOverride", "120M" )
+        registry.reload()
+        assert_equals( "185M", registry.getProfile( "testProfileRegistryOverride" )["b"] )
+
+        # the same directories in the reverse order
+        os.environ['AVPROFILES'] = secondDirectory + ":" + firstDirectory + ( ":" + avProfiles if avProfiles else "" )
+        registry.reload()
+        assert_equals( "120M", registry.getProfile( "testProfileRegistryOverride" )["b"] )
+    finally:
+        if avProfiles is None:
+            del os.environ['AVPROFILES']
+        else:
+            os.environ['AVPROFILES'] = avProfiles
+        registry.reload()
@@ -0,0 +1,93 @@
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testQualityMeasurementOfDummyVideo():
+    """
+    Measure the quality of a generated video encoded in DNxHD: each plane of the yuv422p frames is measured.
+    """
+    outputFileName = "testQualityMeasurementOfDummyVideo.mov"
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, 1 )
+    transcoder.setQualityMeasurement()
+
+    videoCodec = av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" )
+    imageDesc = av.VideoFrameDesc( 1920, 1080, "yuv422p" )
+    videoCodec.setImageParameters( imageDesc )
+    transcoder.add( "", 0, "dnxhd120", videoCodec )
+
+    processStat = transcoder.process()
+    videoStat = processStat.getVideoStat( 0 )
+
+    assert_equals( 3, len(videoStat._planePsnr) )
+    assert_equals( 3, len(videoStat._planeSsim) )
+    for ssim in videoStat._planeSsim:
+        assert_greater( ssim, 0.9 )
+        assert_less_equal( ssim, 1.0 )
+    assert_greater( videoStat._psnr, 0 )
+
+    # each encoded frame is measured, or skipped to bound the overhead
+    assert_greater( videoStat._nbMeasuredFrames, 0 )
+    assert_equals( videoStat._nbFrames, videoStat._nbMeasuredFrames + videoStat._nbSkippedFrames )
+    assert_greater_equal( videoStat._measureTime, 0 )
+
+
+def testQualityMeasurementOfPackedFormat():
+    """
+    Measure the quality of a generated video encoded in PNG: each component of the rgb24 frames is measured separately.
+    """
+    outputFileName = "testQualityMeasurementOfPackedFormat.mov"
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, 1 )
+    transcoder.setQualityMeasurement()
+
+    pngProfile = {
+        av.avProfileIdentificator : "testPng",
+        av.avProfileIdentificatorHuman : "PNG in rgb24",
+        av.avProfileType : av.avProfileTypeVideo,
+        av.avProfileCodec : "png",
+        av.avProfilePixelFormat : "rgb24",
+    }
+    videoCodec = av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" )
+    imageDesc = av.VideoFrameDesc( 1920, 1080, "yuv422p" )
+    videoCodec.setImageParameters( imageDesc )
+    transcoder.add( "", 0, pngProfile, videoCodec )
+
+    processStat = transcoder.process()
+    videoStat = processStat.getVideoStat( 0 )
+
+    # PNG is lossless
+    assert_equals( 3, len(videoStat._planeSsim) )
+    for ssim in videoStat._planeSsim:
+        assert_almost_equals( 1.0, ssim )
+    assert_greater( videoStat._nbMeasuredFrames, 0 )
+
+
+def testNoQualityMeasurement():
+    """
+    No measure if it is not asked.
+    """
+    outputFileName = "testNoQualityMeasurement.mov"
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, 1 )
+
+    videoCodec = av.VideoCodec( av.eCodecTypeEncoder, "mpeg2video" )
+    imageDesc = av.VideoFrameDesc( 1920, 1080, "yuv422p" )
+    videoCodec.setImageParameters( imageDesc )
+    transcoder.add( "", 0, "dnxhd120", videoCodec )
+
+    processStat = transcoder.process()
+    videoStat = processStat.getVideoStat( 0 )
+
+    assert_equals( 0, len(videoStat._planePsnr) )
+    assert_equals( 0, videoStat._nbMeasuredFrames )
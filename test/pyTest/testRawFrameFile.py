@@ -0,0 +1,53 @@
+import os
+import struct
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def readHeader(fileName):
+    """
+    Returns the "key=value" lines of the header of a raw frame file as a dict.
+    """
+    with open(fileName, "rb") as rawFile:
+        header = rawFile.read(av.rawFrameFileAlignment).rstrip(b"\0").decode()
+    values = {}
+    for line in header.splitlines():
+        if "=" in line:
+            key, value = line.split("=", 1)
+            values[key] = value
+    return values
+
+
+def testWriteVideoFrames():
+    """
+    Write video frames in a raw frame file, and check its header and its index.
+    """
+    outputFileName = "testWriteVideoFrames.raw"
+    nbFrames = 3
+
+    frameDesc = av.VideoFrameDesc( 16, 16, "yuv420p" )
+    frame = av.VideoFrame( frameDesc )
+    frame.assign( frameDesc.getDataSize(), 16 )
+
+    rawFile = av.RawFrameFile( outputFileName, frameDesc, 2 )
+    for i in range(nbFrames):
+        rawFile.writeFrame( frame )
+    rawFile.close()
+
+    header = readHeader( outputFileName )
+    assert_equals( "video", header["mediaType"] )
+    assert_equals( "yuv420p", header["pixelFormat"] )
+    assert_equals( nbFrames, int(header["nbFrames"]) )
+
+    # each frame is aligned in the file
+    with open(outputFileName, "rb") as rawFile:
+        rawFile.seek( int(header["indexOffset"]) )
+        for i in range(nbFrames):
+            offset, size = struct.unpack( "qq", rawFile.read(16) )
+            assert_equals( 0, offset % av.rawFrameFileAlignment )
+            assert_equals( frameDesc.getDataSize(), size )
@@ -0,0 +1,50 @@
+import os
+
+# Check if environment is setup to run the tests
+if os.environ.get('AVTRANSCODER_TEST_AUDIO_WAVE_FILE') is None:
+    from nose.plugins.skip import SkipTest
+    raise SkipTest("Need to define environment variable AVTRANSCODER_TEST_AUDIO_WAVE_FILE")
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testRemuxAllStreams():
+    """
+    Remux all the streams of a file in a single pass.
+    """
+    # get src file of remux
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    src_inputFile = av.InputFile( inputFileName )
+    src_properties = src_inputFile.getProperties()
+    src_audioStream = src_properties.getAudioProperties()[0]
+
+    formatList = src_properties.getFormatName().split(",")
+    outputFileName = "testRemuxAllStreams." + formatList[0]
+    ouputFile = av.OutputFile( outputFileName )
+
+    remuxer = av.Remuxer( src_inputFile, ouputFile )
+    remuxer.addAllStreams()
+    processStat = remuxer.process()
+
+    # get dst file of remux
+    dst_inputFile = av.InputFile( outputFileName )
+    dst_properties = dst_inputFile.getProperties()
+    dst_audioStream = dst_properties.getAudioProperties()[0]
+
+    # check format
+    assert_equals( src_properties.getNbStreams(), dst_properties.getNbStreams() )
+    assert_equals( src_properties.getDuration(), dst_properties.getDuration() )
+
+    # check audio properties
+    src_propertiesMap = src_audioStream.getPropertiesAsMap()
+    dst_propertiesMap = dst_audioStream.getPropertiesAsMap()
+    for key in src_propertiesMap:
+        assert_equals( src_propertiesMap[key], dst_propertiesMap[key] )
+
+    # check process statistics
+    assert_equals( dst_audioStream.getDuration(), processStat.getAudioStat( 0 )._duration )
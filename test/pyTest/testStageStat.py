@@ -0,0 +1,84 @@
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+from dummyVideo import processDummyVideo
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def checkStageStat( stageStat, nbFrames ):
+    """
+    Check the consistency of the statistics of a stage which processed the given number of frames.
+    """
+    assert_equals( nbFrames, stageStat._nbFrames )
+    assert_greater_equal( stageStat._wallTime, 0 )
+    assert_greater_equal( stageStat._cpuTime, 0 )
+    assert_less_equal( stageStat._maxFrameTime, stageStat._wallTime )
+    if stageStat._wallTime > 0:
+        assert_almost_equals( nbFrames / stageStat._wallTime, stageStat.getFps() )
+
+
+def testStageStatOfDummyVideo():
+    """
+    Process a generated video: nothing is demuxed, each generated frame is converted, encoded and wrapped.
+    """
+    processStat = processDummyVideo( "testStageStatOfDummyVideo.mov" )
+    videoStat = processStat.getVideoStat( 0 )
+
+    checkStageStat( videoStat._demuxStat, 0 )
+    checkStageStat( videoStat._convertStat, videoStat._nbFrames )
+    checkStageStat( videoStat._encodeStat, videoStat._nbFrames )
+    checkStageStat( videoStat._muxStat, videoStat._nbFrames )
+    assert_greater( videoStat._encodeStat._outputSize, 0 )
+    assert_equals( videoStat._encodeStat._outputSize, videoStat._muxStat._inputSize )
+
+
+def testStageStatOfTranscodedVideo():
+    """
+    Transcode a video: each packet is demuxed and decoded, and the decoded frames are converted, encoded and wrapped.
+    """
+    inputFileName = "testStageStatOfTranscodedVideoInput.mov"
+    processDummyVideo( inputFileName )
+
+    outputFileName = "testStageStatOfTranscodedVideo.mov"
+    outputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( outputFile )
+    transcoder.add( inputFileName, 0, "dnxhd120" )
+
+    processStat = transcoder.process()
+    videoStat = processStat.getVideoStat( 0 )
+
+    checkStageStat( videoStat._demuxStat, videoStat._nbFrames )
+    checkStageStat( videoStat._decodeStat, videoStat._nbFrames )
+    checkStageStat( videoStat._convertStat, videoStat._nbFrames )
+    checkStageStat( videoStat._encodeStat, videoStat._nbFrames )
+    checkStageStat( videoStat._muxStat, videoStat._nbFrames )
+
+    # the demuxed packets are decoded
+    assert_greater( videoStat._demuxStat._outputSize, 0 )
+    assert_equals( videoStat._demuxStat._outputSize, videoStat._decodeStat._inputSize )
+    assert_equals( videoStat._decodeStat._outputSize, videoStat._convertStat._inputSize )
+
+
+def testCpuTimeMeasurement():
+    """
+    The CPU time of the stages is measured only if it is asked.
+    """
+    assert_false( av.isCpuTimeMeasured() )
+    videoStat = processDummyVideo( "testCpuTimeNotMeasured.mov" ).getVideoStat( 0 )
+    assert_equals( 0, videoStat._encodeStat._cpuTime )
+    assert_greater( videoStat._encodeStat._wallTime, 0 )
+
+    av.setCpuTimeMeasurement( True )
+    try:
+        isCpuTimeMeasured = av.isCpuTimeMeasured()
+        videoStat = processDummyVideo( "testCpuTimeMeasured.mov" ).getVideoStat( 0 )
+    finally:
+        av.setCpuTimeMeasurement( False )
+    # the CPU time is not available on all the systems
+    if isCpuTimeMeasured:
+        assert_greater( videoStat._encodeStat._cpuTime, 0 )
+    else:
+        assert_equals( 0, videoStat._encodeStat._cpuTime )
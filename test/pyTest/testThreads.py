@@ -0,0 +1,50 @@
+import threading
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+class CountProgress(av.IProgress):
+    """
+    Progress implemented in Python, called from the transcode (which released the GIL).
+    """
+    def __init__(self):
+        av.IProgress.__init__(self)
+        self.nbCalls = 0
+
+    def progress(self, processedDuration, programDuration):
+        self.nbCalls += 1
+        return av.eJobStatusContinue
+
+
+def transcodeDummyAudio(outputFileName, progress):
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+    transcoder.setProcessMethod( av.eProcessMethodBasedOnDuration, 0, 2 )
+
+    audioCodec = av.AudioCodec( av.eCodecTypeEncoder, "pcm_s16le" )
+    audioDesc = av.AudioFrameDesc( 48000, 1, "s16" )
+    audioCodec.setAudioParameters( audioDesc )
+    transcoder.add( "", 0, "wave24b48kmono", audioCodec )
+
+    transcoder.process( progress )
+
+
+def testTranscodeOnThreads():
+    """
+    Process several transcodes on Python threads, with a progress implemented in Python.
+    """
+    nbThreads = 4
+    progresses = [ CountProgress() for i in range(nbThreads) ]
+    threads = [ threading.Thread( target=transcodeDummyAudio, args=("testTranscodeOnThreads%d.wav" % i, progresses[i]) ) for i in range(nbThreads) ]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    for progress in progresses:
+        assert_greater( progress.nbCalls, 0 )
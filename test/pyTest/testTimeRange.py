@@ -0,0 +1,114 @@
+import os
+
+# Check if environment is setup to run the tests
+if os.environ.get('AVTRANSCODER_TEST_AUDIO_WAVE_FILE') is None or os.environ.get('AVTRANSCODER_TEST_VIDEO_AVI_FILE') is None:
+    from nose.plugins.skip import SkipTest
+    raise SkipTest("Need to define environment variables AVTRANSCODER_TEST_VIDEO_AVI_FILE / AVTRANSCODER_TEST_AUDIO_WAVE_FILE")
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def testTranscodeVideoTimeRange():
+    """
+    Transcode a range of one video stream (profile dnxhd120).
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_VIDEO_AVI_FILE']
+    outputFileName = "testTranscodeVideoTimeRange.mov"
+    inPoint = 1
+    outPoint = 3
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+
+    transcoder.add( inputFileName, 0, "dnxhd120", inPoint, outPoint )
+
+    transcoder.process()
+
+    # get src file
+    src_inputFile = av.InputFile( inputFileName )
+    src_properties = src_inputFile.getProperties()
+    src_videoStream = src_properties.getVideoProperties()[0]
+
+    # get dst file
+    dst_inputFile = av.InputFile( outputFileName )
+    dst_properties = dst_inputFile.getProperties()
+    dst_videoStream = dst_properties.getVideoProperties()[0]
+
+    # check output number of frames
+    expectedNbFrames = int( round( ( outPoint - inPoint ) * src_videoStream.getFps() ) )
+    assert_equals( expectedNbFrames, dst_videoStream.getNbFrames() )
+
+
+def testTranscodeAudioTimeRange():
+    """
+    Transcode a range of one audio stream (profile wave24b48kmono), until the end of the stream.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    outputFileName = "testTranscodeAudioTimeRange.wav"
+    inPoint = 2
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+
+    transcoder.add( inputFileName, 0, "wave24b48kmono", inPoint, 0 )
+
+    transcoder.process()
+
+    # get src file
+    src_inputFile = av.InputFile( inputFileName )
+    src_properties = src_inputFile.getProperties()
+    src_audioStream = src_properties.getAudioProperties()[0]
+
+    # get dst file
+    dst_inputFile = av.InputFile( outputFileName )
+    dst_properties = dst_inputFile.getProperties()
+    dst_audioStream = dst_properties.getAudioProperties()[0]
+
+    # check output duration (the range starts at a frame of audio)
+    assert_almost_equals( src_audioStream.getDuration() - inPoint, dst_audioStream.getDuration(), delta=0.1 )
+
+
+def testRewrapVideoTimeRange():
+    """
+    Rewrap a range of one video stream: it starts at the keyframe before the in point, and still ends at the out point.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_VIDEO_AVI_FILE']
+    outputFileName = "testRewrapVideoTimeRange.avi"
+    inPoint = 1
+    outPoint = 3
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+
+    transcoder.add( inputFileName, 0, "", inPoint, outPoint )
+
+    # the duration of the stream includes the frames from the keyframe
+    streamDuration = transcoder.getStreamTranscoder( 0 ).getDuration()
+    assert_greater_equal( streamDuration, outPoint - inPoint - 1e-3 )
+
+    processStat = transcoder.process()
+
+    # the process does not stop before the out point
+    src_inputFile = av.InputFile( inputFileName )
+    src_videoStream = src_inputFile.getProperties().getVideoProperties()[0]
+    expectedNbFrames = int( streamDuration * src_videoStream.getFps() )
+    assert_greater_equal( processStat.getVideoStat( 0 )._nbFrames, expectedNbFrames )
+
+
+@raises(RuntimeError)
+def testTimeRangeEmpty():
+    """
+    Add a range of a stream which ends before it starts.
+    """
+    inputFileName = os.environ['AVTRANSCODER_TEST_AUDIO_WAVE_FILE']
+    outputFileName = "testTimeRangeEmpty.wav"
+
+    ouputFile = av.OutputFile( outputFileName )
+    transcoder = av.Transcoder( ouputFile )
+
+    transcoder.add( inputFileName, 0, "wave24b48kmono", 3, 2 )
@@ -0,0 +1,78 @@
+import os
+import json
+
+from nose.tools import *
+
+from pyAvTranscoder import avtranscoder as av
+
+from dummyVideo import processDummyVideo
+
+av.preloadCodecsAndFormats()
+av.Logger.setLogLevel(av.AV_LOG_QUIET)
+
+
+def processTracedDummyVideo( outputFileName, traceFileName ):
+    """
+    Encode a generated video, with a trace of the process.
+    """
+    return processDummyVideo( outputFileName, setUpTranscoder = lambda transcoder: transcoder.setTrace( traceFileName ) )
+
+
+def testTraceOfDummyVideo():
+    """
+    Trace the process of a generated video: a span for each call of each stage, in a Chrome trace file.
+    """
+    traceFileName = "testTraceOfDummyVideo.json"
+    processStat = processTracedDummyVideo( "testTraceOfDummyVideo.mov", traceFileName )
+    nbFrames = processStat.getVideoStat( 0 )._nbFrames
+
+    assert_false( av.Tracer.isEnabled() )
+
+    with open( traceFileName ) as traceFile:
+        trace = json.load( traceFile )
+    spans = [ event for event in trace["traceEvents"] if event["ph"] == "X" ]
+    assert_equals( av.Tracer.getNbSpans(), len(spans) )
+
+    # one span per generated, converted, encoded and wrapped frame
+    for name in ( "decode", "convert", "encode", "wrap" ):
+        stageSpans = [ span for span in spans if span["name"] == name ]
+        assert_greater_equal( len(stageSpans), nbFrames )
+        for span in stageSpans:
+            assert_equals( 0, span["args"]["stream"] )
+            assert_greater_equal( span["dur"], 0 )
+            assert_greater_equal( span["ts"], 0 )
+    wrapSpans = [ span for span in spans if span["name"] == "wrap" ]
+    assert_equals( list(range(nbFrames)), [ span["args"]["frame"] for span in wrapSpans ] )
+
+    # the process has a single thread
+    assert_equals( set([ 1 ]), set([ span["tid"] for span in spans ]) )
+
+
+def testNoTrace():
+    """
+    No span is recorded if the process is not traced.
+    """
+    processTracedDummyVideo( "testTraceBeforeNoTrace.mov", "testTraceBeforeNoTrace.json" )
+    nbSpans = av.Tracer.getNbSpans()
+
+    processDummyVideo( "testNoTrace.mov" )
+    assert_equals( nbSpans, av.Tracer.getNbSpans() )
+
+
+def testNoOverlappingTraces():
+    """
+    A process is not traced while another trace is recorded: the spans of the current trace are kept.
+    """
+    traceFileName = "testNoOverlappingTraces.json"
+    if os.path.exists( traceFileName ):
+        os.remove( traceFileName )
+
+    assert_true( av.Tracer.start() )
+    try:
+        assert_false( av.Tracer.start() )
+        processTracedDummyVideo( "testNoOverlappingTraces.mov", traceFileName )
+        assert_true( av.Tracer.isEnabled() )
+        assert_greater( av.Tracer.getNbSpans(), 0 )
+    finally:
+        av.Tracer.stop()
+    assert_false( os.path.exists( traceFileName ) )